@@ -0,0 +1,160 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <openrct2-ui/interface/Widget.h>
+#include <openrct2-ui/windows/Window.h>
+#include <openrct2/Context.h>
+#include <openrct2/core/Profiler.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/localisation/Localisation.h>
+
+// clang-format off
+enum WINDOW_DEBUG_PROFILER_WIDGET_IDX
+{
+    WIDX_BACKGROUND,
+    WIDX_TOGGLE_RECORD_TIMINGS,
+};
+
+#define MAX_ROWS        (16)
+#define ROW_HEIGHT      (10)
+#define LIST_TOP        (8 + 15 + 4)
+#define WINDOW_WIDTH    (320)
+#define WINDOW_HEIGHT   (LIST_TOP + ROW_HEIGHT * (MAX_ROWS + 1) + 8)
+
+// Number of window updates between refreshes of the list
+#define REFRESH_INTERVAL (20)
+
+static rct_widget window_debug_profiler_widgets[] = {
+    { WWT_FRAME,    0,  0,  WINDOW_WIDTH - 1,   0,  WINDOW_HEIGHT - 1,  STR_NONE,                           STR_NONE },
+    { WWT_CHECKBOX, 1,  8,  WINDOW_WIDTH - 8,   8,  8 + 11,             STR_DEBUG_PROFILER_RECORD_TIMINGS,  STR_NONE },
+    { WIDGETS_END },
+};
+
+static void window_debug_profiler_mouseup(rct_window * w, rct_widgetindex widgetIndex);
+static void window_debug_profiler_update(rct_window * w);
+static void window_debug_profiler_invalidate(rct_window * w);
+static void window_debug_profiler_paint(rct_window * w, rct_drawpixelinfo * dpi);
+
+static rct_window_event_list window_debug_profiler_events = {
+    nullptr,
+    window_debug_profiler_mouseup,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    window_debug_profiler_update,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    window_debug_profiler_invalidate,
+    window_debug_profiler_paint,
+    nullptr
+};
+// clang-format on
+
+rct_window * window_debug_profiler_open()
+{
+    rct_window * window;
+
+    // Check if window is already open
+    window = window_find_by_class(WC_DEBUG_PROFILER);
+    if (window != nullptr)
+        return window;
+
+    window = window_create(
+        context_get_width() - 16 - WINDOW_WIDTH,
+        context_get_height() - 16 - 33 - WINDOW_HEIGHT,
+        WINDOW_WIDTH,
+        WINDOW_HEIGHT,
+        &window_debug_profiler_events,
+        WC_DEBUG_PROFILER,
+        WF_STICK_TO_FRONT | WF_TRANSPARENT
+    );
+
+    window->widgets = window_debug_profiler_widgets;
+    window->enabled_widgets = (1 << WIDX_TOGGLE_RECORD_TIMINGS);
+    window_init_scroll_widgets(window);
+    window_push_others_below(window);
+
+    window->colours[0] = TRANSLUCENT(COLOUR_BLACK);
+    window->colours[1] = COLOUR_GREY;
+    window->frame_no = 0;
+    return window;
+}
+
+static void window_debug_profiler_mouseup(rct_window * w, rct_widgetindex widgetIndex)
+{
+    switch (widgetIndex) {
+        case WIDX_TOGGLE_RECORD_TIMINGS:
+            Profiler::SetEnabled(!Profiler::IsEnabled());
+            window_invalidate(w);
+            break;
+    }
+}
+
+static void window_debug_profiler_update(rct_window * w)
+{
+    w->frame_no++;
+    if (w->frame_no >= REFRESH_INTERVAL)
+    {
+        w->frame_no = 0;
+        window_invalidate(w);
+    }
+}
+
+static void window_debug_profiler_invalidate(rct_window * w)
+{
+    widget_set_checkbox_value(w, WIDX_TOGGLE_RECORD_TIMINGS, Profiler::IsEnabled());
+}
+
+static void window_debug_profiler_draw_row(rct_drawpixelinfo * dpi, sint32 x, sint32 y, const utf8 * name, const utf8 * calls, const utf8 * average, const utf8 * max)
+{
+    gfx_draw_string(dpi, name, COLOUR_WHITE, x, y);
+    gfx_draw_string(dpi, calls, COLOUR_WHITE, x + 170, y);
+    gfx_draw_string(dpi, average, COLOUR_WHITE, x + 210, y);
+    gfx_draw_string(dpi, max, COLOUR_WHITE, x + 260, y);
+}
+
+static void window_debug_profiler_paint(rct_window * w, rct_drawpixelinfo * dpi)
+{
+    window_draw_widgets(w, dpi);
+
+    // Scopes over the last second, by total time
+    sint32 x = w->x + 8;
+    sint32 y = w->y + LIST_TOP;
+    window_debug_profiler_draw_row(dpi, x, y, "Scope", "Calls", "Avg ms", "Max ms");
+    y += ROW_HEIGHT;
+
+    auto summaries = Profiler::GetSummary(1);
+    for (size_t i = 0; i < summaries.size() && i < MAX_ROWS; i++)
+    {
+        const auto& summary = summaries[i];
+        char calls[16], average[16], max[16];
+        snprintf(calls, sizeof(calls), "%u", summary.Count);
+        snprintf(average, sizeof(average), "%.2f", summary.TotalMilliseconds / summary.Count);
+        snprintf(max, sizeof(max), "%.2f", summary.MaxMilliseconds);
+        window_debug_profiler_draw_row(dpi, x, y, summary.Name, calls, average, max);
+        y += ROW_HEIGHT;
+    }
+}
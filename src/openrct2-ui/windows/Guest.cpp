@@ -18,6 +18,7 @@
 #include <openrct2/localisation/Localisation.h>
 #include <openrct2/management/Marketing.h>
 #include <openrct2/network/network.h>
+#include <openrct2/peep/GuestStore.h>
 #include <openrct2/peep/Peep.h>
 #include <openrct2/peep/Staff.h>
 #include <openrct2/ride/RideData.h>
@@ -626,6 +627,7 @@ void window_guest_overview_mouse_up(rct_window *w, rct_widgetindex widgetIndex)
         break;
     case WIDX_TRACK:
         get_sprite(w->number)->peep.peep_flags ^= PEEP_FLAGS_TRACKING;
+        guest_store_update(&get_sprite(w->number)->peep);
         break;
     }
 }
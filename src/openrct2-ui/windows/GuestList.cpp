@@ -15,6 +15,7 @@
 #include <openrct2/Game.h>
 #include <openrct2-ui/interface/Widget.h>
 #include <openrct2/localisation/Localisation.h>
+#include <openrct2/peep/GuestStore.h>
 #include <openrct2/sprites.h>
 #include <openrct2-ui/interface/Dropdown.h>
 #include <openrct2/Context.h>
@@ -496,15 +497,20 @@ static void window_guest_list_scrollgetsize(rct_window *w, sint32 scrollIndex, s
         // Count the number of guests
         numGuests = 0;
 
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1)
-                if (window_guest_list_is_peep_in_filter(peep))
+        if (_window_guest_list_selected_filter == -1 && _window_guest_list_filter_name[0] == '\0') {
+            // Without filters the count only depends on flags kept in the guest store
+            numGuests = guest_store_count_in_park(_window_guest_list_tracking_only ? PEEP_FLAGS_TRACKING : 0);
+        } else {
+            FOR_ALL_GUESTS(spriteIndex, peep) {
+                if (peep->outside_of_park != 0)
                     continue;
-            if (!guest_should_be_visible(peep))
-                continue;
-            numGuests++;
+                if (_window_guest_list_selected_filter != -1)
+                    if (window_guest_list_is_peep_in_filter(peep))
+                        continue;
+                if (!guest_should_be_visible(peep))
+                    continue;
+                numGuests++;
+            }
         }
         w->var_492 = numGuests;
         y = numGuests * SCROLLABLE_ROW_HEIGHT;
@@ -129,6 +129,7 @@ enum TOP_TOOLBAR_DEBUG_DDIDX {
     DDIDX_INVENTIONS_LIST = 3,
     DDIDX_SCENARIO_OPTIONS = 4,
     DDIDX_DEBUG_PAINT = 5,
+    DDIDX_DEBUG_PROFILER = 6,
 
     TOP_TOOLBAR_DEBUG_COUNT
 };
@@ -3160,6 +3161,8 @@ static void top_toolbar_init_debug_menu(rct_window* w, rct_widget* widget)
     gDropdownItemsArgs[DDIDX_SCENARIO_OPTIONS] = STR_DEBUG_DROPDOWN_SCENARIO_OPTIONS;
     gDropdownItemsFormat[DDIDX_DEBUG_PAINT] = STR_TOGGLE_OPTION;
     gDropdownItemsArgs[DDIDX_DEBUG_PAINT] = STR_DEBUG_DROPDOWN_DEBUG_PAINT;
+    gDropdownItemsFormat[DDIDX_DEBUG_PROFILER] = STR_TOGGLE_OPTION;
+    gDropdownItemsArgs[DDIDX_DEBUG_PROFILER] = STR_DEBUG_DROPDOWN_TICK_PROFILER;
 
     window_dropdown_show_text(
         w->x + widget->left,
@@ -3177,6 +3180,7 @@ static void top_toolbar_init_debug_menu(rct_window* w, rct_widget* widget)
     }
 
     dropdown_set_checked(DDIDX_DEBUG_PAINT, window_find_by_class(WC_DEBUG_PAINT) != nullptr);
+    dropdown_set_checked(DDIDX_DEBUG_PROFILER, window_find_by_class(WC_DEBUG_PROFILER) != nullptr);
     gDropdownDefaultIndex = DDIDX_CONSOLE;
 }
 
@@ -3227,6 +3231,13 @@ static void top_toolbar_debug_menu_dropdown(sint16 dropdownIndex)
                 window_close_by_class(WC_DEBUG_PAINT);
             }
             break;
+        case DDIDX_DEBUG_PROFILER:
+            if (window_find_by_class(WC_DEBUG_PROFILER) == nullptr) {
+                context_open_window(WC_DEBUG_PROFILER);
+            } else {
+                window_close_by_class(WC_DEBUG_PROFILER);
+            }
+            break;
         }
     }
 }
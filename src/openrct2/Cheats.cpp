@@ -16,6 +16,7 @@
 #include "ride/Ride.h"
 #include "scenario/Scenario.h"
 #include "util/Util.h"
+#include "world/Ambience.h"
 #include "world/Climate.h"
 #include "world/Footpath.h"
 #include "world/Map.h"
@@ -106,6 +107,7 @@ static void cheat_fix_vandalism()
             continue;
 
         it.element->flags &= ~TILE_ELEMENT_FLAG_BROKEN;
+        ambience_invalidate_tile(it.x, it.y);
     } while (tile_element_iterator_next(&it));
 
     gfx_invalidate_screen();
@@ -468,6 +470,7 @@ static void cheat_own_all_land()
     }
 
     map_count_remaining_land_rights();
+    park_size_invalidate();
 }
 
 #pragma endregion
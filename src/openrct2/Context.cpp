@@ -26,6 +26,7 @@
 #include "core/Math.hpp"
 #include "core/MemoryStream.h"
 #include "core/Path.hpp"
+#include "core/Profiler.h"
 #include "core/String.hpp"
 #include "core/Util.hpp"
 #include "drawing/IDrawingEngine.h"
@@ -883,6 +884,7 @@ namespace OpenRCT2
 
             _accumulator -= GAME_UPDATE_TIME_MS;
 
+            Profiler::Scope profilerScope("Context::RunFixedFrame");
             Update();
             if (!_isWindowMinimised && !gOpenRCT2Headless)
             {
@@ -894,6 +896,7 @@ namespace OpenRCT2
 
         void RunVariableFrame()
         {
+            Profiler::Scope profilerScope("Context::RunVariableFrame");
             uint32 currentTick = platform_get_ticks();
 
             bool draw = !_isWindowMinimised && !gOpenRCT2Headless;
@@ -289,7 +289,7 @@ namespace Editor
         ride_init_all();
 
         //
-        for (sint32 i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite * sprite = get_sprite(i);
             user_string_free(sprite->unknown.name_string_idx);
@@ -31,6 +31,7 @@
 #include "object/Object.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
+#include "peep/GuestStore.h"
 #include "peep/Peep.h"
 #include "peep/Staff.h"
 #include "platform/platform.h"
@@ -52,6 +53,7 @@
 #include "world/Climate.h"
 #include "world/Entrance.h"
 #include "world/Footpath.h"
+#include "world/LitterIndex.h"
 #include "world/Map.h"
 #include "world/MapAnimation.h"
 #include "world/Park.h"
@@ -489,6 +491,11 @@ sint32 game_do_command_p(uint32 command, sint32 * eax, sint32 * ebx, sint32 * ec
             if (gGameCommandNestLevel != 0)
                 return cost;
 
+            // Commands can change tiles in place
+            map_derived_data_invalidate_in_place();
+            // and the guests, e.g. with cheats
+            guest_store_invalidate();
+
             //
             if (!(flags & 0x20))
             {
@@ -1114,6 +1121,8 @@ void game_load_init()
 {
     rct_window * mainWindow;
 
+    map_derived_data_invalidate_all();
+
     gScreenFlags = SCREEN_FLAGS_PLAYING;
     audio_stop_all_music_and_sounds();
     if (!gLoadKeepWindowsOpen)
@@ -1135,6 +1144,8 @@ void game_load_init()
     {
         reset_sprite_spatial_index();
     }
+    litter_index_invalidate();
+    guest_store_invalidate();
     reset_all_sprite_quadrant_placements();
     scenery_set_default_placement_configuration();
 
@@ -1163,7 +1174,7 @@ void game_load_init()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < sprite_get_capacity(); i++)
     {
         rct_sprite * spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -1187,6 +1198,10 @@ void save_game()
             // game shortly after saving.
             gScreenAge = 0;
         }
+        else
+        {
+            context_show_error(STR_SAVE_GAME, STR_GAME_SAVE_FAILED);
+        }
     }
     else
     {
@@ -1341,7 +1356,11 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    scenario_save(path, saveFlags);
+    // The park can fail to save, such as when more sprites are in use than a saved game can hold
+    if (!scenario_save(path, saveFlags))
+    {
+        context_show_error(STR_SAVE_GAME, STR_GAME_SAVE_FAILED);
+    }
 }
 
 static void game_load_or_quit_no_save_prompt_callback(sint32 result, const utf8 * path)
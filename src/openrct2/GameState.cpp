@@ -7,9 +7,11 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <chrono>
 #include "GameState.h"
 #include "Context.h"
 #include "core/Math.hpp"
+#include "core/Profiler.h"
 #include "Editor.h"
 #include "Input.h"
 #include "interface/Screenshot.h"
@@ -31,6 +33,51 @@
 
 using namespace OpenRCT2;
 
+// clang-format off
+const char * const OpenRCT2::LogicStageNames[LOGIC_STAGE_COUNT] =
+{
+    "network",
+    "map_update_tiles",
+    "peep_update_all",
+    "vehicle_update_all",
+    "ride_update_all",
+    "Park::Update",
+    "ride_ratings_update_all",
+};
+// clang-format on
+
+/**
+ * Adds the time until the end of the scope to a logic stage, if logic timings are being collected, and
+ * records it with the profiler.
+ */
+class LogicStageTimer final
+{
+private:
+    Profiler::Scope _scope;
+    uint64 * _counter = nullptr;
+    std::chrono::steady_clock::time_point _startTime;
+
+public:
+    LogicStageTimer(LogicTimings * timings, LOGIC_STAGE stage)
+        : _scope(LogicStageNames[stage])
+    {
+        if (timings != nullptr)
+        {
+            _counter = &timings->Stages[stage];
+            _startTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~LogicStageTimer()
+    {
+        if (_counter != nullptr)
+        {
+            auto duration = std::chrono::steady_clock::now() - _startTime;
+            *_counter += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+    }
+};
+
 GameState::GameState()
 {
     _park = std::make_unique<Park>();
@@ -71,6 +118,7 @@ void GameState::InitAll(sint32 mapSize)
 
 void GameState::Update()
 {
+    Profiler::Scope profilerScope("GameState::Update");
     gInUpdateCode = true;
 
     uint32 numUpdates;
@@ -189,33 +237,37 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    Profiler::Scope profilerScope("GameState::UpdateLogic");
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    network_update();
-
-    if (network_get_mode() == NETWORK_MODE_CLIENT &&
-        network_get_status() == NETWORK_STATUS_CONNECTED &&
-        network_get_authstatus() == NETWORK_AUTH_OK)
     {
-        // Can't be in sync with server, round trips won't work if we are at same level.
-        if (gCurrentTicks >= network_get_server_tick())
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_NETWORK);
+        network_update();
+
+        if (network_get_mode() == NETWORK_MODE_CLIENT &&
+            network_get_status() == NETWORK_STATUS_CONNECTED &&
+            network_get_authstatus() == NETWORK_AUTH_OK)
         {
-            // Don't run past the server
-            return;
+            // Can't be in sync with server, round trips won't work if we are at same level.
+            if (gCurrentTicks >= network_get_server_tick())
+            {
+                // Don't run past the server
+                return;
+            }
         }
-    }
 
-    if (network_get_mode() == NETWORK_MODE_SERVER)
-    {
-        // Send current tick out.
-        network_send_tick();
-    }
-    else if (network_get_mode() == NETWORK_MODE_CLIENT)
-    {
-        // Check desync.
-        network_check_desynchronization();
+        if (network_get_mode() == NETWORK_MODE_SERVER)
+        {
+            // Send current tick out.
+            network_send_tick();
+        }
+        else if (network_get_mode() == NETWORK_MODE_CLIENT)
+        {
+            // Check desync.
+            network_check_desynchronization();
+        }
     }
 
     sub_68B089();
@@ -225,23 +277,39 @@ void GameState::UpdateLogic()
 
     scenario_update();
     climate_update();
-    map_update_tiles();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_MAP_TILES);
+        map_update_tiles();
+    }
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
     map_update_path_wide_flags();
-    peep_update_all();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_PEEPS);
+        peep_update_all();
+    }
     map_restore_provisional_elements();
-    vehicle_update_all();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_VEHICLES);
+        vehicle_update_all();
+    }
     sprite_misc_update_all();
-    ride_update_all();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_RIDES);
+        ride_update_all();
+    }
 
     if (!(gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER)))
     {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_PARK);
         _park->Update(_date);
     }
 
     research_update();
-    ride_ratings_update_all();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_RIDE_RATINGS);
+        ride_ratings_update_all();
+    }
     ride_measurements_update();
     news_item_update_current();
 
@@ -276,9 +344,12 @@ void GameState::UpdateLogic()
 
     // Separated out processing commands in network_update which could call scenario_rand where gInUpdateCode is false.
     // All commands that are received are first queued and then executed where gInUpdateCode is set to true.
-    network_process_game_commands();
+    {
+        LogicStageTimer timer(_logicTimings, LOGIC_STAGE_NETWORK);
+        network_process_game_commands();
 
-    network_flush();
+        network_flush();
+    }
 
     gCurrentTicks++;
     gScenarioTicks++;
@@ -16,6 +16,28 @@ namespace OpenRCT2
 {
     class Park;
 
+    enum LOGIC_STAGE
+    {
+        LOGIC_STAGE_NETWORK,
+        LOGIC_STAGE_MAP_TILES,
+        LOGIC_STAGE_PEEPS,
+        LOGIC_STAGE_VEHICLES,
+        LOGIC_STAGE_RIDES,
+        LOGIC_STAGE_PARK,
+        LOGIC_STAGE_RIDE_RATINGS,
+        LOGIC_STAGE_COUNT,
+    };
+
+    extern const char * const LogicStageNames[LOGIC_STAGE_COUNT];
+
+    /**
+     * Nanoseconds spent in the main stages of UpdateLogic, accumulated while set on the game state.
+     */
+    struct LogicTimings
+    {
+        uint64 Stages[LOGIC_STAGE_COUNT] = {};
+    };
+
     /**
      * Class to update the state of the map and park.
      */
@@ -24,6 +46,7 @@ namespace OpenRCT2
     private:
         std::unique_ptr<Park> _park;
         Date                  _date;
+        LogicTimings *        _logicTimings = nullptr;
 
     public:
         GameState();
@@ -35,5 +58,7 @@ namespace OpenRCT2
         void InitAll(sint32 mapSize);
         void Update();
         void UpdateLogic();
+
+        void SetLogicTimings(LogicTimings * timings) { _logicTimings = timings; }
     };
 }
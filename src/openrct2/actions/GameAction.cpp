@@ -15,6 +15,7 @@
 #include "../core/Util.hpp"
 #include "../localisation/Localisation.h"
 #include "../network/network.h"
+#include "../peep/GuestStore.h"
 #include "../platform/platform.h"
 #include "../scenario/Scenario.h"
 #include "../world/Park.h"
@@ -171,6 +172,8 @@ namespace GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+            map_derived_data_invalidate_in_place();
+            guest_store_invalidate();
 
             gCommandPosition.x = result->Position.x;
             gCommandPosition.y = result->Position.y;
@@ -171,6 +171,7 @@ public:
             if (!(flags & GAME_COMMAND_FLAG_GHOST))
             {
                 rct_tile_element* surfaceElement = map_get_surface_element_at(entranceLoc);
+                park_size_update_ownership(surfaceElement->properties.surface.ownership, 0);
                 surfaceElement->properties.surface.ownership = 0;
             }
 
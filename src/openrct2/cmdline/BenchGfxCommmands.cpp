@@ -10,20 +10,33 @@
 #include "../interface/Screenshot.h"
 #include "CommandLine.hpp"
 
+static BenchGfxOptions options;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition BenchGfxOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &options.warmup, NAC, "warmup", "number of untimed renders before each measurement (default 2)" },
+    { CMDLINE_TYPE_STRING,  &options.sizes,  NAC, "sizes",  "comma separated viewport sizes, <width>x<height> or map (default 1920x1080,map)" },
+    { CMDLINE_TYPE_STRING,  &options.format, NAC, "format", "output format: text, json or csv (default text)" },
+    { CMDLINE_TYPE_STRING,  &options.output, NAC, "output", "file to write the json or csv results to instead of stdout" },
+    OptionTableEnd
+};
+
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator *argEnumerator);
 
 const CommandLineCommand CommandLine::BenchGfxCommands[]
 {
     // Main commands
-    DefineCommand("", "<file> [iterations count]", nullptr, HandleBenchGfx),
+    DefineCommand("", "<file> [iterations count]", BenchGfxOptionsDef, HandleBenchGfx),
     CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleBenchGfx(CommandLineArgEnumerator *argEnumerator)
 {
     const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
     sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
-    sint32 result = cmdline_for_gfxbench(argv, argc);
+    sint32 result = cmdline_for_gfxbench(argv, argc, &options);
     if (result < 0) {
         return EXITCODE_FAIL;
     }
@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../core/Math.hpp"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../Intro.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator * argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> <ticks> [<file> ...]", nullptr, HandleBenchSimulate),
+    CommandTableEnd
+};
+
+struct BenchSimulateResult
+{
+    // Milliseconds per tick for UpdateLogic as a whole, each logic stage and everything else, sorted ascending
+    std::vector<double> Total;
+    std::vector<double> Stages[LOGIC_STAGE_COUNT];
+    std::vector<double> Other;
+};
+
+static BenchSimulateResult RunTicks(GameState * gameState, sint32 tickCount)
+{
+    BenchSimulateResult result;
+    LogicTimings timings;
+    gameState->SetLogicTimings(&timings);
+    for (sint32 i = 0; i < tickCount; i++)
+    {
+        timings = {};
+
+        auto startTime = std::chrono::steady_clock::now();
+        gInUpdateCode = true;
+        gameState->UpdateLogic();
+        gInUpdateCode = false;
+        std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+
+        double stagesTotal = 0;
+        for (sint32 stage = 0; stage < LOGIC_STAGE_COUNT; stage++)
+        {
+            double stageTime = timings.Stages[stage] / 1000000.0;
+            result.Stages[stage].push_back(stageTime);
+            stagesTotal += stageTime;
+        }
+        result.Total.push_back(duration.count());
+        result.Other.push_back(std::max(0.0, duration.count() - stagesTotal));
+    }
+    gameState->SetLogicTimings(nullptr);
+
+    std::sort(result.Total.begin(), result.Total.end());
+    std::sort(result.Other.begin(), result.Other.end());
+    for (auto& samples : result.Stages)
+    {
+        std::sort(samples.begin(), samples.end());
+    }
+    return result;
+}
+
+static void PrintSamples(const char * name, const std::vector<double>& samples)
+{
+    Console::WriteLine("%-24s %9.4f %9.4f %9.4f %9.4f %9.4f", name,
+        Math::Percentile(samples, 0), Math::Percentile(samples, 50), Math::Percentile(samples, 95),
+        Math::Percentile(samples, 99), Math::Percentile(samples, 100));
+}
+
+static void PrintResult(const char * path, sint32 tickCount, const BenchSimulateResult& result)
+{
+    double totalSeconds = 0;
+    for (double tickTime : result.Total)
+    {
+        totalSeconds += tickTime / 1000.0;
+    }
+
+    Console::WriteLine("%s: %d ticks in %.2f seconds, %.1f ticks per second", path, tickCount, totalSeconds,
+        totalSeconds > 0 ? tickCount / totalSeconds : 0.0);
+    Console::WriteLine("%-24s %9s %9s %9s %9s %9s", "milliseconds per tick", "min", "median", "p95", "p99", "max");
+    PrintSamples("UpdateLogic", result.Total);
+    for (sint32 stage = 0; stage < LOGIC_STAGE_COUNT; stage++)
+    {
+        PrintSamples(LogicStageNames[stage], result.Stages[stage]);
+    }
+    PrintSamples("other", result.Other);
+}
+
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator * argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Usage: openrct2 benchsimulate <file> <ticks> [<file> ...]");
+        return EXITCODE_FAIL;
+    }
+
+    sint32 tickCount = std::atoi(argv[1]);
+    if (tickCount <= 0)
+    {
+        Console::Error::WriteLine("Tick count must be greater than zero.");
+        return EXITCODE_FAIL;
+    }
+
+    std::vector<const char *> parkPaths = { argv[0] };
+    for (sint32 i = 2; i < argc; i++)
+    {
+        parkPaths.push_back(argv[i]);
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = std::unique_ptr<IContext>(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Failed to initialise context.");
+        return EXITCODE_FAIL;
+    }
+
+    exitcode_t exitCode = EXITCODE_OK;
+    for (const auto path : parkPaths)
+    {
+        if (!context->LoadParkFromFile(path))
+        {
+            Console::Error::WriteLine("Failed to load park: %s", path);
+            exitCode = EXITCODE_FAIL;
+            continue;
+        }
+
+        gIntroState = INTRO_STATE_NONE;
+        gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+        auto result = RunTicks(context->GetGameState(), tickCount);
+        PrintResult(path, tickCount, result);
+        Console::WriteLine();
+    }
+    return exitCode;
+}
@@ -0,0 +1,239 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../core/Console.hpp"
+#include "../drawing/Drawing.h"
+#include "../util/Util.h"
+#include "CommandLine.hpp"
+
+static exitcode_t HandleBenchSprites(CommandLineArgEnumerator * argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSpritesCommands[]
+{
+    // Main commands
+    DefineCommand("", "[iterations count]", nullptr, HandleBenchSprites),
+    CommandTableEnd
+};
+
+using RLESpriteFunc = void (FASTCALL *)(const uint8 *, uint8 *, const uint8 *, const rct_drawpixelinfo *, sint32, sint32,
+                                        sint32, sint32, sint32);
+
+struct BenchSpritesBlitter
+{
+    const char *  Name;
+    RLESpriteFunc Func;
+    bool          Available;
+};
+
+struct BenchSpritesImageType
+{
+    const char *  Name;
+    sint32        ImageType;
+    const uint8 * Palette;
+};
+
+static constexpr sint32 SpriteWidth = 64;
+static constexpr sint32 SpriteHeight = 96;
+static constexpr sint32 SpriteCount = 64;
+
+/**
+ * Creates RLE sprites shaped like guests and scenery: a few runs per line of mostly short to
+ * medium length.
+ */
+static std::vector<std::vector<uint8>> CreateSprites(std::mt19937& random)
+{
+    std::vector<std::vector<uint8>> sprites;
+    for (sint32 spriteIndex = 0; spriteIndex < SpriteCount; spriteIndex++)
+    {
+        std::vector<uint8> lines;
+        std::vector<uint16> offsets;
+        for (sint32 y = 0; y < SpriteHeight; y++)
+        {
+            offsets.push_back((uint16)(SpriteHeight * 2 + lines.size()));
+            sint32 x = random() % 8;
+            while (true)
+            {
+                sint32 length = 1 + (random() % (SpriteWidth - x));
+                sint32 nextX = x + length + 1 + (random() % 4);
+                bool isLast = nextX >= SpriteWidth - 1 || (random() % 3) == 0;
+                lines.push_back((uint8)(length | (isLast ? 0x80 : 0)));
+                lines.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    lines.push_back((uint8)(random() % 256));
+                }
+                if (isLast)
+                {
+                    break;
+                }
+                x = nextX;
+            }
+        }
+
+        std::vector<uint8> sprite(offsets.size() * 2);
+        std::memcpy(sprite.data(), offsets.data(), sprite.size());
+        sprite.insert(sprite.end(), lines.begin(), lines.end());
+        sprites.push_back(std::move(sprite));
+    }
+    return sprites;
+}
+
+static double TimeBlitter(RLESpriteFunc func, const std::vector<std::vector<uint8>>& sprites, const BenchSpritesImageType& imageType,
+                          sint32 zoom, sint32 iterations, std::vector<uint8>& bits)
+{
+    rct_drawpixelinfo dpi = {};
+    dpi.bits = bits.data();
+    dpi.width = SpriteWidth;
+    dpi.height = SpriteHeight;
+    dpi.pitch = 0;
+    dpi.zoom_level = zoom;
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        for (const auto& sprite : sprites)
+        {
+            func(sprite.data(), bits.data(), imageType.Palette, &dpi, imageType.ImageType, 0, SpriteHeight, 0, SpriteWidth);
+        }
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+    return duration.count();
+}
+
+/**
+ * Draws every sprite with the blitter and with the scalar blitter over the same background and
+ * checks that they leave the same pixels.
+ */
+static bool BlitterMatchesScalar(RLESpriteFunc func, const std::vector<std::vector<uint8>>& sprites,
+                                 const BenchSpritesImageType& imageType, sint32 zoom)
+{
+    rct_drawpixelinfo dpi = {};
+    dpi.width = SpriteWidth;
+    dpi.height = SpriteHeight;
+    dpi.pitch = 0;
+    dpi.zoom_level = zoom;
+
+    std::vector<uint8> expected(SpriteWidth * SpriteHeight);
+    std::vector<uint8> actual(SpriteWidth * SpriteHeight);
+    for (const auto& sprite : sprites)
+    {
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            expected[i] = (uint8)(i * 7);
+            actual[i] = (uint8)(i * 7);
+        }
+        dpi.bits = expected.data();
+        gfx_rle_sprite_to_buffer_scalar(sprite.data(), expected.data(), imageType.Palette, &dpi, imageType.ImageType, 0,
+                                        SpriteHeight, 0, SpriteWidth);
+        dpi.bits = actual.data();
+        func(sprite.data(), actual.data(), imageType.Palette, &dpi, imageType.ImageType, 0, SpriteHeight, 0, SpriteWidth);
+        if (expected != actual)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static exitcode_t HandleBenchSprites(CommandLineArgEnumerator * argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    sint32 iterations = 1000;
+    if (argc >= 1)
+    {
+        iterations = std::atoi(argv[0]);
+        if (iterations <= 0)
+        {
+            Console::Error::WriteLine("Iterations count must be greater than zero.");
+            return EXITCODE_FAIL;
+        }
+    }
+
+    std::mt19937 random(0);
+    auto sprites = CreateSprites(random);
+
+    // A recolouring palette like the guest one and a glass palette changing every entry
+    std::vector<uint8> remapPalette(256);
+    std::vector<uint8> glassPalette(256);
+    for (sint32 i = 0; i < 256; i++)
+    {
+        remapPalette[i] = (uint8)i;
+        glassPalette[i] = (uint8)(random() % 256);
+    }
+    for (sint32 start : { 0x2E, 0xCA, 0xF3 })
+    {
+        for (sint32 i = start; i < start + 12; i++)
+        {
+            remapPalette[i] = (uint8)(random() % 256);
+        }
+    }
+    std::vector<uint8> translucentPalette(0x10000);
+    for (auto& entry : translucentPalette)
+    {
+        entry = (uint8)(random() % 256);
+    }
+
+    const BenchSpritesBlitter blitters[] = {
+        { "scalar", gfx_rle_sprite_to_buffer_scalar, true },
+        { "sse4.1", gfx_rle_sprite_to_buffer_sse4_1, sse41_available() },
+        { "avx2", gfx_rle_sprite_to_buffer_avx2, avx2_available() },
+    };
+    const BenchSpritesImageType imageTypes[] = {
+        { "default", IMAGE_TYPE_DEFAULT, nullptr },
+        { "remap", IMAGE_TYPE_REMAP, remapPalette.data() },
+        { "glass", IMAGE_TYPE_TRANSPARENT, glassPalette.data() },
+        { "glass remap", IMAGE_TYPE_TRANSPARENT, remapPalette.data() },
+        { "translucent remap", IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, translucentPalette.data() },
+    };
+
+    std::vector<uint8> bits(SpriteWidth * SpriteHeight);
+    bool allMatch = true;
+    Console::WriteLine("%d sprites of %dx%d, %d iterations, milliseconds per iteration", SpriteCount, SpriteWidth,
+                       SpriteHeight, iterations);
+    Console::WriteLine("%-20s %4s %10s %10s %10s", "image type", "zoom", blitters[0].Name, blitters[1].Name, blitters[2].Name);
+    for (const auto& imageType : imageTypes)
+    {
+        for (sint32 zoom = 0; zoom < 4; zoom++)
+        {
+            char times[3][32];
+            for (size_t i = 0; i < 3; i++)
+            {
+                if (blitters[i].Available && !BlitterMatchesScalar(blitters[i].Func, sprites, imageType, zoom))
+                {
+                    snprintf(times[i], sizeof(times[i]), "mismatch");
+                    allMatch = false;
+                }
+                else if (blitters[i].Available)
+                {
+                    double time = TimeBlitter(blitters[i].Func, sprites, imageType, zoom, iterations, bits) / iterations;
+                    snprintf(times[i], sizeof(times[i]), "%.4f", time);
+                }
+                else
+                {
+                    snprintf(times[i], sizeof(times[i]), "n/a");
+                }
+            }
+            Console::WriteLine("%-20s %4d %10s %10s %10s", imageType.Name, zoom, times[0], times[1], times[2]);
+        }
+    }
+
+    if (!allMatch)
+    {
+        Console::Error::WriteLine("Some blitters do not draw the same pixels as the scalar one.");
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
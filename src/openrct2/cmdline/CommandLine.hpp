@@ -93,6 +93,8 @@ namespace CommandLine
     extern const CommandLineCommand ScreenshotCommands[];
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
+    extern const CommandLineCommand BenchSimulateCommands[];
+    extern const CommandLineCommand BenchSpritesCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -133,9 +133,11 @@ const CommandLineCommand CommandLine::RootCommands[]
 #endif
 
     // Sub-commands
-    DefineSubCommand("screenshot", CommandLine::ScreenshotCommands),
-    DefineSubCommand("sprite",     CommandLine::SpriteCommands    ),
-    DefineSubCommand("benchgfx",   CommandLine::BenchGfxCommands  ),
+    DefineSubCommand("screenshot",    CommandLine::ScreenshotCommands   ),
+    DefineSubCommand("sprite",        CommandLine::SpriteCommands       ),
+    DefineSubCommand("benchgfx",      CommandLine::BenchGfxCommands     ),
+    DefineSubCommand("benchsimulate", CommandLine::BenchSimulateCommands),
+    DefineSubCommand("benchsprites",  CommandLine::BenchSpritesCommands ),
 
     CommandTableEnd
 };
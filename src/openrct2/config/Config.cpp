@@ -209,6 +209,16 @@ namespace Config
             model->zoom_to_cursor = reader->GetBoolean("zoom_to_cursor", true);
             model->render_weather_effects = reader->GetBoolean("render_weather_effects", true);
             model->render_weather_gloom = reader->GetBoolean("render_weather_gloom", true);
+            model->paint_threads = reader->GetSint32("paint_threads", 0);
+            model->guest_think_threads = reader->GetSint32("guest_think_threads", 0);
+            model->verify_park_counts = reader->GetBoolean("verify_park_counts", false);
+            model->max_sprites = reader->GetSint32("max_sprites", 10000);
+            if (model->max_sprites > 10000)
+            {
+                log_warning("max_sprites is above 10000, parks with more sprites in use than that can not be saved");
+            }
+            model->zoomed_sprite_cache_size = reader->GetSint32("zoomed_sprite_cache_size", 32);
+            model->pathfinding_graph_search = reader->GetBoolean("pathfinding_graph_search", false);
             model->show_guest_purchases = reader->GetBoolean("show_guest_purchases", false);
             model->show_real_names_of_guests = reader->GetBoolean("show_real_names_of_guests", true);
             model->allow_early_completion = reader->GetBoolean("allow_early_completion", false);
@@ -280,6 +290,12 @@ namespace Config
         writer->WriteBoolean("zoom_to_cursor", model->zoom_to_cursor);
         writer->WriteBoolean("render_weather_effects", model->render_weather_effects);
         writer->WriteBoolean("render_weather_gloom", model->render_weather_gloom);
+        writer->WriteSint32("paint_threads", model->paint_threads);
+        writer->WriteSint32("guest_think_threads", model->guest_think_threads);
+        writer->WriteBoolean("verify_park_counts", model->verify_park_counts);
+        writer->WriteSint32("max_sprites", model->max_sprites);
+        writer->WriteSint32("zoomed_sprite_cache_size", model->zoomed_sprite_cache_size);
+        writer->WriteBoolean("pathfinding_graph_search", model->pathfinding_graph_search);
         writer->WriteBoolean("show_guest_purchases", model->show_guest_purchases);
         writer->WriteBoolean("show_real_names_of_guests", model->show_real_names_of_guests);
         writer->WriteBoolean("allow_early_completion", model->allow_early_completion);
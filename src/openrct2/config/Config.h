@@ -41,6 +41,12 @@ struct GeneralConfiguration
     bool        upper_case_banners;
     bool        render_weather_effects;
     bool        render_weather_gloom;
+    sint32      paint_threads;
+    sint32      guest_think_threads;
+    bool        verify_park_counts;
+    sint32      max_sprites;
+    sint32      zoomed_sprite_cache_size;
+    bool        pathfinding_graph_search;
     bool        disable_lightning_effect;
     bool        show_guest_purchases;
 
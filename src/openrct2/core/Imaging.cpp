@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <future>
 #include <stdexcept>
 #include <unordered_map>
 #include <png.h>
@@ -159,7 +160,11 @@ namespace Imaging
         }
     }
 
-    static void WritePng(std::ostream& ostream, const Image& image)
+    /**
+     * Writes the image header followed by each row returned by getRow, which is called once for every row in
+     * top-to-bottom order. image.Pixels is not read.
+     */
+    static void WritePng(std::ostream& ostream, const Image& image, const std::function<const uint8 *(uint32 y)>& getRow)
     {
         png_structp png_ptr = nullptr;
         png_colorp png_palette = nullptr;
@@ -229,11 +234,9 @@ namespace Imaging
             png_write_info(png_ptr, info_ptr);
 
             // Write pixels
-            auto pixels = image.Pixels.data();
             for (uint32 y = 0; y < image.Height; y++)
             {
-                png_write_row(png_ptr, (png_byte *)pixels);
-                pixels += image.Stride;
+                png_write_row(png_ptr, (png_byte *)getRow(y));
             }
 
             png_write_end(png_ptr, nullptr);
@@ -248,6 +251,13 @@ namespace Imaging
         }
     }
 
+    static void WritePng(std::ostream& ostream, const Image& image)
+    {
+        auto pixels = image.Pixels.data();
+        auto stride = image.Stride;
+        WritePng(ostream, image, [pixels, stride](uint32 y) { return pixels + (y * stride); });
+    }
+
     IMAGE_FORMAT GetImageFormatFromPath(const std::string_view& path)
     {
         if (String::EndsWith(path, ".png", true))
@@ -338,4 +348,53 @@ namespace Imaging
                 throw std::runtime_error(EXCEPTION_IMAGE_FORMAT_UNKNOWN);
         }
     }
+
+    void WriteToFileBanded(
+        const std::string_view& path,
+        uint32 width,
+        uint32 height,
+        const rct_palette& palette,
+        uint32 bandHeight,
+        const ImageBandFunc& renderBand)
+    {
+        bandHeight = std::clamp<uint32>(bandHeight, 1, std::max<uint32>(height, 1));
+
+        Image header;
+        header.Width = width;
+        header.Height = height;
+        header.Depth = 8;
+        header.Stride = width;
+        header.Palette = std::make_unique<rct_palette>(palette);
+
+        // The next band is rendered on another thread while the current one is being compressed, so at most
+        // two bands are held in memory at once.
+        std::vector<uint8> currentBand(width * bandHeight);
+        std::vector<uint8> nextBand(width * bandHeight);
+        std::future<void> pendingBand;
+        uint32 bandTop = 0;
+        auto startBand = [&](uint32 top) {
+            auto pixels = nextBand.data();
+            auto rows = std::min(bandHeight, height - top);
+            pendingBand = std::async(std::launch::async, [&renderBand, pixels, top, rows]() { renderBand(pixels, top, rows); });
+        };
+
+        std::ofstream fs(path.data(), std::ios::binary);
+        WritePng(fs, header, [&](uint32 y) -> const uint8 * {
+            if (y == 0 || y - bandTop >= bandHeight)
+            {
+                if (y == 0)
+                {
+                    startBand(0);
+                }
+                pendingBand.get();
+                std::swap(currentBand, nextBand);
+                bandTop = y;
+                if (bandTop + bandHeight < height)
+                {
+                    startBand(bandTop + bandHeight);
+                }
+            }
+            return currentBand.data() + ((y - bandTop) * width);
+        });
+    }
 }
@@ -52,6 +52,11 @@ struct Image
 
 using ImageReaderFunc = std::function<Image(std::istream&, IMAGE_FORMAT)>;
 
+/**
+ * Fills pixels with the 8-bit rows [y, y + height) of a banded image, packed with a stride of the image width.
+ */
+using ImageBandFunc = std::function<void(uint8 * pixels, uint32 y, uint32 height)>;
+
 namespace Imaging
 {
     IMAGE_FORMAT GetImageFormatFromPath(const std::string_view& path);
@@ -59,5 +64,17 @@ namespace Imaging
     Image ReadFromBuffer(const std::vector<uint8>& buffer, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
     void WriteToFile(const std::string_view& path, const Image& image, IMAGE_FORMAT format = IMAGE_FORMAT::AUTOMATIC);
 
+    /**
+     * Writes a paletted PNG without holding the whole image in memory. renderBand is called for each band of
+     * bandHeight rows in top-to-bottom order, from a worker thread, while the previous band is compressed.
+     */
+    void WriteToFileBanded(
+        const std::string_view& path,
+        uint32 width,
+        uint32 height,
+        const rct_palette& palette,
+        uint32 bandHeight,
+        const ImageBandFunc& renderBand);
+
     void SetReader(IMAGE_FORMAT format, ImageReaderFunc impl);
 }
@@ -9,11 +9,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -42,12 +44,19 @@ private:
     std::condition_variable _condComplete;
     std::mutex _mutex;
 
+    struct alignas(64) WorkRange
+    {
+        std::atomic<size_t> Next = { 0 };
+        size_t End = 0;
+    };
+
     typedef std::unique_lock<std::mutex> unique_lock;
 
 public:
-    JobPool()
+    explicit JobPool(size_t maxThreads = 255)
     {
-        for (size_t n = 0; n < std::thread::hardware_concurrency(); n++)
+        size_t numThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
+        for (size_t n = 0; n < numThreads; n++)
         {
             _threads.emplace_back(&JobPool::ProcessQueue, this);
         }
@@ -132,6 +141,53 @@ public:
         return _pending.size();
     }
 
+    size_t GetThreadCount() const
+    {
+        return _threads.size();
+    }
+
+    /**
+     * Calls fn for every index in [0, count) using all threads of the pool and waits for completion.
+     * Each thread starts on its own contiguous range of indices and, once that is exhausted, steals
+     * the remaining indices of the other ranges so that uneven work still keeps every thread busy.
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t)> &fn)
+    {
+        if (_threads.empty())
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                fn(i);
+            }
+            return;
+        }
+
+        size_t numRanges = std::max<size_t>(1, std::min(count, _threads.size()));
+        auto ranges = std::make_unique<WorkRange[]>(numRanges);
+        for (size_t i = 0; i < numRanges; i++)
+        {
+            ranges[i].Next = (count * i) / numRanges;
+            ranges[i].End = (count * (i + 1)) / numRanges;
+        }
+
+        for (size_t i = 0; i < numRanges; i++)
+        {
+            AddTask([&ranges, &fn, numRanges, i]()
+            {
+                for (size_t r = 0; r < numRanges; r++)
+                {
+                    auto &range = ranges[(i + r) % numRanges];
+                    size_t index;
+                    while ((index = range.Next.fetch_add(1)) < range.End)
+                    {
+                        fn(index);
+                    }
+                }
+            });
+        }
+        Join();
+    }
+
 private:
     void ProcessQueue()
     {
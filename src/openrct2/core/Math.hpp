@@ -10,6 +10,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 /**
  * Common mathematical functions.
@@ -41,4 +43,15 @@ namespace Math
         if (x > 0) return 1;
         return 0;
     }
+
+    /**
+     * Returns the nearest-rank percentile (0 to 100) of values, which must be sorted in ascending order.
+     */
+    template<typename T>
+    static T Percentile(const std::vector<T>& values, double percentile)
+    {
+        if (values.empty()) return T();
+        size_t rank = (size_t)std::ceil((percentile / 100.0) * values.size());
+        return values[Clamp<size_t>(1, rank, values.size()) - 1];
+    }
 } // namespace Math
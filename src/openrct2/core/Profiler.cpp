@@ -0,0 +1,138 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include "Json.hpp"
+#include "Profiler.h"
+
+namespace Profiler
+{
+    std::atomic<bool> Enabled = { false };
+
+    static std::mutex _eventsMutex;
+    static std::deque<Event> _events;
+    static std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+    static std::atomic<uint32> _nextThreadId = { 0 };
+
+    static uint32 GetThreadId()
+    {
+        thread_local uint32 threadId = _nextThreadId++;
+        return threadId;
+    }
+
+    static uint64 SecondsToNanoseconds(double seconds)
+    {
+        return (uint64)(seconds * 1000000000.0);
+    }
+
+    void SetEnabled(bool enabled)
+    {
+        if (enabled && !IsEnabled())
+        {
+            std::lock_guard<std::mutex> lock(_eventsMutex);
+            _events.clear();
+        }
+        Enabled = enabled;
+    }
+
+    uint64 GetTime()
+    {
+        auto duration = std::chrono::steady_clock::now() - _epoch;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    void RecordEvent(const char * name, uint64 startTime)
+    {
+        uint64 endTime = GetTime();
+        Event e = { name, startTime, endTime - startTime, GetThreadId() };
+
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        _events.push_back(e);
+
+        // Events are appended in order of completion, so the oldest are at the front
+        uint64 maxAge = SecondsToNanoseconds(MAX_HISTORY_SECONDS);
+        while (!_events.empty() && _events.front().Start + _events.front().Duration + maxAge < endTime)
+        {
+            _events.pop_front();
+        }
+    }
+
+    std::vector<Event> GetEvents(double seconds)
+    {
+        uint64 now = GetTime();
+        uint64 maxAge = SecondsToNanoseconds(std::min(seconds, MAX_HISTORY_SECONDS));
+
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        auto first = std::find_if(_events.begin(), _events.end(), [now, maxAge](const Event& e) {
+            return e.Start + e.Duration + maxAge >= now;
+        });
+        return std::vector<Event>(first, _events.end());
+    }
+
+    std::vector<ScopeSummary> GetSummary(double seconds)
+    {
+        std::vector<ScopeSummary> result;
+        std::unordered_map<const char *, size_t> indices;
+        for (const auto& e : GetEvents(seconds))
+        {
+            auto it = indices.find(e.Name);
+            if (it == indices.end())
+            {
+                it = indices.emplace(e.Name, result.size()).first;
+                result.push_back({ e.Name, 0, 0, 0 });
+            }
+
+            auto& summary = result[it->second];
+            double milliseconds = e.Duration / 1000000.0;
+            summary.Count++;
+            summary.TotalMilliseconds += milliseconds;
+            summary.MaxMilliseconds = std::max(summary.MaxMilliseconds, milliseconds);
+        }
+
+        std::sort(result.begin(), result.end(), [](const ScopeSummary& a, const ScopeSummary& b) {
+            return a.TotalMilliseconds > b.TotalMilliseconds;
+        });
+        return result;
+    }
+
+    void WriteChromeTrace(const std::string& path, double seconds)
+    {
+        json_t * jsonEvents = json_array();
+        for (const auto& e : GetEvents(seconds))
+        {
+            json_t * jsonEvent = json_object();
+            json_object_set_new(jsonEvent, "name", json_string(e.Name));
+            json_object_set_new(jsonEvent, "cat", json_string("openrct2"));
+            json_object_set_new(jsonEvent, "ph", json_string("X"));
+            json_object_set_new(jsonEvent, "ts", json_real(e.Start / 1000.0));
+            json_object_set_new(jsonEvent, "dur", json_real(e.Duration / 1000.0));
+            json_object_set_new(jsonEvent, "pid", json_integer(0));
+            json_object_set_new(jsonEvent, "tid", json_integer(e.ThreadId));
+            json_array_append_new(jsonEvents, jsonEvent);
+        }
+
+        json_t * json = json_object();
+        json_object_set_new(json, "traceEvents", jsonEvents);
+        json_object_set_new(json, "displayTimeUnit", json_string("ms"));
+        try
+        {
+            Json::WriteToFile(path.c_str(), json, JSON_COMPACT);
+        }
+        catch (const std::exception&)
+        {
+            json_decref(json);
+            throw;
+        }
+        json_decref(json);
+    }
+} // namespace Profiler
@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "../common.h"
+
+/**
+ * Lightweight scoped timers for finding slow frames. While disabled a scope costs a single relaxed load.
+ */
+namespace Profiler
+{
+    // How far back recorded events are kept
+    constexpr double MAX_HISTORY_SECONDS = 30;
+
+    struct Event
+    {
+        const char * Name;  // Must be a string with static storage duration
+        uint64 Start;       // Nanoseconds since the game started
+        uint64 Duration;    // Nanoseconds
+        uint32 ThreadId;
+    };
+
+    struct ScopeSummary
+    {
+        const char * Name;
+        uint32 Count;
+        double TotalMilliseconds;
+        double MaxMilliseconds;
+    };
+
+    // Use IsEnabled and SetEnabled instead
+    extern std::atomic<bool> Enabled;
+
+    inline bool IsEnabled()
+    {
+        return Enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Enables or disables recording. Enabling discards any previously recorded events.
+     */
+    void SetEnabled(bool enabled);
+
+    uint64 GetTime();
+    void RecordEvent(const char * name, uint64 startTime);
+
+    /**
+     * Returns the events that finished within the last given number of seconds, oldest first.
+     */
+    std::vector<Event> GetEvents(double seconds);
+
+    /**
+     * Returns the calls, total and longest time per scope name over the last given number of seconds, ordered by
+     * total time, largest first.
+     */
+    std::vector<ScopeSummary> GetSummary(double seconds);
+
+    /**
+     * Writes the events from the last given number of seconds as a Chrome trace event JSON file, which can be opened
+     * in chrome://tracing or other trace viewers.
+     */
+    void WriteChromeTrace(const std::string& path, double seconds);
+
+    /**
+     * Records the time from construction to destruction as an event with the given name.
+     */
+    class Scope final
+    {
+    private:
+        const char * _name = nullptr;
+        uint64 _startTime = 0;
+
+    public:
+        explicit Scope(const char * name)
+        {
+            if (IsEnabled())
+            {
+                _name = name;
+                _startTime = GetTime();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            if (_name != nullptr)
+            {
+                RecordEvent(_name, _startTime);
+            }
+        }
+    };
+} // namespace Profiler
@@ -10,6 +10,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "RLESprite.hpp"
 
 #ifdef __AVX2__
 
@@ -40,6 +41,184 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     }
 }
 
+/**
+ * The AVX2 variant of the SSE4.1 run copier, copying 32 pixels at a time and then 16 at a time.
+ */
+struct RLECopierAVX2
+{
+    static constexpr sint32 MAX_PALETTE_BLOCKS = 8;
+
+    __m256i PaletteBlocks[MAX_PALETTE_BLOCKS];
+    __m256i PaletteBlockIndices[MAX_PALETTE_BLOCKS];
+    sint32  NumPaletteBlocks = 0;
+    bool    Vectorised = true;
+
+    RLECopierAVX2(const uint8 * palette, sint32 image_type)
+    {
+        // Plain images are drawn without a palette, only recoloured and translucent ones need it
+        bool usesPalette = (image_type & (IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT)) != 0;
+        if ((image_type & IMAGE_TYPE_REMAP) && (image_type & IMAGE_TYPE_TRANSPARENT))
+        {
+            Vectorised = false;
+        }
+        else if (usesPalette && palette == nullptr)
+        {
+            Vectorised = false;
+        }
+        else if (usesPalette)
+        {
+            const __m128i identity = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            for (sint32 block = 0; block < 16 && Vectorised; block++)
+            {
+                const __m128i entries = _mm_loadu_si128((const __m128i *)(palette + block * 16));
+                const __m128i blockIdentity = _mm_add_epi8(identity, _mm_set1_epi8((char)(block * 16)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(entries, blockIdentity)) != 0xFFFF)
+                {
+                    if (NumPaletteBlocks == MAX_PALETTE_BLOCKS)
+                    {
+                        Vectorised = false;
+                    }
+                    else
+                    {
+                        // The shuffles look up within each 128 bit lane, so both lanes hold the block
+                        PaletteBlocks[NumPaletteBlocks] = _mm256_broadcastsi128_si256(entries);
+                        PaletteBlockIndices[NumPaletteBlocks] = _mm256_set1_epi8((char)block);
+                        NumPaletteBlocks++;
+                    }
+                }
+            }
+        }
+    }
+
+    __m256i Remap(__m256i pixels) const
+    {
+        const __m256i lowNibbleMask = _mm256_set1_epi8(0x0F);
+        const __m256i low = _mm256_and_si256(pixels, lowNibbleMask);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(pixels, 4), lowNibbleMask);
+        __m256i result = pixels;
+        for (sint32 i = 0; i < NumPaletteBlocks; i++)
+        {
+            const __m256i inBlock = _mm256_cmpeq_epi8(high, PaletteBlockIndices[i]);
+            result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(PaletteBlocks[i], low), inBlock);
+        }
+        return result;
+    }
+
+    __m128i Remap(__m128i pixels) const
+    {
+        const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+        const __m128i low = _mm_and_si128(pixels, lowNibbleMask);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(pixels, 4), lowNibbleMask);
+        __m128i result = pixels;
+        for (sint32 i = 0; i < NumPaletteBlocks; i++)
+        {
+            const __m128i inBlock = _mm_cmpeq_epi8(high, _mm256_castsi256_si128(PaletteBlockIndices[i]));
+            result = _mm_blendv_epi8(result, _mm_shuffle_epi8(_mm256_castsi256_si128(PaletteBlocks[i]), low), inBlock);
+        }
+        return result;
+    }
+
+    template<sint32 zoom_level>
+    static __m256i LoadPixels(const uint8 * src)
+    {
+        if (zoom_level == 0)
+        {
+            return _mm256_loadu_si256((const __m256i *)src);
+        }
+        const __m128i low = rle_load_pixels_sse4_1<zoom_level>(src);
+        const __m128i high = rle_load_pixels_sse4_1<zoom_level>(src + (16 << zoom_level));
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    }
+
+    template<sint32 image_type, sint32 zoom_level>
+    __m256i CopyPixels(const uint8 * src, const uint8 * dst) const
+    {
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            return Remap(LoadPixels<zoom_level>(src));
+        }
+        else if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            return Remap(_mm256_loadu_si256((const __m256i *)dst));
+        }
+        else
+        {
+            return LoadPixels<zoom_level>(src);
+        }
+    }
+
+    template<sint32 image_type, sint32 zoom_level>
+    __m128i CopyPixels128(const uint8 * src, const uint8 * dst) const
+    {
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            return Remap(rle_load_pixels_sse4_1<zoom_level>(src));
+        }
+        else if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            return Remap(_mm_loadu_si128((const __m128i *)dst));
+        }
+        else
+        {
+            return rle_load_pixels_sse4_1<zoom_level>(src);
+        }
+    }
+
+    template<sint32 image_type, sint32 zoom_level>
+    void CopyRun(const uint8 * RESTRICT copySrc, uint8 * RESTRICT copyDest, sint32 numPixels,
+                 const uint8 * RESTRICT palette_pointer) const
+    {
+        constexpr sint32 sourceStep = 32 << zoom_level;
+        constexpr sint32 halfSourceStep = 16 << zoom_level;
+        constexpr bool isCopy = !(image_type & (IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT));
+        if (!Vectorised || (isCopy && zoom_level == 0) || numPixels < halfSourceStep)
+        {
+            rle_copy_run_scalar<image_type, zoom_level>(copySrc, copyDest, numPixels, palette_pointer);
+            return;
+        }
+
+        // The end of the run is done as one more 16 pixel vector overlapping the previous ones, see
+        // the SSE4.1 copier.
+        constexpr bool overlapLast = zoom_level == 0 || (image_type & IMAGE_TYPE_TRANSPARENT);
+        const sint32 numDestPixels = (numPixels + (1 << zoom_level) - 1) >> zoom_level;
+        uint8 * lastDest = copyDest + numDestPixels - 16;
+        __m128i last = _mm_setzero_si128();
+        if (overlapLast)
+        {
+            last = CopyPixels128<image_type, zoom_level>(copySrc + ((numDestPixels - 16) << zoom_level), lastDest);
+        }
+
+        for (; numPixels >= sourceStep; numPixels -= sourceStep, copySrc += sourceStep, copyDest += 32)
+        {
+            _mm256_storeu_si256((__m256i *)copyDest, CopyPixels<image_type, zoom_level>(copySrc, copyDest));
+        }
+
+        // Runs are at most 127 pixels long, so do another 16 pixels at a time where possible
+        for (; numPixels >= halfSourceStep; numPixels -= halfSourceStep, copySrc += halfSourceStep, copyDest += 16)
+        {
+            _mm_storeu_si128((__m128i *)copyDest, CopyPixels128<image_type, zoom_level>(copySrc, copyDest));
+        }
+
+        if (overlapLast)
+        {
+            _mm_storeu_si128((__m128i *)lastDest, last);
+        }
+        else
+        {
+            rle_copy_run_scalar<image_type, zoom_level>(copySrc, copyDest, numPixels, palette_pointer);
+        }
+    }
+};
+
+void FASTCALL gfx_rle_sprite_to_buffer_avx2(const uint8 * RESTRICT source_bits_pointer, uint8 * RESTRICT dest_bits_pointer,
+                                             const uint8 * RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi,
+                                             sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start,
+                                             sint32 width)
+{
+    rle_draw_sprite(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, image_type, source_y_start, height,
+                    source_x_start, width, RLECopierAVX2(palette_pointer, image_type));
+}
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -52,4 +231,12 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void FASTCALL gfx_rle_sprite_to_buffer_avx2(const uint8 * RESTRICT source_bits_pointer, uint8 * RESTRICT dest_bits_pointer,
+                                             const uint8 * RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi,
+                                             sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start,
+                                             sint32 width)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
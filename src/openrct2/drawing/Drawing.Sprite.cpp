@@ -21,6 +21,7 @@
 #include "../ui/UiContext.h"
 #include "../util/Util.h"
 #include "Drawing.h"
+#include "ZoomedSpriteCache.h"
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Ui;
@@ -271,6 +272,7 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
+    zoomed_sprite_cache_clear();
     SafeFree(_g1.data);
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
@@ -278,6 +280,7 @@ void gfx_unload_g1()
 
 void gfx_unload_g2()
 {
+    zoomed_sprite_cache_clear();
     SafeFree(_g2.data);
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
@@ -285,6 +288,7 @@ void gfx_unload_g2()
 
 void gfx_unload_csg()
 {
+    zoomed_sprite_cache_clear();
     SafeFree(_csg.data);
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
@@ -703,6 +707,10 @@ void FASTCALL gfx_draw_sprite_palette_set_software(rct_drawpixelinfo *dpi, sint3
     if (g1->flags & G1_FLAG_RLE_COMPRESSION){
         // We have to use a different method to move the source pointer for
         // rle encoded sprites so that will be handled within this function
+        if (zoom_level != 0 && zoomed_sprite_cache_draw(image_element, g1, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width))
+        {
+            return;
+        }
         gfx_rle_sprite_to_buffer(g1->offset, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
         return;
     }
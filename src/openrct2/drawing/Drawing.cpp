@@ -486,6 +486,27 @@ void mask_init()
     }
 }
 
+void (FASTCALL *gfx_rle_sprite_to_buffer)(const uint8* RESTRICT source_bits_pointer, uint8* RESTRICT dest_bits_pointer, const uint8* RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi, sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width) = gfx_rle_sprite_to_buffer_scalar;
+
+void rle_sprite_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 RLE sprite function");
+        gfx_rle_sprite_to_buffer = gfx_rle_sprite_to_buffer_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 RLE sprite function");
+        gfx_rle_sprite_to_buffer = gfx_rle_sprite_to_buffer_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar RLE sprite function");
+        gfx_rle_sprite_to_buffer = gfx_rle_sprite_to_buffer_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo *dpi, sint32 x, sint32 y, sint32 colour)
 {
     gfx_fill_rect(dpi, x, y, x, y, colour);
@@ -14,6 +14,7 @@
 #include "../OpenRCT2.h"
 
 #include "Drawing.h"
+#include "ZoomedSpriteCache.h"
 
 constexpr uint32 BASE_IMAGE_ID = 29294;
 constexpr uint32 MAX_IMAGES = 262144;
@@ -235,6 +236,7 @@ void gfx_object_free_images(uint32 baseImageId, uint32 count)
             gfx_set_g1_element(imageId, &g1);
             drawing_engine_invalidate_image(imageId);
         }
+        zoomed_sprite_cache_clear();
 
         FreeImageList(baseImageId, count);
     }
@@ -0,0 +1,263 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#pragma warning(disable : 4127) // conditional expression is constant
+
+#include <cstring>
+#include "Drawing.h"
+
+// The RLE decoding shared by the scalar and SIMD sprite blitters. Each blitter passes a run copier,
+// which copies one run of opaque pixels of a line onto the drawing surface:
+//
+//     template<sint32 image_type, sint32 zoom_level>
+//     void CopyRun(const uint8 * src, uint8 * dst, sint32 numPixels, const uint8 * palette) const;
+//
+// Everything in here has internal linkage, so that the copies compiled with different instruction
+// sets are never merged by the linker.
+
+/**
+ * Copies numPixels source pixels of a run, sampling every (1 << zoom_level)th one.
+ */
+template<sint32 image_type, sint32 zoom_level>
+static inline void rle_copy_run_scalar(const uint8 * RESTRICT copySrc, uint8 * RESTRICT copyDest, sint32 numPixels,
+                                       const uint8 * RESTRICT palette_pointer)
+{
+    constexpr sint32 zoom_amount = 1 << zoom_level;
+
+    // If the image type is not a basic one we require to mix the pixels
+    if (image_type & IMAGE_TYPE_REMAP)  // palette controlled images
+    {
+        for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
+        {
+            if (image_type & IMAGE_TYPE_TRANSPARENT)
+            {
+                uint16 color = ((*copySrc << 8) | *copyDest) - 0x100;
+                *copyDest = palette_pointer[color];
+            }
+            else
+            {
+                *copyDest = palette_pointer[*copySrc];
+            }
+        }
+    }
+    else if (image_type & IMAGE_TYPE_TRANSPARENT)  // single alpha blended color (used for glass)
+    {
+        for (int j = 0; j < numPixels; j += zoom_amount, copyDest++)
+        {
+            uint8 pixel = *copyDest;
+            pixel = palette_pointer[pixel];
+            *copyDest = pixel;
+        }
+    }
+    else  // standard opaque image
+    {
+        if (zoom_level == 0)
+        {
+            // Since we're sampling each pixel at this zoom level, just do a straight memcpy
+            if (numPixels > 0)
+                memcpy(copyDest, copySrc, numPixels);
+        }
+        else
+        {
+            for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
+                *copyDest = *copySrc;
+        }
+    }
+}
+
+template<sint32 image_type, sint32 zoom_level, typename TCopier>
+static void FASTCALL rle_draw_sprite(const uint8 * RESTRICT source_bits_pointer,
+                                     uint8 * RESTRICT dest_bits_pointer,
+                                     const uint8 * RESTRICT palette_pointer,
+                                     const rct_drawpixelinfo * RESTRICT dpi,
+                                     sint32 source_y_start,
+                                     sint32 height,
+                                     sint32 source_x_start,
+                                     sint32 width,
+                                     const TCopier &copier)
+{
+    // The distance between two samples in the source image.
+    // We draw the image at 1 / (2^zoom_level) scale.
+    sint32 zoom_amount = 1 << zoom_level;
+
+    // Width of one screen line in the dest buffer
+    sint32 line_width = (dpi->width >> zoom_level) + dpi->pitch;
+
+    // Move up to the first line of the image if source_y_start is negative. Why does this even occur?
+    if (source_y_start < 0)
+    {
+        source_y_start    += zoom_amount;
+        height            -= zoom_amount;
+        dest_bits_pointer += line_width;
+    }
+
+    //For every line in the image
+    for (sint32 i = 0; i < height; i += zoom_amount)
+    {
+        sint32 y = source_y_start + i;
+
+        //The first part of the source pointer is a list of offsets to different lines
+        //This will move the pointer to the correct source line.
+        const uint8 *lineData = source_bits_pointer + ((uint16*)source_bits_pointer)[y];
+        uint8* loop_dest_pointer = dest_bits_pointer + line_width * (i >> zoom_level);
+
+        uint8 isEndOfLine = 0;
+
+        // For every data chunk in the line
+        while (!isEndOfLine)
+        {
+            const uint8* copySrc = lineData;
+
+            // Read chunk metadata
+            uint8 dataSize    = *copySrc++;
+            uint8 firstPixelX = *copySrc++;
+
+            isEndOfLine = dataSize & 0x80;  // If the last bit in dataSize is set, then this is the last line
+            dataSize &= 0x7F;               // The rest of the bits are the actual size
+
+            //Have our next source pointer point to the next data section
+            lineData = copySrc + dataSize;
+
+            sint32 x_start = firstPixelX - source_x_start;
+            sint32 numPixels = dataSize;
+
+            if (x_start > 0)
+            {
+                int mod = x_start & (zoom_amount - 1);  // x_start modulo zoom_amount
+
+                // If x_start is not a multiple of zoom_amount, round it up to a multiple
+                if (mod != 0)
+                {
+                    int offset = zoom_amount - mod;
+                    x_start   += offset;
+                    copySrc   += offset;
+                    numPixels -= offset;
+                }
+            }
+            else if (x_start < 0)
+            {
+                // Clamp x_start to zero if negative
+                int offset = 0 - x_start;
+                x_start = 0;
+                copySrc   += offset;
+                numPixels -= offset;
+            }
+
+            //If the end position is further out than the whole image
+            //end position then we need to shorten the line again
+            if (x_start + numPixels > width)
+                numPixels = width - x_start;
+
+            uint8 *copyDest = loop_dest_pointer + (x_start >> zoom_level);
+
+            //Finally after all those checks, copy the image onto the drawing surface
+            copier.template CopyRun<image_type, zoom_level>(copySrc, copyDest, numPixels, palette_pointer);
+        }
+    }
+}
+
+template<sint32 image_type, typename TCopier>
+static void FASTCALL rle_draw_sprite(const uint8 * source_bits_pointer,
+                                     uint8 * dest_bits_pointer,
+                                     const uint8 * palette_pointer,
+                                     const rct_drawpixelinfo * dpi,
+                                     sint32 source_y_start,
+                                     sint32 height,
+                                     sint32 source_x_start,
+                                     sint32 width,
+                                     const TCopier &copier)
+{
+#define RLE_DRAW_SPRITE_ZOOM(zoom_level) \
+    rle_draw_sprite<image_type, zoom_level>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width, copier)
+
+    switch (dpi->zoom_level) {
+    case 0: RLE_DRAW_SPRITE_ZOOM(0); break;
+    case 1: RLE_DRAW_SPRITE_ZOOM(1); break;
+    case 2: RLE_DRAW_SPRITE_ZOOM(2); break;
+    case 3: RLE_DRAW_SPRITE_ZOOM(3); break;
+    default: assert(false); break;
+    }
+
+#undef RLE_DRAW_SPRITE_ZOOM
+}
+
+template<typename TCopier>
+static void FASTCALL rle_draw_sprite(const uint8 * source_bits_pointer,
+                                     uint8 * dest_bits_pointer,
+                                     const uint8 * palette_pointer,
+                                     const rct_drawpixelinfo * dpi,
+                                     sint32 image_type,
+                                     sint32 source_y_start,
+                                     sint32 height,
+                                     sint32 source_x_start,
+                                     sint32 width,
+                                     const TCopier &copier)
+{
+#define RLE_DRAW_SPRITE_TYPE(image_type) \
+    rle_draw_sprite<image_type>(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, source_y_start, height, source_x_start, width, copier)
+
+    if (image_type & IMAGE_TYPE_REMAP)
+    {
+        if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            RLE_DRAW_SPRITE_TYPE(IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT);
+        }
+        else
+        {
+            RLE_DRAW_SPRITE_TYPE(IMAGE_TYPE_REMAP);
+        }
+    }
+    else if (image_type & IMAGE_TYPE_TRANSPARENT)
+    {
+        RLE_DRAW_SPRITE_TYPE(IMAGE_TYPE_TRANSPARENT);
+    }
+    else
+    {
+        RLE_DRAW_SPRITE_TYPE(IMAGE_TYPE_DEFAULT);
+    }
+
+#undef RLE_DRAW_SPRITE_TYPE
+}
+
+#ifdef __SSE4_1__
+
+#include <immintrin.h>
+
+/**
+ * Loads 16 pixels of a run, sampling every (1 << zoom_level)th one. Reads 16 << zoom_level bytes.
+ */
+template<sint32 zoom_level>
+static inline __m128i rle_load_pixels_sse4_1(const uint8 * src)
+{
+    if (zoom_level == 0)
+    {
+        return _mm_loadu_si128((const __m128i *)src);
+    }
+
+    // Keep the sampled byte of every (1 << zoom_level) byte lane, then narrow the lanes to bytes
+    __m128i lanes[8];
+    constexpr sint32 numLanes = 1 << zoom_level;
+    const __m128i keep = zoom_level == 1 ? _mm_set1_epi16(0x00FF) : zoom_level == 2 ? _mm_set1_epi32(0xFF) : _mm_set1_epi64x(0xFF);
+    for (sint32 i = 0; i < numLanes; i++)
+    {
+        lanes[i] = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + i * 16)), keep);
+    }
+    for (sint32 n = numLanes; n > 2; n /= 2)
+    {
+        for (sint32 i = 0; i < n / 2; i++)
+        {
+            lanes[i] = _mm_packus_epi32(lanes[i * 2], lanes[i * 2 + 1]);
+        }
+    }
+    return _mm_packus_epi16(lanes[0], lanes[1]);
+}
+
+#endif // __SSE4_1__
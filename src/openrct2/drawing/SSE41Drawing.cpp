@@ -10,6 +10,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "RLESprite.hpp"
 
 #ifdef __SSE4_1__
 
@@ -55,6 +56,137 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     }
 }
 
+/**
+ * Copies the runs of an RLE sprite 16 pixels at a time. Palettes are looked up with byte shuffles
+ * of each 16 entry block of the palette that is not an identity mapping, which covers the
+ * recolouring palettes. Palettes changing more blocks than that, the two dimensional palettes of
+ * translucent recoloured images, short runs and the ends of zoomed out runs that are copied from
+ * the sprite go through the scalar path.
+ */
+struct RLECopierSSE41
+{
+    static constexpr sint32 MAX_PALETTE_BLOCKS = 8;
+
+    __m128i PaletteBlocks[MAX_PALETTE_BLOCKS];
+    __m128i PaletteBlockIndices[MAX_PALETTE_BLOCKS];
+    sint32  NumPaletteBlocks = 0;
+    bool    Vectorised = true;
+
+    RLECopierSSE41(const uint8 * palette, sint32 image_type)
+    {
+        // Plain images are drawn without a palette, only recoloured and translucent ones need it
+        bool usesPalette = (image_type & (IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT)) != 0;
+        if ((image_type & IMAGE_TYPE_REMAP) && (image_type & IMAGE_TYPE_TRANSPARENT))
+        {
+            Vectorised = false;
+        }
+        else if (usesPalette && palette == nullptr)
+        {
+            Vectorised = false;
+        }
+        else if (usesPalette)
+        {
+            const __m128i identity = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            for (sint32 block = 0; block < 16 && Vectorised; block++)
+            {
+                const __m128i entries = _mm_loadu_si128((const __m128i *)(palette + block * 16));
+                const __m128i blockIdentity = _mm_add_epi8(identity, _mm_set1_epi8((char)(block * 16)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(entries, blockIdentity)) != 0xFFFF)
+                {
+                    if (NumPaletteBlocks == MAX_PALETTE_BLOCKS)
+                    {
+                        Vectorised = false;
+                    }
+                    else
+                    {
+                        PaletteBlocks[NumPaletteBlocks] = entries;
+                        PaletteBlockIndices[NumPaletteBlocks] = _mm_set1_epi8((char)block);
+                        NumPaletteBlocks++;
+                    }
+                }
+            }
+        }
+    }
+
+    __m128i Remap(__m128i pixels) const
+    {
+        const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+        const __m128i low = _mm_and_si128(pixels, lowNibbleMask);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(pixels, 4), lowNibbleMask);
+        __m128i result = pixels;
+        for (sint32 i = 0; i < NumPaletteBlocks; i++)
+        {
+            const __m128i inBlock = _mm_cmpeq_epi8(high, PaletteBlockIndices[i]);
+            result = _mm_blendv_epi8(result, _mm_shuffle_epi8(PaletteBlocks[i], low), inBlock);
+        }
+        return result;
+    }
+
+    template<sint32 image_type, sint32 zoom_level>
+    __m128i CopyPixels(const uint8 * src, const uint8 * dst) const
+    {
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            return Remap(rle_load_pixels_sse4_1<zoom_level>(src));
+        }
+        else if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            return Remap(_mm_loadu_si128((const __m128i *)dst));
+        }
+        else
+        {
+            return rle_load_pixels_sse4_1<zoom_level>(src);
+        }
+    }
+
+    template<sint32 image_type, sint32 zoom_level>
+    void CopyRun(const uint8 * RESTRICT copySrc, uint8 * RESTRICT copyDest, sint32 numPixels,
+                 const uint8 * RESTRICT palette_pointer) const
+    {
+        constexpr sint32 sourceStep = 16 << zoom_level;
+        constexpr bool isCopy = !(image_type & (IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT));
+        if (!Vectorised || (isCopy && zoom_level == 0) || numPixels < sourceStep)
+        {
+            rle_copy_run_scalar<image_type, zoom_level>(copySrc, copyDest, numPixels, palette_pointer);
+            return;
+        }
+
+        // The end of the run is done as one more vector overlapping the last full one, where that
+        // does not read past the run. It is worked out first, as glass reads the pixels it writes.
+        constexpr bool overlapLast = zoom_level == 0 || (image_type & IMAGE_TYPE_TRANSPARENT);
+        const sint32 numDestPixels = (numPixels + (1 << zoom_level) - 1) >> zoom_level;
+        uint8 * lastDest = copyDest + numDestPixels - 16;
+        __m128i last = _mm_setzero_si128();
+        if (overlapLast)
+        {
+            last = CopyPixels<image_type, zoom_level>(copySrc + ((numDestPixels - 16) << zoom_level), lastDest);
+        }
+
+        for (; numPixels >= sourceStep; numPixels -= sourceStep, copySrc += sourceStep, copyDest += 16)
+        {
+            _mm_storeu_si128((__m128i *)copyDest, CopyPixels<image_type, zoom_level>(copySrc, copyDest));
+        }
+
+        if (overlapLast)
+        {
+            _mm_storeu_si128((__m128i *)lastDest, last);
+        }
+        else
+        {
+            rle_copy_run_scalar<image_type, zoom_level>(copySrc, copyDest, numPixels, palette_pointer);
+        }
+    }
+};
+
+void FASTCALL gfx_rle_sprite_to_buffer_sse4_1(const uint8 * RESTRICT source_bits_pointer, uint8 * RESTRICT dest_bits_pointer,
+                                               const uint8 * RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi,
+                                               sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start,
+                                               sint32 width)
+{
+    rle_draw_sprite(source_bits_pointer, dest_bits_pointer, palette_pointer, dpi, image_type, source_y_start, height,
+                    source_x_start, width, RLECopierSSE41(palette_pointer, image_type));
+}
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -67,4 +199,12 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void FASTCALL gfx_rle_sprite_to_buffer_sse4_1(const uint8 * RESTRICT source_bits_pointer, uint8 * RESTRICT dest_bits_pointer,
+                                               const uint8 * RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi,
+                                               sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start,
+                                               sint32 width)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
@@ -31,8 +31,6 @@ struct rct_draw_scroll_text {
 assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
-#define MAX_SCROLLING_TEXT_ENTRIES 32
-
 static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8 _characterBitmaps[FONT_SPRITE_GLYPH_COUNT][8];
 static uint32 _drawSCrollNextIndex = 0;
@@ -1428,6 +1426,7 @@ sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uin
 
     if (dpi->zoom_level != 0) return SPR_SCROLLING_TEXT_DEFAULT;
 
+    session->ScrollingTextCount++;
     _drawSCrollNextIndex++;
 
     sint32 scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode);
@@ -0,0 +1,263 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "../config/Config.h"
+#include "../sprites.h"
+#include "Drawing.h"
+#include "ZoomedSpriteCache.h"
+
+/**
+ * An RLE sprite sampled at one zoom level and sampling phase, encoded as an RLE sprite that is
+ * drawn at zoom level 0. The image it was sampled from is kept, so that images replaced by
+ * objects being loaded are noticed.
+ */
+struct zoomed_sprite_cache_entry
+{
+    uint64             Key;
+    const uint8 *      Source;
+    sint16             Width;
+    sint16             Height;
+    bool               Drawable;
+    std::vector<uint8> Data;
+};
+
+// Most recently used first. Sprites are only drawn on the main thread, so there is no locking.
+static std::list<zoomed_sprite_cache_entry> _entries;
+static std::unordered_map<uint64, std::list<zoomed_sprite_cache_entry>::iterator> _index;
+static size_t _bytes;
+static uint32 _hits;
+static uint32 _misses;
+static uint32 _evictions;
+
+static size_t zoomed_sprite_cache_get_budget()
+{
+    return (size_t)std::max(0, gConfigGeneral.zoomed_sprite_cache_size) * 1024 * 1024;
+}
+
+static size_t zoomed_sprite_cache_entry_size(const zoomed_sprite_cache_entry& entry)
+{
+    return sizeof(zoomed_sprite_cache_entry) + entry.Data.size();
+}
+
+/**
+ * Samples every (1 << zoomLevel)th pixel of every (1 << zoomLevel)th line of an RLE sprite,
+ * starting at the given phase. Returns false if the result does not fit the RLE format.
+ */
+static bool zoomed_sprite_cache_decode(const rct_g1_element * g1, sint32 zoomLevel, sint32 phaseX, sint32 phaseY,
+                                       std::vector<uint8>& result)
+{
+    // Runs start at most at 255 and are at most 127 pixels long
+    constexpr sint32 MAX_LINE_WIDTH = 255 + 127;
+
+    sint32 zoomAmount = 1 << zoomLevel;
+    sint32 numLines = std::max(0, (g1->height - phaseY + zoomAmount - 1) >> zoomLevel);
+    result.assign(numLines * 2, 0);
+
+    uint8 linePixels[MAX_LINE_WIDTH];
+    bool lineOpaque[MAX_LINE_WIDTH];
+    for (sint32 line = 0; line < numLines; line++)
+    {
+        if (result.size() > 0xFFFF)
+        {
+            return false;
+        }
+        uint16 lineOffset = (uint16)result.size();
+        std::memcpy(&result[line * 2], &lineOffset, sizeof(lineOffset));
+
+        // Decode the source line
+        sint32 y = phaseY + line * zoomAmount;
+        const uint8 * lineData = g1->offset + ((const uint16 *)g1->offset)[y];
+        std::fill_n(lineOpaque, MAX_LINE_WIDTH, false);
+        sint32 lineWidth = 0;
+        uint8 isEndOfLine = 0;
+        while (!isEndOfLine)
+        {
+            uint8 dataSize = *lineData++;
+            uint8 firstPixelX = *lineData++;
+            isEndOfLine = dataSize & 0x80;
+            dataSize &= 0x7F;
+            std::memcpy(&linePixels[firstPixelX], lineData, dataSize);
+            std::fill_n(&lineOpaque[firstPixelX], dataSize, true);
+            lineWidth = std::max(lineWidth, firstPixelX + dataSize);
+            lineData += dataSize;
+        }
+
+        // Encode runs of the sampled pixels
+        sint32 numSamples = std::max(0, (lineWidth - phaseX + zoomAmount - 1) >> zoomLevel);
+        size_t lastRun = 0;
+        for (sint32 sample = 0; sample < numSamples;)
+        {
+            if (!lineOpaque[phaseX + sample * zoomAmount])
+            {
+                sample++;
+                continue;
+            }
+            if (sample > 255)
+            {
+                return false;
+            }
+
+            sint32 runStart = sample;
+            lastRun = result.size();
+            result.push_back(0);
+            result.push_back((uint8)runStart);
+            while (sample < numSamples && sample - runStart < 127 && lineOpaque[phaseX + sample * zoomAmount])
+            {
+                result.push_back(linePixels[phaseX + sample * zoomAmount]);
+                sample++;
+            }
+            result[lastRun] = (uint8)(sample - runStart);
+        }
+
+        if (lastRun == 0)
+        {
+            // Empty line
+            result.push_back(0x80);
+            result.push_back(0);
+        }
+        else
+        {
+            result[lastRun] |= 0x80;
+        }
+    }
+    return true;
+}
+
+static const zoomed_sprite_cache_entry * zoomed_sprite_cache_get(sint32 imageId, const rct_g1_element * g1, sint32 zoomLevel,
+                                                                 sint32 phaseX, sint32 phaseY, size_t budget)
+{
+    uint64 key = ((uint64)(uint32)imageId << 8) | (zoomLevel << 6) | (phaseX << 3) | phaseY;
+    auto it = _index.find(key);
+    if (it != _index.end())
+    {
+        auto entry = it->second;
+        if (entry->Source == g1->offset && entry->Width == g1->width && entry->Height == g1->height)
+        {
+            _hits++;
+            _entries.splice(_entries.begin(), _entries, entry);
+            return &*entry;
+        }
+        _bytes -= zoomed_sprite_cache_entry_size(*entry);
+        _entries.erase(entry);
+        _index.erase(it);
+    }
+
+    _misses++;
+    zoomed_sprite_cache_entry entry;
+    entry.Key = key;
+    entry.Source = g1->offset;
+    entry.Width = g1->width;
+    entry.Height = g1->height;
+    entry.Drawable = zoomed_sprite_cache_decode(g1, zoomLevel, phaseX, phaseY, entry.Data);
+    if (!entry.Drawable)
+    {
+        entry.Data.clear();
+        entry.Data.shrink_to_fit();
+    }
+
+    size_t entrySize = zoomed_sprite_cache_entry_size(entry);
+    if (entrySize > budget)
+    {
+        return nullptr;
+    }
+    while (_bytes + entrySize > budget)
+    {
+        auto& evicted = _entries.back();
+        _bytes -= zoomed_sprite_cache_entry_size(evicted);
+        _index.erase(evicted.Key);
+        _entries.pop_back();
+        _evictions++;
+    }
+
+    _bytes += entrySize;
+    _entries.push_front(std::move(entry));
+    _index[key] = _entries.begin();
+    return &_entries.front();
+}
+
+/**
+ * Draws a clipped RLE sprite at a zoom level other than 0 from a copy that has already been
+ * sampled at that zoom level, drawing the same pixels as gfx_rle_sprite_to_buffer would.
+ * Returns false if the sprite has to be drawn from the original image.
+ */
+bool zoomed_sprite_cache_draw(sint32 imageId, const rct_g1_element * g1, uint8 * dest_bits_pointer,
+                              const uint8 * palette_pointer, const rct_drawpixelinfo * dpi, sint32 image_type,
+                              sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width)
+{
+    sint32 zoom_level = dpi->zoom_level;
+    size_t budget = zoomed_sprite_cache_get_budget();
+    if (zoom_level == 0 || budget == 0)
+    {
+        return false;
+    }
+
+    // Temporary images and scrolling text are redrawn into the same image ids
+    if (imageId == SPR_TEMP ||
+        (imageId >= SPR_SCROLLING_TEXT_START && imageId < SPR_SCROLLING_TEXT_START + MAX_SCROLLING_TEXT_ENTRIES))
+    {
+        return false;
+    }
+
+    // Skip the first line the same way the RLE blitter does
+    sint32 zoom_amount = 1 << zoom_level;
+    if (source_y_start < 0)
+    {
+        source_y_start    += zoom_amount;
+        height            -= zoom_amount;
+        dest_bits_pointer += (dpi->width >> zoom_level) + dpi->pitch;
+    }
+    if (height <= 0)
+    {
+        return true;
+    }
+
+    // The blitter samples the pixels whose source coordinates are congruent to the source start
+    sint32 phaseX = source_x_start & (zoom_amount - 1);
+    sint32 phaseY = source_y_start & (zoom_amount - 1);
+    const zoomed_sprite_cache_entry * entry = zoomed_sprite_cache_get(imageId, g1, zoom_level, phaseX, phaseY, budget);
+    if (entry == nullptr || !entry->Drawable)
+    {
+        return false;
+    }
+
+    rct_drawpixelinfo zoomedDpi = {};
+    zoomedDpi.bits = dpi->bits;
+    zoomedDpi.width = dpi->width >> zoom_level;
+    zoomedDpi.height = dpi->height >> zoom_level;
+    zoomedDpi.pitch = dpi->pitch;
+    zoomedDpi.zoom_level = 0;
+    gfx_rle_sprite_to_buffer(entry->Data.data(), dest_bits_pointer, palette_pointer, &zoomedDpi, image_type,
+                             source_y_start >> zoom_level, (height + zoom_amount - 1) >> zoom_level,
+                             source_x_start >> zoom_level, (width + zoom_amount - 1) >> zoom_level);
+    return true;
+}
+
+void zoomed_sprite_cache_clear()
+{
+    _entries.clear();
+    _index.clear();
+    _bytes = 0;
+}
+
+zoomed_sprite_cache_statistics zoomed_sprite_cache_get_statistics()
+{
+    zoomed_sprite_cache_statistics statistics = {};
+    statistics.Hits = _hits;
+    statistics.Misses = _misses;
+    statistics.Evictions = _evictions;
+    statistics.Entries = (uint32)_entries.size();
+    statistics.Bytes = _bytes;
+    statistics.Budget = zoomed_sprite_cache_get_budget();
+    return statistics;
+}
@@ -0,0 +1,34 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _ZOOMED_SPRITE_CACHE_H
+#define _ZOOMED_SPRITE_CACHE_H
+
+#include "../common.h"
+
+struct rct_drawpixelinfo;
+struct rct_g1_element;
+
+struct zoomed_sprite_cache_statistics
+{
+    uint32 Hits;
+    uint32 Misses;
+    uint32 Evictions;
+    uint32 Entries;
+    size_t Bytes;
+    size_t Budget;
+};
+
+bool zoomed_sprite_cache_draw(sint32 imageId, const rct_g1_element * g1, uint8 * dest_bits_pointer,
+                              const uint8 * palette_pointer, const rct_drawpixelinfo * dpi, sint32 image_type,
+                              sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width);
+void zoomed_sprite_cache_clear();
+zoomed_sprite_cache_statistics zoomed_sprite_cache_get_statistics();
+
+#endif
@@ -18,9 +18,11 @@
 #include "../Context.h"
 #include "../core/Guard.hpp"
 #include "../core/Math.hpp"
+#include "../core/Profiler.h"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
 #include "../drawing/Font.h"
+#include "../drawing/ZoomedSpriteCache.h"
 #include "../EditorObjectSelectionSession.h"
 #include "../Game.h"
 #include "../interface/Colour.h"
@@ -34,13 +36,21 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../OpenRCT2.h"
+#include "../paint/Paint.h"
+#include "../peep/GuestFlowField.h"
+#include "../peep/GuestStore.h"
 #include "../peep/Staff.h"
+#include "../peep/StaffJobs.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
 #include "../util/Util.h"
 #include "../Version.h"
 #include "../windows/Intent.h"
+#include "../world/Ambience.h"
 #include "../world/Climate.h"
+#include "../world/FootpathConnectivity.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
@@ -480,6 +490,12 @@ static sint32 cc_get(InteractiveConsole &console, const utf8 **argv, sint32 argc
         else if (strcmp(argv[0], "render_weather_gloom") == 0) {
             console.WriteFormatLine("render_weather_gloom %d", gConfigGeneral.render_weather_gloom);
         }
+        else if (strcmp(argv[0], "zoomed_sprite_cache_size") == 0) {
+            console.WriteFormatLine("zoomed_sprite_cache_size %d", gConfigGeneral.zoomed_sprite_cache_size);
+        }
+        else if (strcmp(argv[0], "pathfinding_graph_search") == 0) {
+            console.WriteFormatLine("pathfinding_graph_search %d", gConfigGeneral.pathfinding_graph_search);
+        }
         else if (strcmp(argv[0], "cheat_sandbox_mode") == 0) {
             console.WriteFormatLine("cheat_sandbox_mode %d", gCheatsSandboxMode);
         }
@@ -692,6 +708,16 @@ static sint32 cc_set(InteractiveConsole &console, const utf8 **argv, sint32 argc
             config_save_default();
             console.Execute("get render_weather_gloom");
         }
+        else if (strcmp(argv[0], "zoomed_sprite_cache_size") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+            gConfigGeneral.zoomed_sprite_cache_size = std::max(0, int_val[0]);
+            config_save_default();
+            console.Execute("get zoomed_sprite_cache_size");
+        }
+        else if (strcmp(argv[0], "pathfinding_graph_search") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
+            gConfigGeneral.pathfinding_graph_search = (int_val[0] != 0);
+            config_save_default();
+            console.Execute("get pathfinding_graph_search");
+        }
         else if (strcmp(argv[0], "cheat_sandbox_mode") == 0 && invalidArguments(&invalidArgs, int_valid[0])) {
             if (gCheatsSandboxMode != (int_val[0] != 0)) {
                 if (game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_SANDBOXMODE, (int_val[0] != 0), GAME_COMMAND_CHEAT, 0, 0) != MONEY32_UNDEFINED) {
@@ -915,8 +941,7 @@ cc_remove_park_fences(InteractiveConsole & console, [[maybe_unused]] const utf8
 
 static sint32 cc_show_limits(InteractiveConsole & console, [[maybe_unused]] const utf8 ** argv, [[maybe_unused]] sint32 argc)
 {
-    map_reorganise_elements();
-    sint32 tileElementCount = gNextFreeTileElement - gTileElements - 1;
+    sint32 tileElementCount = (sint32)map_get_tile_element_statistics().Live;
 
     sint32 rideCount = 0;
     for (sint32 i = 0; i < MAX_RIDES; ++i) 
@@ -952,7 +977,7 @@ static sint32 cc_show_limits(InteractiveConsole & console, [[maybe_unused]] cons
         }
     }
 
-    console.WriteFormatLine("Sprites: %d/%d", spriteCount, MAX_SPRITES);
+    console.WriteFormatLine("Sprites: %d/%d", spriteCount, (sint32)sprite_get_memory_usage().Limit);
     console.WriteFormatLine("Map Elements: %d/%d", tileElementCount, MAX_TILE_ELEMENTS);
     console.WriteFormatLine("Banners: %d/%d", bannerCount, MAX_BANNERS);
     console.WriteFormatLine("Rides: %d/%d", rideCount, MAX_RIDES);
@@ -1017,6 +1042,245 @@ static sint32
     return 1;
 }
 
+static sint32 cc_profiler(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc < 1)
+    {
+        console.WriteFormatLine("Profiler is %s.", Profiler::IsEnabled() ? "recording" : "stopped");
+        return 0;
+    }
+
+    if (strcmp(argv[0], "start") == 0)
+    {
+        Profiler::SetEnabled(true);
+        console.WriteLine("Profiler started.");
+    }
+    else if (strcmp(argv[0], "stop") == 0)
+    {
+        Profiler::SetEnabled(false);
+        console.WriteLine("Profiler stopped.");
+    }
+    else if (strcmp(argv[0], "summary") == 0)
+    {
+        double seconds = argc > 1 ? atof(argv[1]) : 1;
+        console.WriteFormatLine("%-32s %8s %10s %10s", "scope", "calls", "total ms", "max ms");
+        for (const auto& summary : Profiler::GetSummary(seconds))
+        {
+            console.WriteFormatLine("%-32s %8u %10.2f %10.2f", summary.Name, summary.Count, summary.TotalMilliseconds,
+                summary.MaxMilliseconds);
+        }
+    }
+    else if (strcmp(argv[0], "dump") == 0 && argc > 1)
+    {
+        double seconds = argc > 2 ? atof(argv[2]) : 10;
+        try
+        {
+            Profiler::WriteChromeTrace(argv[1], seconds);
+            console.WriteFormatLine("Trace of the last %.1f seconds written to %s", seconds, argv[1]);
+        }
+        catch (const std::exception& e)
+        {
+            console.WriteLineError(e.what());
+        }
+    }
+    else
+    {
+        console.WriteLineError("Invalid usage.");
+    }
+    return 0;
+}
+
+static sint32 cc_sprite_cache(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        zoomed_sprite_cache_clear();
+        console.WriteLine("Zoomed sprite cache cleared.");
+        return 0;
+    }
+
+    auto statistics = zoomed_sprite_cache_get_statistics();
+    console.WriteFormatLine("Entries: %u", statistics.Entries);
+    console.WriteFormatLine("Memory: %.1f / %.1f MiB", statistics.Bytes / (1024.0 * 1024.0), statistics.Budget / (1024.0 * 1024.0));
+    console.WriteFormatLine("Hits: %u", statistics.Hits);
+    console.WriteFormatLine("Misses: %u", statistics.Misses);
+    console.WriteFormatLine("Evictions: %u", statistics.Evictions);
+    return 0;
+}
+
+static sint32 cc_footpath_graph(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        footpath_graph_invalidate_all();
+        console.WriteLine("Footpath navigation graph cleared.");
+        return 0;
+    }
+
+    auto statistics = footpath_graph_get_statistics();
+    console.WriteFormatLine("Segments: %u", statistics.Segments);
+    console.WriteFormatLine("Tiles: %u", statistics.Steps);
+    console.WriteFormatLine("Hits: %u", statistics.Hits);
+    console.WriteFormatLine("Misses: %u", statistics.Misses);
+    return 0;
+}
+
+static sint32 cc_flow_fields(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        guest_flow_field_clear();
+        console.WriteLine("Guest flow fields cleared.");
+        return 0;
+    }
+
+    auto statistics = guest_flow_field_get_statistics();
+    uint32 lookups = statistics.Hits + statistics.Misses;
+    console.WriteFormatLine("Fields: %u", statistics.Fields);
+    console.WriteFormatLine("Hits: %u (%.1f%%)", statistics.Hits, lookups == 0 ? 0.0 : statistics.Hits * 100.0 / lookups);
+    console.WriteFormatLine("Misses: %u", statistics.Misses);
+    console.WriteFormatLine("Unreached: %u", statistics.Unreached);
+    console.WriteFormatLine("Evictions: %u", statistics.Evictions);
+    console.WriteFormatLine("Tiles built: %llu", (unsigned long long)statistics.TilesBuilt);
+    console.WriteFormatLine("Build time: %.1f ms", statistics.BuildTime / 1000.0);
+    return 0;
+}
+
+static sint32 cc_ride_proximity(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        ride_proximity_invalidate_all();
+        console.WriteLine("Ride proximity index cleared.");
+        return 0;
+    }
+
+    auto statistics = ride_proximity_get_statistics();
+    console.WriteFormatLine("Queries: %u", statistics.Queries);
+    console.WriteFormatLine("Cells rebuilt: %u", statistics.CellsRebuilt);
+    console.WriteFormatLine("Cells merged: %u", statistics.CellsMerged);
+    console.WriteFormatLine("Cells scanned: %u", statistics.CellsScanned);
+    return 0;
+}
+
+static sint32 cc_ambience(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        ambience_invalidate_all();
+        console.WriteLine("Ambience counts cleared.");
+        return 0;
+    }
+
+    auto statistics = ambience_get_statistics();
+    console.WriteFormatLine("Queries: %u", statistics.Queries);
+    console.WriteFormatLine("Tiles rebuilt: %u", statistics.TilesRebuilt);
+    console.WriteFormatLine("Rows summed: %u", statistics.RowsSummed);
+    return 0;
+}
+
+static sint32 cc_guest_think(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    auto statistics = guest_path_finding_get_think_statistics();
+    uint32 decided = statistics.Used + statistics.Discarded;
+    console.WriteFormatLine("Threads: %d", gConfigGeneral.guest_think_threads);
+    console.WriteFormatLine("Thoughts: %u", statistics.Thoughts);
+    console.WriteFormatLine("Used: %u (%.1f%%)", statistics.Used, decided == 0 ? 0.0 : statistics.Used * 100.0 / decided);
+    console.WriteFormatLine("Discarded: %u", statistics.Discarded);
+    return 0;
+}
+
+static sint32 cc_guest_store(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        guest_store_invalidate();
+        console.WriteLine("Guest store cleared.");
+        return 0;
+    }
+
+    auto statistics = guest_store_get_statistics();
+    console.WriteFormatLine("Guests: %u", statistics.Guests);
+    console.WriteFormatLine("Rebuilds: %u", statistics.Rebuilds);
+    console.WriteFormatLine("Updates: %u", statistics.Updates);
+    console.WriteFormatLine("Queries: %u", statistics.Queries);
+    return 0;
+}
+
+static sint32 cc_footpath_connectivity(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    auto statistics = footpath_connectivity_get_statistics();
+    console.WriteFormatLine("Path elements labelled: %u", statistics.Elements);
+    console.WriteFormatLine("Builds: %u", statistics.Builds);
+    console.WriteFormatLine("Queries: %u", statistics.Queries);
+    return 0;
+}
+
+static sint32 cc_staff_jobs(InteractiveConsole &console, const utf8 **argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "clear") == 0)
+    {
+        staff_jobs_invalidate_all();
+        console.WriteLine("Staff jobs cleared.");
+        return 0;
+    }
+
+    auto statistics = staff_jobs_get_statistics();
+    console.WriteFormatLine("Tiles asked for jobs: %u", statistics.Queries);
+    console.WriteFormatLine("Cells rebuilt: %u", statistics.CellsRebuilt);
+    console.WriteFormatLine("Cells with plants to water, grass to mow or bins to empty: %u", statistics.CellsWithJobs);
+    console.WriteFormatLine("Mechanics rides can call: %u", statistics.Mechanics);
+    console.WriteFormatLine("Mechanic lists rebuilt: %u", statistics.MechanicRebuilds);
+    return 0;
+}
+
+static sint32 cc_sprite_memory(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    static constexpr const char * listNames[NUM_SPRITE_LISTS] = { "Free", "Vehicles", "Peeps", "Misc", "Litter", "Unknown" };
+
+    auto usage = sprite_get_memory_usage();
+    for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
+    {
+        console.WriteFormatLine("%s: %u sprites, %u KiB", listNames[i], usage.Count[i], (uint32)(usage.Bytes[i] / 1024));
+    }
+    console.WriteFormatLine("Capacity: %u/%u sprites", (uint32)usage.Capacity, (uint32)usage.Limit);
+    console.WriteFormatLine("Allocated: %u KiB", (uint32)(usage.BytesAllocated / 1024));
+    return 0;
+}
+
+static sint32 cc_tile_elements(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    auto statistics = map_get_tile_element_statistics();
+    console.WriteFormatLine("Map elements in use: %u/%u", statistics.Live, statistics.Capacity);
+    console.WriteFormatLine("Dead map elements between tiles: %u", statistics.Dead);
+    console.WriteFormatLine("Free map elements at the end: %u", statistics.Free);
+    console.WriteFormatLine("Blocks added past saved games: %u", statistics.Blocks);
+    console.WriteFormatLine("Elements inserted where their tile is: %u", statistics.InPlaceInserts);
+    console.WriteFormatLine("Tiles moved to insert an element: %u", statistics.Relocations);
+    console.WriteFormatLine("Tiles moved down by compaction: %u", statistics.CompactedTiles);
+    return 0;
+}
+
+static sint32 cc_spatial_index(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    auto statistics = sprite_spatial_index_get_statistics();
+    console.WriteFormatLine("Sprites taken out of a tile: %u", statistics.Unlinks);
+    console.WriteFormatLine("Tiles walked to find the sprite: %u", statistics.Walks);
+    console.WriteFormatLine("Tiles with sprites: %u", statistics.Buckets);
+    console.WriteFormatLine("Most sprites on a tile: %u", statistics.LongestChain);
+    return 0;
+}
+
+static sint32 cc_paint_structs(InteractiveConsole &console, [[maybe_unused]] const utf8 **argv, [[maybe_unused]] sint32 argc)
+{
+    auto statistics = paint_get_statistics();
+    console.WriteFormatLine("Paint sessions last frame: %u", statistics.Sessions);
+    console.WriteFormatLine("Paint structs last frame: %u", statistics.Entries);
+    console.WriteFormatLine("Most paint structs in a session: %u", statistics.MaxSessionEntries);
+    console.WriteFormatLine("Paint structs reserved: %u", statistics.Capacity);
+    return 0;
+}
+
 using console_command_func = sint32 (*)(InteractiveConsole &console, const utf8 ** argv, sint32 argc);
 struct console_command {
     const utf8 * command;
@@ -1061,6 +1325,8 @@ static constexpr const utf8* console_variable_table[] = {
     "window_limit",
     "render_weather_effects",
     "render_weather_gloom",
+    "zoomed_sprite_cache_size",
+    "pathfinding_graph_search",
     "cheat_sandbox_mode",
     "cheat_disable_clearance_checks",
     "cheat_disable_support_limits",
@@ -1099,7 +1365,45 @@ static constexpr const console_command console_command_table[] = {
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences"},
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
-    { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."}
+    { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."},
+    { "profiler", cc_profiler, "Records frame timings. dump writes a Chrome trace event file covering the last\n"
+                               "few seconds (default 10, at most 30).",
+                               "profiler [start|stop|summary [seconds]|dump <path> [seconds]]" },
+    { "sprite_cache", cc_sprite_cache, "Shows the statistics of the cache of sprites sampled for zoomed out views,\n"
+                                       "or clears it. Its size in MiB is set by zoomed_sprite_cache_size.",
+                                       "sprite_cache [clear]" },
+    { "footpath_graph", cc_footpath_graph, "Shows the statistics of the footpath navigation graph used by the pathfinding,\n"
+                                           "or clears it.",
+                                           "footpath_graph [clear]" },
+    { "flow_fields", cc_flow_fields, "Shows the statistics of the cache of walks to the goals guests share,\n"
+                                     "or clears it.",
+                                     "flow_fields [clear]" },
+    { "ride_proximity", cc_ride_proximity, "Shows the statistics of the index of the rides near each part of the map,\n"
+                                           "which guests look up when choosing a ride, or clears it.",
+                                           "ride_proximity [clear]" },
+    { "ambience", cc_ambience, "Shows the statistics of the counts of scenery, fountains and broken path items\n"
+                               "guests take in when thinking about their surroundings, or clears them.",
+                               "ambience [clear]" },
+    { "guest_think", cc_guest_think, "Shows how many of the ways guests searched for on the think threads\n"
+                                     "were used. The threads are set with guest_think_threads in config.ini.",
+                                     "guest_think" },
+    { "guest_store", cc_guest_store, "Shows the statistics of the copies of the guest fields read when counting\n"
+                                     "guests for the park rating, crowd noise and guest list, or clears them.",
+                                     "guest_store [clear]" },
+    { "footpath_connectivity", cc_footpath_connectivity, "Shows the statistics of the labels of the path that can reach the map edge,\n"
+                                                         "which the scenario editor checks the park entrances with.",
+                                                         "footpath_connectivity" },
+    { "staff_jobs", cc_staff_jobs, "Shows the statistics of the jobs handymen look for on the tiles they patrol\n"
+                                   "and of the mechanics rides call for, or clears them.",
+                                   "staff_jobs [clear]" },
+    { "sprite_memory", cc_sprite_memory, "Shows the number of sprites of each type and the memory they take. The\n"
+                                         "store grows up to max_sprites in config.ini when not in a network game.",
+                                         "sprite_memory" },
+    { "spatial_index", cc_spatial_index, "Shows the statistics of the index of the sprites on each tile.", "spatial_index" },
+    { "tile_elements", cc_tile_elements, "Shows how the map elements are stored and how fragmented they are.", "tile_elements" },
+    { "paint_structs", cc_paint_structs, "Shows how many paint structs the viewports used last frame and how many\n"
+                                         "are kept for the next.",
+                                         "paint_structs" }
 };
 // clang-format on
 
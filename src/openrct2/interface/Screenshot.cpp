@@ -7,14 +7,23 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "../audio/audio.h"
 #include "../Context.h"
+#include "../config/Config.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
 #include "../core/Imaging.h"
+#include "../core/Json.hpp"
+#include "../core/Math.hpp"
+#include "../core/String.hpp"
+#include "../core/Util.hpp"
 #include "../OpenRCT2.h"
 #include "Screenshot.h"
 
@@ -34,6 +43,9 @@ using namespace OpenRCT2;
 
 uint8 gScreenshotCountdown = 0;
 
+// Number of rows rendered at a time when streaming a viewport to a file
+static constexpr sint32 DEFAULT_SCREENSHOT_BAND_SIZE = 256;
+
 static bool WriteDpiToFile(const std::string_view& path, const rct_drawpixelinfo * dpi, const rct_palette& palette)
 {
     auto const pixels8 = dpi->bits;
@@ -57,6 +69,38 @@ static bool WriteDpiToFile(const std::string_view& path, const rct_drawpixelinfo
     }
 }
 
+/**
+ * Renders the viewport in horizontal bands and streams them to a PNG, so that memory use is bounded by the
+ * band size rather than the size of the image.
+ */
+static bool WriteViewportToFile(const std::string_view& path, rct_viewport * viewport, sint32 bandSize, const rct_palette& palette)
+{
+    try
+    {
+        Imaging::WriteToFileBanded(path, viewport->width, viewport->height, palette, bandSize,
+            [viewport](uint8 * pixels, uint32 y, uint32 height)
+            {
+                rct_drawpixelinfo dpi;
+                dpi.x = 0;
+                dpi.y = y;
+                dpi.width = viewport->width;
+                dpi.height = height;
+                dpi.pitch = 0;
+                dpi.zoom_level = 0;
+                dpi.bits = pixels;
+                std::fill_n(pixels, dpi.width * dpi.height, 0);
+
+                viewport_render(&dpi, viewport, 0, y, viewport->width, y + height);
+            });
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write png: %s", e.what());
+        return false;
+    }
+}
+
 /**
  *
  *  rct2: 0x006E3AEC
@@ -270,17 +314,6 @@ void screenshot_giant()
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
 
-    rct_drawpixelinfo dpi;
-    dpi.x = 0;
-    dpi.y = 0;
-    dpi.width = resolutionWidth;
-    dpi.height = resolutionHeight;
-    dpi.pitch = 0;
-    dpi.zoom_level = 0;
-    dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
-    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
     // Get a free screenshot path
     char path[MAX_PATH];
     if (screenshot_get_next_path(path, MAX_PATH) == -1) {
@@ -292,9 +325,11 @@ void screenshot_giant()
     rct_palette renderedPalette;
     screenshot_get_rendered_palette(&renderedPalette);
 
-    WriteDpiToFile(path, &dpi, renderedPalette);
-
-    free(dpi.bits);
+    if (!WriteViewportToFile(path, &viewport, DEFAULT_SCREENSHOT_BAND_SIZE, renderedPalette))
+    {
+        context_show_error(STR_SCREENSHOT_FAILED, STR_NONE);
+        return;
+    }
 
     // Show user that screenshot saved successfully
     set_format_arg(0, rct_string_id, STR_STRING);
@@ -302,105 +337,356 @@ void screenshot_giant()
     context_show_error(STR_SCREENSHOT_SAVED_AS, STR_NONE);
 }
 
-static void benchgfx_render_screenshots(const char *inputPath, std::unique_ptr<IContext>& context, uint32 iterationCount)
+struct BenchGfxSize
 {
-    if (!context->LoadParkFromFile(inputPath))
-    {
-       return;
-    }
+    std::string Name;
+    sint32 Width = 0;   // 0 for the whole map
+    sint32 Height = 0;
+};
 
-    gIntroState = INTRO_STATE_NONE;
-    gScreenFlags = SCREEN_FLAGS_PLAYING;
-
-    sint32 mapSize = gMapSize;
-    sint32 resolutionWidth = (mapSize * 32 * 2);
-    sint32 resolutionHeight = (mapSize * 32 * 1);
-
-    resolutionWidth += 8;
-    resolutionHeight += 128;
+struct BenchGfxResult
+{
+    std::string Size;
+    sint32 Width = 0;
+    sint32 Height = 0;
+    sint32 Zoom = 0;
+    sint32 Rotation = 0;
 
-    rct_viewport viewport;
-    viewport.x = 0;
-    viewport.y = 0;
-    viewport.width = resolutionWidth;
-    viewport.height = resolutionHeight;
-    viewport.view_width = viewport.width;
-    viewport.view_height = viewport.height;
-    viewport.var_11 = 0;
-    viewport.flags = 0;
+    // Milliseconds per iteration for the whole render followed by each paint stage, sorted ascending
+    std::vector<double> Samples[1 + VIEWPORT_PAINT_STAGE_COUNT];
+};
 
-    sint32 customX = (gMapSize / 2) * 32 + 16;
-    sint32 customY = (gMapSize / 2) * 32 + 16;
+static constexpr const char * BenchGfxMetricNames[1 + VIEWPORT_PAINT_STAGE_COUNT] =
+{
+    "total",
+    "generate",
+    "arrange",
+    "draw",
+    "weather_gloom",
+    "money_effects",
+};
+
+static std::vector<BenchGfxSize> benchgfx_parse_sizes(const char * sizes)
+{
+    std::vector<BenchGfxSize> result;
+    for (const auto& token : String::Split(sizes, ","))
+    {
+        BenchGfxSize size;
+        size.Name = String::Trim(token);
+        if (size.Name != "map")
+        {
+            if (std::sscanf(size.Name.c_str(), "%dx%d", &size.Width, &size.Height) != 2 || size.Width <= 0 || size.Height <= 0)
+            {
+                throw std::invalid_argument("Invalid size '" + size.Name + "', expected <width>x<height> or map.");
+            }
+        }
+        result.push_back(size);
+    }
+    return result;
+}
 
+/**
+ * Sets up a viewport centred on the middle of the map, as seen from the given rotation.
+ */
+static void benchgfx_setup_viewport(rct_viewport * viewport, sint32 width, sint32 height, sint32 zoom, sint32 rotation)
+{
+    viewport->x = 0;
+    viewport->y = 0;
+    viewport->width = width;
+    viewport->height = height;
+    viewport->view_width = width;
+    viewport->view_height = height;
+    viewport->var_11 = 0;
+    viewport->flags = 0;
+
+    sint32 centreX = (gMapSize / 2) * 32 + 16;
+    sint32 centreY = (gMapSize / 2) * 32 + 16;
+    sint32 z = tile_element_height(centreX, centreY) & 0xFFFF;
     sint32 x = 0, y = 0;
-    sint32 z = tile_element_height(customX, customY) & 0xFFFF;
-    x = customY - customX;
-    y = ((customX + customY) / 2) - z;
+    switch (rotation) {
+    case 0:
+        x = centreY - centreX;
+        y = ((centreX + centreY) / 2) - z;
+        break;
+    case 1:
+        x = -centreY - centreX;
+        y = ((-centreX + centreY) / 2) - z;
+        break;
+    case 2:
+        x = -centreY + centreX;
+        y = ((-centreX - centreY) / 2) - z;
+        break;
+    case 3:
+        x = centreY + centreX;
+        y = ((centreX - centreY) / 2) - z;
+        break;
+    }
 
-    viewport.view_x = x - ((viewport.view_width) / 2);
-    viewport.view_y = y - ((viewport.view_height) / 2);
-    viewport.zoom = 0;
-    gCurrentRotation = 0;
+    viewport->view_x = x - ((viewport->view_width << zoom) / 2);
+    viewport->view_y = y - ((viewport->view_height << zoom) / 2);
+    viewport->zoom = zoom;
+    gCurrentRotation = rotation;
 
     // Ensure sprites appear regardless of rotation
     reset_all_sprite_quadrant_placements();
+}
+
+static BenchGfxResult benchgfx_run(const BenchGfxSize& size, sint32 zoom, sint32 rotation, sint32 warmupCount, sint32 iterationCount)
+{
+    BenchGfxResult result;
+    result.Size = size.Name;
+    result.Width = size.Width;
+    result.Height = size.Height;
+    result.Zoom = zoom;
+    result.Rotation = rotation;
+    if (size.Width == 0)
+    {
+        result.Width = ((gMapSize * 32 * 2) >> zoom) + 8;
+        result.Height = ((gMapSize * 32 * 1) >> zoom) + 128;
+    }
+
+    rct_viewport viewport;
+    benchgfx_setup_viewport(&viewport, result.Width, result.Height, zoom, rotation);
 
+    std::vector<uint8> pixels(result.Width * result.Height);
     rct_drawpixelinfo dpi;
     dpi.x = 0;
     dpi.y = 0;
-    dpi.width = resolutionWidth;
-    dpi.height = resolutionHeight;
+    dpi.width = result.Width;
+    dpi.height = result.Height;
     dpi.pitch = 0;
-    dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
+    dpi.zoom_level = 0;
+    dpi.bits = pixels.data();
+
+    for (sint32 i = 0; i < warmupCount; i++)
+    {
+        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+    }
 
-    auto startTime = std::chrono::high_resolution_clock::now();
-    for (uint32 i = 0; i < iterationCount; i++)
+    viewport_paint_timings timings;
+    viewport_set_paint_timings(&timings);
+    for (sint32 i = 0; i < iterationCount; i++)
     {
-        // Render at various zoom levels
-        dpi.zoom_level = i & 3;
+        for (auto& stage : timings.Stages)
+        {
+            stage = 0;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
         viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+        std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+
+        result.Samples[0].push_back(duration.count());
+        for (sint32 stage = 0; stage < VIEWPORT_PAINT_STAGE_COUNT; stage++)
+        {
+            result.Samples[1 + stage].push_back(timings.Stages[stage] / 1000000.0);
+        }
     }
-    auto endTime = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<float> duration = endTime - startTime;
-    char engine_name[128];
-    rct_string_id engine_id = DrawingEngineStringIds[drawing_engine_get_type()];
-    format_string(engine_name, sizeof(engine_name), engine_id, nullptr);
-    Console::WriteLine("Rendering %d times with drawing engine %s took %.2f seconds.",
-        iterationCount, engine_name,
-        duration.count());
+    viewport_set_paint_timings(nullptr);
 
-    free(dpi.bits);
+    for (auto& samples : result.Samples)
+    {
+        std::sort(samples.begin(), samples.end());
+    }
+    return result;
+}
+
+static std::string benchgfx_format_csv(const std::vector<BenchGfxResult>& results)
+{
+    std::string csv = "size,width,height,zoom,rotation,stage,min_ms,median_ms,p95_ms\n";
+    for (const auto& result : results)
+    {
+        for (size_t i = 0; i < Util::CountOf(result.Samples); i++)
+        {
+            const auto& samples = result.Samples[i];
+            csv += String::StdFormat("%s,%d,%d,%d,%d,%s,%.4f,%.4f,%.4f\n",
+                result.Size.c_str(), result.Width, result.Height, result.Zoom, result.Rotation, BenchGfxMetricNames[i],
+                Math::Percentile(samples, 0), Math::Percentile(samples, 50), Math::Percentile(samples, 95));
+        }
+    }
+    return csv;
+}
+
+static json_t * benchgfx_format_json(const std::vector<BenchGfxResult>& results, const char * parkPath, sint32 warmupCount, sint32 iterationCount)
+{
+    json_t * jsonResults = json_array();
+    for (const auto& result : results)
+    {
+        json_t * jsonStages = json_object();
+        for (size_t i = 0; i < Util::CountOf(result.Samples); i++)
+        {
+            const auto& samples = result.Samples[i];
+            json_t * jsonStage = json_object();
+            json_object_set_new(jsonStage, "min_ms", json_real(Math::Percentile(samples, 0)));
+            json_object_set_new(jsonStage, "median_ms", json_real(Math::Percentile(samples, 50)));
+            json_object_set_new(jsonStage, "p95_ms", json_real(Math::Percentile(samples, 95)));
+            json_object_set_new(jsonStages, BenchGfxMetricNames[i], jsonStage);
+        }
+
+        json_t * jsonResult = json_object();
+        json_object_set_new(jsonResult, "size", json_string(result.Size.c_str()));
+        json_object_set_new(jsonResult, "width", json_integer(result.Width));
+        json_object_set_new(jsonResult, "height", json_integer(result.Height));
+        json_object_set_new(jsonResult, "zoom", json_integer(result.Zoom));
+        json_object_set_new(jsonResult, "rotation", json_integer(result.Rotation));
+        json_object_set_new(jsonResult, "stages", jsonStages);
+        json_array_append_new(jsonResults, jsonResult);
+    }
+
+    json_t * json = json_object();
+    json_object_set_new(json, "park", json_string(parkPath));
+    json_object_set_new(json, "warmup", json_integer(warmupCount));
+    json_object_set_new(json, "iterations", json_integer(iterationCount));
+    json_object_set_new(json, "paint_threads", json_integer(gConfigGeneral.paint_threads));
+    json_object_set_new(json, "results", jsonResults);
+    return json;
+}
+
+static void benchgfx_print_summary(const std::vector<BenchGfxResult>& results)
+{
+    char engineName[128];
+    rct_string_id engineId = DrawingEngineStringIds[drawing_engine_get_type()];
+    format_string(engineName, sizeof(engineName), engineId, nullptr);
+    Console::WriteLine("Drawing engine: %s, median milliseconds per frame (p95 in brackets)", engineName);
+    Console::WriteLine("%-12s %4s %3s %17s %17s %17s %17s %17s %17s", "size", "zoom", "rot",
+        BenchGfxMetricNames[0], BenchGfxMetricNames[1], BenchGfxMetricNames[2], BenchGfxMetricNames[3],
+        BenchGfxMetricNames[4], BenchGfxMetricNames[5]);
+    for (const auto& result : results)
+    {
+        std::string line = String::StdFormat("%-12s %4d %3d", result.Size.c_str(), result.Zoom, result.Rotation);
+        for (const auto& samples : result.Samples)
+        {
+            auto cell = String::StdFormat("%.2f (%.2f)", Math::Percentile(samples, 50), Math::Percentile(samples, 95));
+            line += String::StdFormat(" %17s", cell.c_str());
+        }
+        Console::WriteLine("%s", line.c_str());
+    }
+}
+
+static bool benchgfx_render_screenshots(const char * inputPath, std::unique_ptr<IContext>& context, sint32 iterationCount, const BenchGfxOptions * options)
+{
+    if (!context->LoadParkFromFile(inputPath))
+    {
+        return false;
+    }
+
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    std::vector<BenchGfxSize> sizes;
+    try
+    {
+        sizes = benchgfx_parse_sizes(options->sizes != nullptr ? options->sizes : "1920x1080,map");
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return false;
+    }
+
+    std::vector<BenchGfxResult> results;
+    for (const auto& size : sizes)
+    {
+        for (sint32 zoom = 0; zoom < 4; zoom++)
+        {
+            for (sint32 rotation = 0; rotation < 4; rotation++)
+            {
+                results.push_back(benchgfx_run(size, zoom, rotation, options->warmup, iterationCount));
+            }
+        }
+    }
+
+    std::string format = options->format != nullptr ? options->format : "text";
+    if (format == "json")
+    {
+        json_t * json = benchgfx_format_json(results, inputPath, options->warmup, iterationCount);
+        if (options->output != nullptr)
+        {
+            Json::WriteToFile(options->output, json, JSON_INDENT(2) | JSON_PRESERVE_ORDER);
+        }
+        else
+        {
+            char * text = json_dumps(json, JSON_INDENT(2) | JSON_PRESERVE_ORDER);
+            Console::WriteLine("%s", text);
+            free(text);
+        }
+        json_decref(json);
+    }
+    else if (format == "csv")
+    {
+        auto csv = benchgfx_format_csv(results);
+        if (options->output != nullptr)
+        {
+            File::WriteAllBytes(options->output, csv.data(), csv.size());
+        }
+        else
+        {
+            Console::Write(csv.c_str());
+        }
+    }
+    else
+    {
+        benchgfx_print_summary(results);
+    }
+    return true;
 }
 
-sint32 cmdline_for_gfxbench(const char **argv, sint32 argc)
+sint32 cmdline_for_gfxbench(const char **argv, sint32 argc, BenchGfxOptions * options)
 {
+    // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
+    for (sint32 i = 0; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            argc = i;
+            break;
+        }
+    }
+
     if (argc != 1 && argc != 2) {
         printf("Usage: openrct2 benchgfx <file> [<iteration_count>]\n");
         return -1;
     }
 
+    if (options->format != nullptr && !String::Equals(options->format, "text") && !String::Equals(options->format, "json") && !String::Equals(options->format, "csv"))
+    {
+        printf("Format can only be text, json or csv.\n");
+        return -1;
+    }
+
     core_init();
     sint32 iterationCount = 40;
     if (argc == 2)
     {
-        iterationCount = atoi(argv[1]);
+        iterationCount = std::max(1, atoi(argv[1]));
     }
 
     const char *inputPath = argv[0];
 
     gOpenRCT2Headless = true;
 
+    sint32 result = -1;
     std::unique_ptr<IContext> context(CreateContext());
     if (context->Initialise())
     {
         drawing_engine_init();
 
-        benchgfx_render_screenshots(inputPath, context, iterationCount);
+        try
+        {
+            if (benchgfx_render_screenshots(inputPath, context, iterationCount, options))
+            {
+                result = 1;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("%s", e.what());
+        }
 
         drawing_engine_dispose();
     }
 
-    return 1;
+    return result;
 }
 
 sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOptions * options)
@@ -557,18 +843,17 @@ sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOption
             climate_force_weather(customWeather);
         }
 
+        if (options->band_size < 0)
+        {
+            std::printf("Band size can not be negative.\n");
+            drawing_engine_dispose();
+            return -1;
+        }
+        sint32 bandSize = options->band_size != 0 ? options->band_size : DEFAULT_SCREENSHOT_BAND_SIZE;
+
         // Ensure sprites appear regardless of rotation
         reset_all_sprite_quadrant_placements();
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.zoom_level = 0;
-        dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
-
         if (options->hide_guests)
         {
             viewport.flags |= VIEWPORT_FLAG_INVISIBLE_PEEPS;
@@ -604,14 +889,11 @@ sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOption
             game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_REMOVELITTER, 0, GAME_COMMAND_CHEAT, 0, 0);
         }
 
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
         rct_palette renderedPalette;
         screenshot_get_rendered_palette(&renderedPalette);
 
-        WriteDpiToFile(outputPath, &dpi, renderedPalette);
+        WriteViewportToFile(outputPath, &viewport, bandSize, renderedPalette);
 
-        free(dpi.bits);
         drawing_engine_dispose();
     }
     return 1;
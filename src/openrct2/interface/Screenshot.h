@@ -26,6 +26,15 @@ struct ScreenshotOptions
     bool fix_vandalism = false;
     bool remove_litter = false;
     bool tidy_up_park  = false;
+    sint32 band_size   = 0;
+};
+
+struct BenchGfxOptions
+{
+    sint32 warmup = 2;
+    utf8 * sizes  = nullptr;
+    utf8 * format = nullptr;
+    utf8 * output = nullptr;
 };
 
 void screenshot_check();
@@ -35,5 +44,5 @@ sint32 screenshot_dump_png_32bpp(sint32 width, sint32 height, const void *pixels
 
 void screenshot_giant();
 sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOptions * options);
-sint32 cmdline_for_gfxbench(const char **argv, sint32 argc);
+sint32 cmdline_for_gfxbench(const char **argv, sint32 argc, BenchGfxOptions * options);
 
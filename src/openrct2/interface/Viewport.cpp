@@ -8,12 +8,18 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
+#include "../core/Profiler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
 #include "../Game.h"
 #include "../Input.h"
 #include "../OpenRCT2.h"
@@ -61,8 +67,17 @@ static sint16 _interactionMapX;
 static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 
+static std::vector<rct_drawpixelinfo> _paintColumns;
+static std::unique_ptr<JobPool> _paintJobs;
+static viewport_paint_timings * _paintTimings = nullptr;
+
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
+static void viewport_paint_columns_parallel(JobPool * jobs, uint32 viewFlags);
+static void viewport_paint_column_background(rct_drawpixelinfo * dpi, uint32 viewFlags);
+static void viewport_paint_column_overlays(rct_drawpixelinfo * dpi, const paint_session * session, uint32 viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
+static uint64 viewport_paint_stage_begin();
+static void viewport_paint_stage_end(VIEWPORT_PAINT_STAGE stage, uint64 startTime);
 
 /**
  * This is not a viewport function. It is used to setup many variables for
@@ -786,6 +801,7 @@ void viewport_render(rct_drawpixelinfo *dpi, rct_viewport *viewport, sint32 left
     top += viewport->view_y;
     bottom += viewport->view_y;
 
+    Profiler::Scope profilerScope("viewport_render");
     viewport_paint(viewport, dpi, left, top, right, bottom);
 
 #ifdef DEBUG_SHOW_DIRTY_BOX
@@ -842,6 +858,7 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
     sint16 rightBorder = dpi1.x + dpi1.width;
 
     // Splits the area into 32 pixel columns and renders them
+    _paintColumns.clear();
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32) {
         rct_drawpixelinfo dpi2 = dpi1;
         if (x >= dpi2.x) {
@@ -860,14 +877,133 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags);
+        _paintColumns.push_back(dpi2);
+    }
+
+    JobPool * jobs = viewport_get_paint_jobs();
+    if (jobs != nullptr && _paintColumns.size() > 1)
+    {
+        viewport_paint_columns_parallel(jobs, viewFlags);
+    }
+    else
+    {
+        for (auto &column : _paintColumns)
+        {
+            viewport_paint_column(&column, viewFlags);
+        }
+    }
+}
+
+/**
+ * Returns the job pool used to generate viewport columns, or nullptr if painting
+ * should be done on the calling thread.
+ */
+JobPool * viewport_get_paint_jobs()
+{
+    sint32 numThreads = gConfigGeneral.paint_threads;
+#ifdef __ENABLE_LIGHTFX__
+    // Light effects are collected into a global list while painting
+    if (lightfx_is_available())
+    {
+        numThreads = 0;
+    }
+#endif
+    if (numThreads <= 1)
+    {
+        _paintJobs = nullptr;
+        return nullptr;
+    }
+
+    size_t maxThreads = Math::Min<size_t>((size_t)numThreads, std::thread::hardware_concurrency());
+    if (_paintJobs == nullptr || _paintJobs->GetThreadCount() != maxThreads)
+    {
+        _paintJobs = std::make_unique<JobPool>(maxThreads);
     }
+    return _paintJobs.get();
 }
 
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
 {
     gCurrentViewportFlags = viewFlags;
 
+    viewport_paint_column_background(dpi, viewFlags);
+
+    paint_session * session = paint_session_alloc(dpi);
+    uint64 startTime = viewport_paint_stage_begin();
+    paint_session_generate(session);
+    viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_GENERATE, startTime);
+
+    startTime = viewport_paint_stage_begin();
+    paint_struct ps = paint_session_arrange(session);
+    viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_ARRANGE, startTime);
+
+    startTime = viewport_paint_stage_begin();
+    paint_draw_structs(dpi, &ps, viewFlags);
+    viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_DRAW, startTime);
+
+    viewport_paint_column_overlays(dpi, session, viewFlags);
+    paint_session_free(session);
+}
+
+/**
+ * Generates and arranges every column on the job pool, then draws them in order on the
+ * calling thread. Columns do not overlap, so the result is identical to painting them
+ * one after another.
+ */
+static void viewport_paint_columns_parallel(JobPool * jobs, uint32 viewFlags)
+{
+    gCurrentViewportFlags = viewFlags;
+
+    size_t numColumns = _paintColumns.size();
+    std::vector<paint_session *> sessions(numColumns);
+    std::vector<paint_struct> arrangedStructs(numColumns);
+    jobs->ParallelFor(numColumns, [&sessions, &arrangedStructs](size_t i)
+    {
+        paint_session * session = paint_session_alloc(&_paintColumns[i]);
+        uint64 startTime = viewport_paint_stage_begin();
+        paint_session_generate(session);
+        viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_GENERATE, startTime);
+
+        startTime = viewport_paint_stage_begin();
+        arrangedStructs[i] = paint_session_arrange(session);
+        viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_ARRANGE, startTime);
+        sessions[i] = session;
+    });
+
+    // The scrolling text cache only holds so many entries, once the columns together set up
+    // more than that, earlier entries may already have been replaced before they are drawn.
+    size_t scrollingTextCount = 0;
+    for (auto session : sessions)
+    {
+        scrollingTextCount += session->ScrollingTextCount;
+    }
+    if (scrollingTextCount > MAX_SCROLLING_TEXT_ENTRIES)
+    {
+        for (auto session : sessions)
+        {
+            paint_session_free(session);
+        }
+        for (auto &column : _paintColumns)
+        {
+            viewport_paint_column(&column, viewFlags);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < numColumns; i++)
+    {
+        rct_drawpixelinfo * dpi = &_paintColumns[i];
+        viewport_paint_column_background(dpi, viewFlags);
+        uint64 startTime = viewport_paint_stage_begin();
+        paint_draw_structs(dpi, &arrangedStructs[i], viewFlags);
+        viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_DRAW, startTime);
+        viewport_paint_column_overlays(dpi, sessions[i], viewFlags);
+        paint_session_free(sessions[i]);
+    }
+}
+
+static void viewport_paint_column_background(rct_drawpixelinfo * dpi, uint32 viewFlags)
+{
     if (viewFlags & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE | VIEWPORT_FLAG_CLIP_VIEW)) {
         uint8 colour = 10;
         if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) {
@@ -875,23 +1011,52 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
         }
         gfx_clear(dpi, colour);
     }
+}
 
-    paint_session * session = paint_session_alloc(dpi);
-    paint_session_generate(session);
-    paint_struct ps = paint_session_arrange(session);
-    paint_draw_structs(dpi, &ps, viewFlags);
-    paint_session_free(session);
-
+static void viewport_paint_column_overlays(rct_drawpixelinfo * dpi, const paint_session * session, uint32 viewFlags)
+{
     if (gConfigGeneral.render_weather_gloom &&
         !gTrackDesignSaveMode &&
         !(viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) &&
         !(viewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES)
     ) {
+        uint64 startTime = viewport_paint_stage_begin();
         viewport_paint_weather_gloom(dpi);
+        viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_WEATHER_GLOOM, startTime);
     }
 
     if (session->PSStringHead != nullptr) {
+        uint64 startTime = viewport_paint_stage_begin();
         paint_draw_money_structs(dpi, session->PSStringHead);
+        viewport_paint_stage_end(VIEWPORT_PAINT_STAGE_MONEY_EFFECTS, startTime);
+    }
+}
+
+/**
+ * Starts collecting per-stage paint timings into the given counters, or stops when timings is nullptr.
+ */
+void viewport_set_paint_timings(viewport_paint_timings * timings)
+{
+    _paintTimings = timings;
+}
+
+static uint64 viewport_paint_stage_begin()
+{
+    if (_paintTimings == nullptr)
+    {
+        return 0;
+    }
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static void viewport_paint_stage_end(VIEWPORT_PAINT_STAGE stage, uint64 startTime)
+{
+    if (_paintTimings != nullptr)
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        uint64 endTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        _paintTimings->Stages[stage] += endTime - startTime;
     }
 }
 
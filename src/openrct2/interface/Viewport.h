@@ -10,9 +10,11 @@
 #ifndef _VIEWPORT_H_
 #define _VIEWPORT_H_
 
+#include <atomic>
 #include "Window.h"
 #include "../world/Location.hpp"
 
+class JobPool;
 struct paint_session;
 struct paint_struct;
 struct rct_drawpixelinfo;
@@ -123,6 +125,28 @@ void viewport_update_smart_staff_follow(rct_window * window, rct_peep * peep);
 void viewport_update_smart_vehicle_follow(rct_window * window);
 void viewport_render(rct_drawpixelinfo *dpi, rct_viewport *viewport, sint32 left, sint32 top, sint32 right, sint32 bottom);
 void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left, sint16 top, sint16 right, sint16 bottom);
+JobPool * viewport_get_paint_jobs();
+
+enum VIEWPORT_PAINT_STAGE
+{
+    VIEWPORT_PAINT_STAGE_GENERATE,
+    VIEWPORT_PAINT_STAGE_ARRANGE,
+    VIEWPORT_PAINT_STAGE_DRAW,
+    VIEWPORT_PAINT_STAGE_WEATHER_GLOOM,
+    VIEWPORT_PAINT_STAGE_MONEY_EFFECTS,
+    VIEWPORT_PAINT_STAGE_COUNT,
+};
+
+/**
+ * Nanoseconds spent in each stage of viewport_paint. Stages run on the paint job pool are summed
+ * across threads.
+ */
+struct viewport_paint_timings
+{
+    std::atomic<uint64> Stages[VIEWPORT_PAINT_STAGE_COUNT] = {};
+};
+
+void viewport_set_paint_timings(viewport_paint_timings * timings);
 
 void viewport_adjust_for_map_height(sint16* x, sint16* y, sint16 *z);
 
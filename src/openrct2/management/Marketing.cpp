@@ -11,6 +11,7 @@
 #include "../core/Util.hpp"
 #include "../Game.h"
 #include "../interface/Window.h"
+#include "../peep/GuestStore.h"
 #include "../localisation/Localisation.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -140,6 +141,7 @@ void marketing_set_guest_campaign(rct_peep * peep, sint32 campaign)
         peep->peep_is_lost_countdown   = 240;
         break;
     }
+    guest_store_update(peep);
 }
 
 bool marketing_is_campaign_type_applicable(sint32 campaignType)
@@ -64,7 +64,9 @@ static sint32 _pickup_peep_old_x = LOCATION_NULL;
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../Cheats.h"
+#include "../world/Map.h"
 #include "../world/Park.h"
+#include "../world/Sprite.h"
 
 #include "NetworkAction.h"
 
@@ -302,6 +304,18 @@ bool Network::BeginClient(const char* host, uint16 port)
 bool Network::BeginServer(uint16 port, const char* address)
 {
     Close();
+    if (sprite_get_capacity() > MAX_SPRITES)
+    {
+        // Clients load the park with the sprites moved into the saved slots
+        Console::Error::WriteLine("Unable to host a park that has grown past %d sprites.", MAX_SPRITES);
+        return false;
+    }
+    map_reorganise_elements();
+    if (map_get_tile_element_statistics().Blocks > 0)
+    {
+        Console::Error::WriteLine("Unable to host a park that has grown past %d map elements.", MAX_TILE_ELEMENTS);
+        return false;
+    }
     if (!Init())
         return false;
 
@@ -35,6 +35,7 @@
 #include "../interface/InteractiveConsole.h"
 #include "../localisation/Localisation.h"
 #include "../management/NewsItem.h"
+#include "../peep/GuestStore.h"
 #include "../peep/Peep.h"
 #include "../platform/platform.h"
 #include "../util/Util.h"
@@ -502,6 +503,9 @@ namespace Twitch
                 }
             }
         }
+
+        // The tracking flags of the guests may have changed
+        guest_store_invalidate();
     }
 
     static char * strskipwhitespace(const char * str)
@@ -8,6 +8,9 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "../config/Config.h"
 #include "../core/Math.hpp"
 #include "../drawing/Drawing.h"
@@ -16,6 +19,7 @@
 #include "../localisation/LocalisationService.h"
 #include "Paint.h"
 #include "sprite/Paint.Sprite.h"
+#include "TilePaintCache.h"
 #include "tile_element/Paint.TileElement.h"
 
 // Globals for paint clipping
@@ -24,7 +28,15 @@ LocationXY8 gClipSelectionA = { 0, 0 };
 LocationXY8 gClipSelectionB = { MAXIMUM_MAP_SIZE_TECHNICAL - 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1 };
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+std::mutex gPaintTextMutex;
+
+// gPaintSession is handed out first so that single threaded painting keeps using it,
+// further sessions are only created when columns are painted on several threads.
+static std::mutex _paintSessionPoolMutex;
+static std::vector<std::unique_ptr<paint_session>> _paintSessionPool;
+static std::vector<paint_session *> _freePaintSessions = { &gPaintSession };
+static paint_statistics _paintStatistics;
+static paint_statistics _paintStatisticsLastFrame;
 
 static constexpr const uint8 BoundBoxDebugColours[] =
 {
@@ -52,17 +64,22 @@ static void paint_attached_ps(rct_drawpixelinfo * dpi, paint_struct * ps, uint32
 static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static void paint_ps_image(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32 viewFlags);
+static bool paint_attach_image_to_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y);
 
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
 {
     session->DPI = dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->PaintEntries.Clear();
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
-    for (auto &quadrant : session->Quadrants)
+
+    // Only the quadrants between the back and front index can have been used by the previous column
+    if (session->QuadrantBackIndex != std::numeric_limits<uint32>::max())
     {
-        quadrant = nullptr;
+        for (uint32 i = session->QuadrantBackIndex; i <= session->QuadrantFrontIndex; i++)
+        {
+            session->Quadrants[i] = nullptr;
+        }
     }
     session->QuadrantBackIndex = std::numeric_limits<uint32>::max();
     session->QuadrantFrontIndex = 0;
@@ -71,12 +88,15 @@ static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->ScrollingTextCount = 0;
+    session->TilePaintRecording = nullptr;
 }
 
 static void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
 {
     uint32 paintQuadrantIndex = Math::Clamp(0, positionHash / 32, MAX_PAINT_QUADRANTS - 1);
     ps->quadrant_index = paintQuadrantIndex;
+    ps->quadrant_flags = 0;
     ps->next_quadrant_ps = session->Quadrants[paintQuadrantIndex];
     session->Quadrants[paintQuadrantIndex] = ps;
 
@@ -90,14 +110,13 @@ static void paint_session_add_ps_to_quadrant(paint_session * session, paint_stru
 static paint_struct * sub_9819_c(
     paint_session * session, uint32 image_id, LocationXYZ16 offset, LocationXYZ16 boundBoxSize, LocationXYZ16 boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
         return nullptr;
     }
 
-    paint_struct * ps = &session->NextFreePaintStruct->basic;
+    paint_struct * ps = &session->PaintEntries.GetNext()->basic;
     ps->image_id = image_id;
 
     switch (session->CurrentRotation)
@@ -437,10 +456,12 @@ paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadr
 }
 
 /**
-*
-*  rct2: 0x00688217
-*/
-paint_struct paint_session_arrange(paint_session * session)
+ * Arranges the paint structs of a session by sorting the linked lists directly.
+ * Kept to verify paint_session_arrange, which must produce the same order.
+ *
+ *  rct2: 0x00688217
+ */
+paint_struct paint_session_arrange_legacy(paint_session * session)
 {
     paint_struct psHead = {};
     paint_struct * ps = &psHead;
@@ -476,6 +497,216 @@ paint_struct paint_session_arrange(paint_session * session)
     return psHead;
 }
 
+template<uint8 _TRotation>
+static bool check_bounding_box(const paint_struct_bound_box& initialBBox, const paint_arrange_buffer& buffer, uint32 node);
+
+template<> bool check_bounding_box<0>(const paint_struct_bound_box& initialBBox, const paint_arrange_buffer& buffer, uint32 node)
+{
+    return initialBBox.z_end >= buffer.Z[node] && initialBBox.y_end >= buffer.Y[node] && initialBBox.x_end >= buffer.X[node]
+        && !(initialBBox.z < buffer.ZEnd[node] && initialBBox.y < buffer.YEnd[node] && initialBBox.x < buffer.XEnd[node]);
+}
+
+template<> bool check_bounding_box<1>(const paint_struct_bound_box& initialBBox, const paint_arrange_buffer& buffer, uint32 node)
+{
+    return initialBBox.z_end >= buffer.Z[node] && initialBBox.y_end >= buffer.Y[node] && initialBBox.x_end < buffer.X[node]
+        && !(initialBBox.z < buffer.ZEnd[node] && initialBBox.y < buffer.YEnd[node] && initialBBox.x >= buffer.XEnd[node]);
+}
+
+template<> bool check_bounding_box<2>(const paint_struct_bound_box& initialBBox, const paint_arrange_buffer& buffer, uint32 node)
+{
+    return initialBBox.z_end >= buffer.Z[node] && initialBBox.y_end < buffer.Y[node] && initialBBox.x_end < buffer.X[node]
+        && !(initialBBox.z < buffer.ZEnd[node] && initialBBox.y >= buffer.YEnd[node] && initialBBox.x >= buffer.XEnd[node]);
+}
+
+template<> bool check_bounding_box<3>(const paint_struct_bound_box& initialBBox, const paint_arrange_buffer& buffer, uint32 node)
+{
+    return initialBBox.z_end >= buffer.Z[node] && initialBBox.y_end < buffer.Y[node] && initialBBox.x_end >= buffer.X[node]
+        && !(initialBBox.z < buffer.ZEnd[node] && initialBBox.y >= buffer.YEnd[node] && initialBBox.x < buffer.XEnd[node]);
+}
+
+/**
+ * Same as paint_arrange_structs_helper_rotation but operating on the packed arrays, node 0 marks the end of the list.
+ */
+template<uint8 _TRotation>
+static uint32 paint_arrange_packed_quadrant(paint_arrange_buffer& buffer, uint32 psNext, uint16 quadrantIndex, uint8 flag)
+{
+    auto& next = buffer.Next;
+    auto& quadrants = buffer.QuadrantIndex;
+    auto& flags = buffer.QuadrantFlags;
+
+    uint32 ps;
+    do
+    {
+        ps = psNext;
+        psNext = next[psNext];
+        if (psNext == 0) return ps;
+    } while (quadrantIndex > quadrants[psNext]);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    uint32 psCache = ps;
+
+    uint32 psTemp = ps;
+    do
+    {
+        ps = next[ps];
+        if (ps == 0) break;
+
+        if (quadrants[ps] > quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (quadrants[ps] == quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (quadrants[ps] == quadrantIndex)
+        {
+            flags[ps] = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (quadrants[ps] <= quadrantIndex + 1);
+    ps = psTemp;
+
+    while (true)
+    {
+        while (true)
+        {
+            psNext = next[ps];
+            if (psNext == 0) return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER) return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_IDENTICAL) break;
+            ps = psNext;
+        }
+
+        flags[psNext] &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        psTemp = ps;
+
+        const paint_struct_bound_box initialBBox =
+        {
+            buffer.X[psNext], buffer.Y[psNext], buffer.Z[psNext],
+            buffer.XEnd[psNext], buffer.YEnd[psNext], buffer.ZEnd[psNext]
+        };
+
+        while (true)
+        {
+            ps = psNext;
+            psNext = next[psNext];
+            if (psNext == 0) break;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER) break;
+            if (!(flags[psNext] & PAINT_QUADRANT_FLAG_NEXT)) continue;
+
+            if (check_bounding_box<_TRotation>(initialBBox, buffer, psNext))
+            {
+                next[ps] = next[psNext];
+                uint32 psTemp2 = next[psTemp];
+                next[psTemp] = psNext;
+                next[psNext] = psTemp2;
+                psNext = ps;
+            }
+        }
+
+        ps = psTemp;
+    }
+}
+
+template<uint8 _TRotation>
+static void paint_arrange_packed(paint_arrange_buffer& buffer, uint32 quadrantBackIndex, uint32 quadrantFrontIndex)
+{
+    uint32 psCache = paint_arrange_packed_quadrant<_TRotation>(buffer, 0, quadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+
+    uint32 quadrantIndex = quadrantBackIndex;
+    while (++quadrantIndex < quadrantFrontIndex)
+    {
+        psCache = paint_arrange_packed_quadrant<_TRotation>(buffer, psCache, quadrantIndex & 0xFFFF, 0);
+    }
+}
+
+static void paint_arrange_buffer_add(paint_arrange_buffer& buffer, paint_struct * ps)
+{
+    buffer.Structs.push_back(ps);
+    buffer.Next.push_back((uint32)buffer.Next.size() + 1);
+    buffer.QuadrantIndex.push_back(ps->quadrant_index);
+    buffer.QuadrantFlags.push_back(ps->quadrant_flags);
+    buffer.X.push_back(ps->bounds.x);
+    buffer.Y.push_back(ps->bounds.y);
+    buffer.Z.push_back(ps->bounds.z);
+    buffer.XEnd.push_back(ps->bounds.x_end);
+    buffer.YEnd.push_back(ps->bounds.y_end);
+    buffer.ZEnd.push_back(ps->bounds.z_end);
+}
+
+static void paint_arrange_buffer_clear(paint_arrange_buffer& buffer)
+{
+    buffer.Structs.clear();
+    buffer.Next.clear();
+    buffer.QuadrantIndex.clear();
+    buffer.QuadrantFlags.clear();
+    buffer.X.clear();
+    buffer.Y.clear();
+    buffer.Z.clear();
+    buffer.XEnd.clear();
+    buffer.YEnd.clear();
+    buffer.ZEnd.clear();
+}
+
+/**
+ * Sorts the paint structs of a session into draw order. The structs are first packed into
+ * contiguous arrays in quadrant order, sorted there and the resulting order is then written
+ * back into the next_quadrant_ps links.
+ *
+ *  rct2: 0x00688217
+ */
+paint_struct paint_session_arrange(paint_session * session)
+{
+    paint_struct psHead = {};
+    if (session->QuadrantBackIndex == UINT32_MAX)
+    {
+        return psHead;
+    }
+
+    // Node 0 is the list head
+    paint_arrange_buffer& buffer = session->ArrangeBuffer;
+    paint_arrange_buffer_clear(buffer);
+    paint_arrange_buffer_add(buffer, &psHead);
+    for (uint32 quadrantIndex = session->QuadrantBackIndex; quadrantIndex <= session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        for (paint_struct * ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            paint_arrange_buffer_add(buffer, ps);
+        }
+    }
+    buffer.Next.back() = 0;
+
+    switch (get_current_rotation())
+    {
+    case 0:
+        paint_arrange_packed<0>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+        break;
+    case 1:
+        paint_arrange_packed<1>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+        break;
+    case 2:
+        paint_arrange_packed<2>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+        break;
+    case 3:
+        paint_arrange_packed<3>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+        break;
+    }
+
+    for (size_t i = 1; i < buffer.Structs.size(); i++)
+    {
+        buffer.Structs[i]->quadrant_flags = buffer.QuadrantFlags[i];
+    }
+
+    paint_struct * ps = &psHead;
+    for (uint32 node = buffer.Next[0]; node != 0; node = buffer.Next[node])
+    {
+        ps->next_quadrant_ps = buffer.Structs[node];
+        ps = ps->next_quadrant_ps;
+    }
+    ps->next_quadrant_ps = nullptr;
+    return psHead;
+}
+
 /**
 *
 *  rct2: 0x00688485
@@ -715,18 +946,56 @@ static void draw_pixel_info_crop_by_zoom(rct_drawpixelinfo *dpi)
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 {
-    // Currently limited to just one session at a time
-    assert(!_paintSessionInUse);
-    _paintSessionInUse = true;
-    paint_session * session = &gPaintSession;
+    paint_session * session;
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+        if (_freePaintSessions.empty())
+        {
+            _paintSessionPool.push_back(std::make_unique<paint_session>());
+            session = _paintSessionPool.back().get();
+        }
+        else
+        {
+            session = _freePaintSessions.back();
+            _freePaintSessions.pop_back();
+        }
+    }
 
     paint_session_init(session, dpi);
     return session;
 }
 
-void paint_session_free([[maybe_unused]] paint_session* session)
+void paint_session_free(paint_session * session)
 {
-    _paintSessionInUse = false;
+    std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+    _freePaintSessions.push_back(session);
+
+    uint32 numEntries = (uint32)session->PaintEntries.GetNumAllocated();
+    _paintStatistics.Sessions++;
+    _paintStatistics.Entries += numEntries;
+    _paintStatistics.MaxSessionEntries = std::max(_paintStatistics.MaxSessionEntries, numEntries);
+}
+
+/**
+ * Returns the paint struct counters of the last completed frame.
+ */
+paint_statistics paint_get_statistics()
+{
+    std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+    paint_statistics result = _paintStatisticsLastFrame;
+    result.Capacity = (uint32)gPaintSession.PaintEntries.GetCapacity();
+    for (const auto &session : _paintSessionPool)
+    {
+        result.Capacity += (uint32)session->PaintEntries.GetCapacity();
+    }
+    return result;
+}
+
+void paint_statistics_next_frame()
+{
+    std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+    _paintStatisticsLastFrame = _paintStatistics;
+    _paintStatistics = {};
 }
 
 /**
@@ -741,7 +1010,7 @@ void paint_session_free([[maybe_unused]] paint_session* session)
 * @param z_offset (dx)
 * @return (ebp) paint_struct on success (CF == 0), nullptr on failure (CF == 1)
 */
-paint_struct * sub_98196C(
+static paint_struct * paint_add_image(
     paint_session * session,
     uint32          image_id,
     sint8           x_offset,
@@ -757,18 +1026,13 @@ paint_struct * sub_98196C(
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return nullptr;
-    }
-
     auto g1Element = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1Element == nullptr)
     {
         return nullptr;
     }
 
-    paint_struct *ps = &session->NextFreePaintStruct->basic;
+    paint_struct *ps = &session->PaintEntries.GetNext()->basic;
     ps->image_id = image_id;
 
     LocationXYZ16 coord_3d =
@@ -874,7 +1138,7 @@ paint_struct * sub_98196C(
     }
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     return ps;
 }
@@ -895,7 +1159,7 @@ paint_struct * sub_98196C(
 * @return (ebp) paint_struct on success (CF == 0), nullptr on failure (CF == 1)
 */
 // Track Pieces, Shops.
-paint_struct * sub_98197C(
+static paint_struct * paint_add_image_as_parent(
     paint_session * session,
     uint32          image_id,
     sint8           x_offset,
@@ -945,7 +1209,7 @@ paint_struct * sub_98197C(
     sint32 positionHash = attach.x + attach.y;
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -965,7 +1229,7 @@ paint_struct * sub_98197C(
 * @param bound_box_offset_z (0x009DEA56)
 * @return (ebp) paint_struct on success (CF == 0), nullptr on failure (CF == 1)
 */
-paint_struct * sub_98198C(
+static paint_struct * paint_add_image_as_orphan(
     paint_session * session,
     uint32          image_id,
     sint8           x_offset,
@@ -994,7 +1258,7 @@ paint_struct * sub_98198C(
     }
 
     session->UnkF1AD28 = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -1014,7 +1278,7 @@ paint_struct * sub_98198C(
 * @param bound_box_offset_z (0x009DEA56)
 * @return (ebp) paint_struct on success (CF == 0), nullptr on failure (CF == 1)
 */
-paint_struct * sub_98199C(
+static paint_struct * paint_add_image_as_child(
     paint_session * session,
     uint32          image_id,
     sint8           x_offset,
@@ -1032,7 +1296,7 @@ paint_struct * sub_98199C(
 
     if (session->UnkF1AD28 == nullptr)
     {
-        return sub_98197C(
+        return paint_add_image_as_parent(
             session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
             bound_box_offset_x, bound_box_offset_y, bound_box_offset_z);
     }
@@ -1051,7 +1315,7 @@ paint_struct * sub_98199C(
     old_ps->var_20 = ps;
 
     session->UnkF1AD28 = ps;
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
     return ps;
 }
 
@@ -1063,18 +1327,14 @@ paint_struct * sub_98199C(
 * @param y (cx)
 * @return (!CF) success
 */
-bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, uint16 x, uint16 y)
+static bool paint_attach_image_to_attach(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
     if (session->UnkF1AD2C == nullptr)
     {
-        return paint_attach_to_previous_ps(session, image_id, x, y);
+        return paint_attach_image_to_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct * ps = &session->PaintEntries.GetNext()->attached;
     ps->image_id = image_id;
     ps->x = x;
     ps->y = y;
@@ -1087,7 +1347,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 
     session->UnkF1AD2C = ps;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     return true;
 }
@@ -1100,13 +1360,9 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 * @param y (cx)
 * @return (!CF) success
 */
-bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
+static bool paint_attach_image_to_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct * ps = &session->PaintEntries.GetNext()->attached;
 
     ps->image_id = image_id;
     ps->x = x;
@@ -1119,7 +1375,7 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
         return false;
     }
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     attached_paint_struct * oldFirstAttached = masterPs->attached_ps;
     masterPs->attached_ps = ps;
@@ -1131,6 +1387,132 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
     return true;
 }
 
+// The primitives used by the tile element and sprite painters. While a tile is being recorded
+// for the tile paint cache each call is recorded with the struct it created.
+
+paint_struct * sub_98196C(
+    paint_session * session,
+    uint32          image_id,
+    sint8           x_offset,
+    sint8           y_offset,
+    sint16          bound_box_length_x,
+    sint16          bound_box_length_y,
+    sint8           bound_box_length_z,
+    sint16          z_offset)
+{
+    paint_struct * ps = paint_add_image(
+        session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_98196C, ps, image_id,
+            { x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset });
+    }
+    return ps;
+}
+
+paint_struct * sub_98197C(
+    paint_session * session,
+    uint32          image_id,
+    sint8           x_offset,
+    sint8           y_offset,
+    sint16          bound_box_length_x,
+    sint16          bound_box_length_y,
+    sint8           bound_box_length_z,
+    sint16          z_offset,
+    sint16          bound_box_offset_x,
+    sint16          bound_box_offset_y,
+    sint16          bound_box_offset_z)
+{
+    paint_struct * ps = paint_add_image_as_parent(
+        session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+        bound_box_offset_x, bound_box_offset_y, bound_box_offset_z);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_98197C, ps, image_id,
+            { x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+              bound_box_offset_x, bound_box_offset_y, bound_box_offset_z });
+    }
+    return ps;
+}
+
+paint_struct * sub_98198C(
+    paint_session * session,
+    uint32          image_id,
+    sint8           x_offset,
+    sint8           y_offset,
+    sint16          bound_box_length_x,
+    sint16          bound_box_length_y,
+    sint8           bound_box_length_z,
+    sint16          z_offset,
+    sint16          bound_box_offset_x,
+    sint16          bound_box_offset_y,
+    sint16          bound_box_offset_z)
+{
+    paint_struct * ps = paint_add_image_as_orphan(
+        session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+        bound_box_offset_x, bound_box_offset_y, bound_box_offset_z);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_98198C, ps, image_id,
+            { x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+              bound_box_offset_x, bound_box_offset_y, bound_box_offset_z });
+    }
+    return ps;
+}
+
+paint_struct * sub_98199C(
+    paint_session * session,
+    uint32          image_id,
+    sint8           x_offset,
+    sint8           y_offset,
+    sint16          bound_box_length_x,
+    sint16          bound_box_length_y,
+    sint8           bound_box_length_z,
+    sint16          z_offset,
+    sint16          bound_box_offset_x,
+    sint16          bound_box_offset_y,
+    sint16          bound_box_offset_z)
+{
+    paint_struct * ps = paint_add_image_as_child(
+        session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+        bound_box_offset_x, bound_box_offset_y, bound_box_offset_z);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_98199C, ps, image_id,
+            { x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
+              bound_box_offset_x, bound_box_offset_y, bound_box_offset_z });
+    }
+    return ps;
+}
+
+bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, uint16 x, uint16 y)
+{
+    bool attached = paint_attach_image_to_attach(session, image_id, x, y);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_ATTACH, attached ? session->UnkF1AD2C : nullptr, image_id,
+            { (sint16)x, (sint16)y });
+    }
+    return attached;
+}
+
+bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
+{
+    bool attached = paint_attach_image_to_ps(session, image_id, x, y);
+    if (session->TilePaintRecording != nullptr)
+    {
+        tile_paint_cache_record_call(
+            session, TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS, attached ? session->UnkF1AD2C : nullptr, image_id,
+            { (sint16)x, (sint16)y });
+    }
+    return attached;
+}
+
 /**
 * rct2: 0x00685EBC, 0x00686046, 0x00685FC8, 0x00685F4A, 0x00685ECC
 * @param amount (eax)
@@ -1143,12 +1525,7 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
 */
 void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return;
-    }
-
-    paint_string_struct * ps = &session->NextFreePaintStruct->string;
+    paint_string_struct * ps = &session->PaintEntries.GetNext()->string;
     ps->string_id = string_id;
     ps->next = nullptr;
     ps->args[0] = amount;
@@ -1168,7 +1545,7 @@ void paint_floating_money_effect(paint_session * session, money32 amount, rct_st
     ps->x = coord.x + offset_x;
     ps->y = coord.y;
 
-    session->NextFreePaintStruct++;
+    session->PaintEntries.Commit();
 
     if (session->LastPSString == nullptr)
     {
@@ -9,12 +9,16 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "../common.h"
 #include "../interface/Colour.h"
 #include "../drawing/Drawing.h"
 #include "../world/Location.hpp"
 
 struct rct_tile_element;
+struct tile_paint_recording;
 
 #pragma pack(push, 1)
 /* size 0x12 */
@@ -125,16 +129,99 @@ struct tunnel_entry {
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT    65
 
+/**
+ * Bump allocator for the paint, attached and string structs of a paint session. Entries are
+ * kept in fixed size chunks so they never move, and the chunks are reused after a clear so a
+ * session only ever holds as much memory as the busiest column it has painted.
+ */
+class PaintEntryPool
+{
+private:
+    static constexpr size_t ChunkSize = 512;
+
+    struct Chunk
+    {
+        paint_entry Entries[ChunkSize];
+    };
+
+    std::vector<std::unique_ptr<Chunk>> _chunks;
+    size_t                              _currentChunk = 0;
+    paint_entry *                       _next = nullptr;
+    paint_entry *                       _end = nullptr;
+
+public:
+    void Clear()
+    {
+        SetChunk(0);
+    }
+
+    /**
+     * Returns the next free entry, it only becomes allocated once Commit is called.
+     */
+    paint_entry * GetNext() const
+    {
+        return _next;
+    }
+
+    void Commit()
+    {
+        if (++_next == _end)
+        {
+            SetChunk(_currentChunk + 1);
+        }
+    }
+
+    size_t GetNumAllocated() const
+    {
+        return _chunks.empty() ? 0 : (_currentChunk * ChunkSize) + (_next - _chunks[_currentChunk]->Entries);
+    }
+
+    size_t GetCapacity() const
+    {
+        return _chunks.size() * ChunkSize;
+    }
+
+private:
+    void SetChunk(size_t index)
+    {
+        if (index == _chunks.size())
+        {
+            _chunks.push_back(std::make_unique<Chunk>());
+        }
+        _currentChunk = index;
+        _next = _chunks[index]->Entries;
+        _end = _next + ChunkSize;
+    }
+};
+
+/**
+ * Packed copy of the paint structs of a session used while arranging them. The list links,
+ * quadrant data and bounding boxes are stored as separate contiguous arrays indexed by node,
+ * node 0 being the list head.
+ */
+struct paint_arrange_buffer
+{
+    std::vector<paint_struct *> Structs;
+    std::vector<uint32>         Next;
+    std::vector<uint16>         QuadrantIndex;
+    std::vector<uint8>          QuadrantFlags;
+    std::vector<uint16>         X;
+    std::vector<uint16>         Y;
+    std::vector<uint16>         Z;
+    std::vector<uint16>         XEnd;
+    std::vector<uint16>         YEnd;
+    std::vector<uint16>         ZEnd;
+};
+
 struct paint_session
 {
     rct_drawpixelinfo *      DPI;
-    paint_entry              PaintStructs[4000];
+    PaintEntryPool           PaintEntries;
+    paint_arrange_buffer     ArrangeBuffer;
     paint_struct *           Quadrants[MAX_PAINT_QUADRANTS];
     uint32                   QuadrantBackIndex;
     uint32                   QuadrantFrontIndex;
     const void *             CurrentlyDrawnItem;
-    paint_entry *            EndOfPaintStructArray;
-    paint_entry *            NextFreePaintStruct;
     LocationXY16             SpritePosition;
     paint_struct             UnkF1A4CC;
     paint_struct *           UnkF1AD28;
@@ -159,10 +246,24 @@ struct paint_session
     uint8                    Unk141E9DB;
     uint16                   WaterHeight;
     uint32                   TrackColours[4];
+    uint16                   ScrollingTextCount;
+    tile_paint_recording *   TilePaintRecording;
 };
 
 extern paint_session gPaintSession;
 
+struct paint_statistics
+{
+    uint32 Sessions;            // Paint sessions used
+    uint32 Entries;             // Paint, attached and string structs allocated
+    uint32 MaxSessionEntries;   // Most structs allocated by a single session
+    uint32 Capacity;            // Structs reserved by all pooled sessions
+};
+
+// Text formatting and the scrolling text cache are global state, painters that
+// set up signs or banners hold this so that columns can be generated on several threads.
+extern std::mutex gPaintTextMutex;
+
 // Globals for paint clipping
 extern uint8 gClipHeight;
 extern LocationXY8 gClipSelectionA;
@@ -233,8 +334,11 @@ void paint_floating_money_effect(paint_session * session, money32 amount, rct_st
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi);
 void paint_session_free(paint_session *);
+paint_statistics paint_get_statistics();
+void paint_statistics_next_frame();
 void paint_session_generate(paint_session * session);
 paint_struct paint_session_arrange(paint_session * session);
+paint_struct paint_session_arrange_legacy(paint_session * session);
 paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation);
 void paint_draw_structs(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
 void paint_draw_money_structs(rct_drawpixelinfo * dpi, paint_string_struct * ps);
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include "../config/Config.h"
+#include "../core/Profiler.h"
 #include "../drawing/IDrawingEngine.h"
 #include "../OpenRCT2.h"
 #include "../title/TitleScreen.h"
@@ -21,6 +22,7 @@
 #include "../Intro.h"
 #include "../localisation/Language.h"
 #include "../localisation/FormatCodes.h"
+#include "Paint.h"
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Drawing;
@@ -34,6 +36,7 @@ Painter::Painter(const std::shared_ptr<IUiContext>& uiContext)
 
 void Painter::Paint(IDrawingEngine& de)
 {
+    Profiler::Scope profilerScope("Painter::Paint");
     auto dpi = de.GetDrawingPixelInfo();
     if (gIntroState != INTRO_STATE_NONE)
     {
@@ -41,7 +44,10 @@ void Painter::Paint(IDrawingEngine& de)
     }
     else
     {
-        de.PaintWindows();
+        {
+            Profiler::Scope windowsScope("IDrawingEngine::PaintWindows");
+            de.PaintWindows();
+        }
 
         update_palette_effects();
         _uiContext->Draw(dpi);
@@ -61,6 +67,7 @@ void Painter::Paint(IDrawingEngine& de)
     {
         PaintFPS(dpi);
     }
+    paint_statistics_next_frame();
     gCurrentDrawCount++;
 }
 
@@ -0,0 +1,446 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "../config/Config.h"
+#include "../drawing/LightFX.h"
+#include "../interface/Viewport.h"
+#include "../OpenRCT2.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Footpath.h"
+#include "../world/LargeScenery.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/Sprite.h"
+#include "tile_element/Paint.TileElement.h"
+#include "Paint.h"
+#include "TilePaintCache.h"
+
+/**
+ * The paint calls of a tile for one rotation, zoom level and set of view flags. The elements of
+ * the tile are kept so that elements changed in place (grass growth, vandalised path additions,
+ * ghosts turning into real elements) are detected without any explicit invalidation.
+ */
+struct tile_paint_cache_entry
+{
+    uint32                        ViewKey;
+    uint32                        Generation;
+    bool                          Cacheable;
+    std::vector<rct_tile_element> Elements;
+    std::vector<tile_paint_call>  Calls;
+};
+
+// The cache is cleared once it holds this many entries, which is four views (rotations, zoom
+// levels or sets of view flags) of every tile of a 256x256 map.
+constexpr size_t MAX_TILE_PAINT_CACHE_ENTRIES = MAX_TILE_TILE_ELEMENT_POINTERS * 4;
+
+static bool _enabled = true;
+static std::shared_mutex _mutex;
+static std::unordered_map<uint32, std::vector<tile_paint_cache_entry>> _tiles;
+static size_t _numEntries;
+static std::atomic<uint32> _generation;
+static std::atomic<uint32> _hits;
+static std::atomic<uint32> _misses;
+
+bool tile_paint_cache_is_enabled()
+{
+    return _enabled;
+}
+
+void tile_paint_cache_set_enabled(bool enabled)
+{
+    _enabled = enabled;
+    tile_paint_cache_invalidate_all();
+}
+
+static uint32 tile_paint_cache_get_tile_key(sint32 x, sint32 y)
+{
+    return (uint32)(x & 0xFFFF) | ((uint32)(y & 0xFFFF) << 16);
+}
+
+static uint32 tile_paint_cache_get_view_key(const paint_session * session)
+{
+    uint32 key = gCurrentViewportFlags & 0x7FFFF;
+    key |= (session->CurrentRotation & 3) << 19;
+    key |= (session->DPI->zoom_level & 7) << 21;
+    key |= (gConfigGeneral.landscape_smoothing ? 1 : 0) << 24;
+    return key;
+}
+
+static bool tile_paint_cache_is_static_element(const rct_tile_element * tileElement)
+{
+    switch (tileElement->GetType())
+    {
+    case TILE_ELEMENT_TYPE_SURFACE:
+        return true;
+    case TILE_ELEMENT_TYPE_PATH:
+        // Queue banners show scrolling ride names
+        return !footpath_element_has_queue_banner(tileElement);
+    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+    {
+        rct_scenery_entry * entry = get_small_scenery_entry(tileElement->properties.scenery.type);
+        return entry == nullptr || !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED);
+    }
+    case TILE_ELEMENT_TYPE_WALL:
+    {
+        rct_scenery_entry * entry = get_wall_entry(tileElement->properties.wall.type);
+        return entry == nullptr ||
+               (!(entry->wall.flags2 & WALL_SCENERY_2_ANIMATED) && entry->wall.scrolling_mode == 0xFF);
+    }
+    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+    {
+        rct_scenery_entry * entry = get_large_scenery_entry(scenery_large_get_type(tileElement));
+        return entry == nullptr || entry->large_scenery.scrolling_mode == 0xFF;
+    }
+    default:
+        // Tracks, entrances and banners are animated or show text
+        return false;
+    }
+}
+
+/**
+ * Whether the elements of the tile being painted can be painted from the cache. Tiles with
+ * animated elements and any overlay that depends on more than the tile itself are painted as usual.
+ */
+bool tile_paint_cache_can_paint(const paint_session * session, const rct_tile_element * tileElement)
+{
+    if (!_enabled)
+        return false;
+
+    // Both are left clear for every tile by tile_element_paint_setup. Other callers such as sub_68B2B7
+    // set them up before painting the tile, which the recorded calls would not follow.
+    if (session->Unk141E9DB != 0 || session->WoodenSupportsPrependTo != nullptr)
+        return false;
+
+    if (gCurrentViewportFlags & (VIEWPORT_FLAG_CLIP_VIEW | VIEWPORT_FLAG_LAND_OWNERSHIP | VIEWPORT_FLAG_CONSTRUCTION_RIGHTS))
+        return false;
+
+    if ((gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT)) ||
+        gStaffDrawPatrolAreas != SPRITE_INDEX_NULL || gTrackDesignSaveMode ||
+        (gScreenFlags & (SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER)))
+        return false;
+
+    if (gPaintBlockedTiles || gPaintWidePathsAsGhost || gShowSupportSegmentHeights)
+        return false;
+
+#ifdef __ENABLE_LIGHTFX__
+    // Path lamps add lights while they are painted
+    if (lightfx_is_available())
+        return false;
+#endif
+
+    // Elements at height 0 would see the same height elements of the previous tile
+    if (tileElement->base_height == 0)
+        return false;
+
+    do
+    {
+        if (!tile_paint_cache_is_static_element(tileElement))
+            return false;
+    }
+    while (!(tileElement++)->IsLastForTile());
+    return true;
+}
+
+static size_t tile_paint_cache_count_elements(const rct_tile_element * tileElement)
+{
+    size_t numElements = 1;
+    while (!(tileElement++)->IsLastForTile())
+    {
+        numElements++;
+    }
+    return numElements;
+}
+
+static const tile_paint_cache_entry * tile_paint_cache_find(
+    uint32 tileKey, uint32 viewKey, const rct_tile_element * tileElement, size_t numElements)
+{
+    auto it = _tiles.find(tileKey);
+    if (it == _tiles.end())
+        return nullptr;
+
+    uint32 generation = _generation;
+    for (const auto &entry : it->second)
+    {
+        if (entry.ViewKey == viewKey)
+        {
+            if (entry.Generation != generation || entry.Elements.size() != numElements ||
+                std::memcmp(entry.Elements.data(), tileElement, numElements * sizeof(rct_tile_element)) != 0)
+            {
+                return nullptr;
+            }
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Paints the elements of a tile into a scratch session that culls nothing and returns the paint
+ * calls made, so that the calls can be replayed against the column of any session.
+ */
+static tile_paint_cache_entry tile_paint_cache_record(
+    paint_session * session, rct_tile_element * tileElement, size_t numElements, tile_paint_elements_func paintElements)
+{
+    rct_drawpixelinfo dpi = {};
+    dpi.x = -16384;
+    dpi.y = -16384;
+    dpi.width = 32767;
+    dpi.height = 32767;
+    dpi.zoom_level = session->DPI->zoom_level;
+
+    paint_session * scratch = paint_session_alloc(&dpi);
+    scratch->CurrentRotation = session->CurrentRotation;
+    scratch->SpritePosition = session->SpritePosition;
+    scratch->MapPosition = session->MapPosition;
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), scratch->SupportSegments);
+    scratch->Support = session->Support;
+    std::copy(std::begin(session->LeftTunnels), std::end(session->LeftTunnels), scratch->LeftTunnels);
+    scratch->LeftTunnelCount = session->LeftTunnelCount;
+    std::copy(std::begin(session->RightTunnels), std::end(session->RightTunnels), scratch->RightTunnels);
+    scratch->RightTunnelCount = session->RightTunnelCount;
+    scratch->VerticalTunnelHeight = session->VerticalTunnelHeight;
+    scratch->DidPassSurface = session->DidPassSurface;
+    scratch->Unk141E9DB = session->Unk141E9DB;
+    scratch->WaterHeight = session->WaterHeight;
+
+    tile_paint_recording recording = { tileElement, numElements, true, {}, {} };
+    scratch->TilePaintRecording = &recording;
+    paintElements(scratch, tileElement);
+    scratch->TilePaintRecording = nullptr;
+
+    // Keep what the painters changed on the structs after they were created
+    for (size_t i = 0; i < recording.Calls.size(); i++)
+    {
+        tile_paint_call &call = recording.Calls[i];
+        void * result = recording.Results[i];
+        if (result == nullptr)
+            continue;
+
+        if (call.Type == TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS || call.Type == TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_ATTACH)
+        {
+            auto attached = (const attached_paint_struct *)result;
+            call.Flags = attached->flags;
+            call.ColourImageId = attached->colour_image_id;
+        }
+        else
+        {
+            auto ps = (const paint_struct *)result;
+            call.Flags = ps->flags;
+            call.ColourImageId = ps->colour_image_id;
+        }
+    }
+    paint_session_free(scratch);
+
+    tile_paint_cache_entry entry;
+    entry.ViewKey = tile_paint_cache_get_view_key(session);
+    entry.Generation = _generation;
+    entry.Cacheable = recording.Cacheable;
+    entry.Elements.assign(tileElement, tileElement + numElements);
+    entry.Calls = std::move(recording.Calls);
+    return entry;
+}
+
+static void tile_paint_cache_replay(paint_session * session, const tile_paint_cache_entry &entry, const rct_tile_element * tileElement)
+{
+    const LocationXY16 mapPosition = session->MapPosition;
+    for (const auto &call : entry.Calls)
+    {
+        session->InteractionType = call.InteractionType;
+        session->SpritePosition = call.SpritePosition;
+        session->MapPosition = call.MapPosition;
+        session->CurrentlyDrawnItem = tileElement + call.ElementIndex;
+
+        const sint16 * args = call.Args;
+        paint_struct * ps = nullptr;
+        switch (call.Type)
+        {
+        case TILE_PAINT_CALL_98196C:
+            ps = sub_98196C(session, call.ImageId, (sint8)args[0], (sint8)args[1], args[2], args[3], (sint8)args[4], args[5]);
+            break;
+        case TILE_PAINT_CALL_98197C:
+            ps = sub_98197C(
+                session, call.ImageId, (sint8)args[0], (sint8)args[1], args[2], args[3], (sint8)args[4], args[5], args[6],
+                args[7], args[8]);
+            break;
+        case TILE_PAINT_CALL_98198C:
+            ps = sub_98198C(
+                session, call.ImageId, (sint8)args[0], (sint8)args[1], args[2], args[3], (sint8)args[4], args[5], args[6],
+                args[7], args[8]);
+            break;
+        case TILE_PAINT_CALL_98199C:
+            ps = sub_98199C(
+                session, call.ImageId, (sint8)args[0], (sint8)args[1], args[2], args[3], (sint8)args[4], args[5], args[6],
+                args[7], args[8]);
+            break;
+        case TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS:
+        case TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_ATTACH:
+        {
+            bool attached = call.Type == TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS
+                ? paint_attach_to_previous_ps(session, call.ImageId, (uint16)args[0], (uint16)args[1])
+                : paint_attach_to_previous_attach(session, call.ImageId, (uint16)args[0], (uint16)args[1]);
+            if (attached)
+            {
+                session->UnkF1AD2C->flags = call.Flags;
+                session->UnkF1AD2C->colour_image_id = call.ColourImageId;
+            }
+            break;
+        }
+        }
+
+        if (ps != nullptr)
+        {
+            ps->flags = call.Flags;
+            ps->colour_image_id = call.ColourImageId;
+        }
+    }
+    session->MapPosition = mapPosition;
+}
+
+/**
+ * Paints the elements of a tile, replaying the paint calls of the last time the tile was painted
+ * with the same view when its elements have not changed since.
+ */
+void tile_paint_cache_paint(paint_session * session, rct_tile_element * tileElement, tile_paint_elements_func paintElements)
+{
+    const uint32 tileKey = tile_paint_cache_get_tile_key(session->MapPosition.x / 32, session->MapPosition.y / 32);
+    const uint32 viewKey = tile_paint_cache_get_view_key(session);
+    const size_t numElements = tile_paint_cache_count_elements(tileElement);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        const tile_paint_cache_entry * entry = tile_paint_cache_find(tileKey, viewKey, tileElement, numElements);
+        if (entry != nullptr && entry->Cacheable)
+        {
+            _hits++;
+            tile_paint_cache_replay(session, *entry, tileElement);
+            return;
+        }
+        if (entry != nullptr)
+        {
+            lock.unlock();
+            paintElements(session, tileElement);
+            return;
+        }
+    }
+
+    _misses++;
+    tile_paint_cache_entry entry = tile_paint_cache_record(session, tileElement, numElements, paintElements);
+    if (entry.Cacheable)
+    {
+        tile_paint_cache_replay(session, entry, tileElement);
+    }
+    else
+    {
+        paintElements(session, tileElement);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    if (_numEntries >= MAX_TILE_PAINT_CACHE_ENTRIES)
+    {
+        _tiles.clear();
+        _numEntries = 0;
+    }
+
+    auto &entries = _tiles[tileKey];
+    auto it = std::find_if(entries.begin(), entries.end(), [viewKey](const tile_paint_cache_entry &e) { return e.ViewKey == viewKey; });
+    if (it != entries.end())
+    {
+        *it = std::move(entry);
+    }
+    else
+    {
+        entries.push_back(std::move(entry));
+        _numEntries++;
+    }
+}
+
+/**
+ * Called by the paint primitives when the session is recording a tile.
+ */
+void tile_paint_cache_record_call(
+    paint_session * session, uint8 type, void * result, uint32 imageId, std::initializer_list<sint16> args)
+{
+    tile_paint_recording * recording = session->TilePaintRecording;
+
+    // These attach to the struct created by the previous call, which is outside of the tile for the first call
+    if (recording->Calls.empty() &&
+        (type == TILE_PAINT_CALL_98199C || type == TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS ||
+         type == TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_ATTACH))
+    {
+        recording->Cacheable = false;
+    }
+
+    tile_paint_call call = {};
+    call.Type = type;
+    call.InteractionType = session->InteractionType;
+    call.SpritePosition = session->SpritePosition;
+    call.MapPosition = session->MapPosition;
+    call.ImageId = imageId;
+    std::copy(args.begin(), args.end(), call.Args);
+
+    auto element = (const rct_tile_element *)session->CurrentlyDrawnItem;
+    if (element >= recording->FirstElement && element < recording->FirstElement + recording->NumElements &&
+        element - recording->FirstElement <= UINT16_MAX)
+    {
+        call.ElementIndex = (uint16)(element - recording->FirstElement);
+    }
+    else
+    {
+        recording->Cacheable = false;
+    }
+
+    recording->Calls.push_back(call);
+    recording->Results.push_back(result);
+}
+
+/**
+ * Drops the cached paint calls of a tile and its neighbours, whose edges depend on it.
+ */
+void tile_paint_cache_invalidate_tile(sint32 x, sint32 y)
+{
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    for (sint32 dy = -1; dy <= 1; dy++)
+    {
+        for (sint32 dx = -1; dx <= 1; dx++)
+        {
+            auto it = _tiles.find(tile_paint_cache_get_tile_key(x + dx, y + dy));
+            if (it != _tiles.end())
+            {
+                _numEntries -= it->second.size();
+                _tiles.erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * Marks every cached tile as stale, entries are replaced the next time their tile is painted.
+ */
+void tile_paint_cache_invalidate_all()
+{
+    _generation++;
+}
+
+tile_paint_cache_statistics tile_paint_cache_get_statistics()
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    tile_paint_cache_statistics result;
+    result.Hits = _hits;
+    result.Misses = _misses;
+    result.Records = (uint32)_numEntries;
+    return result;
+}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _TILE_PAINT_CACHE_H
+#define _TILE_PAINT_CACHE_H
+
+#include <initializer_list>
+#include <vector>
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct paint_session;
+struct rct_tile_element;
+
+enum TILE_PAINT_CALL
+{
+    TILE_PAINT_CALL_98196C,
+    TILE_PAINT_CALL_98197C,
+    TILE_PAINT_CALL_98198C,
+    TILE_PAINT_CALL_98199C,
+    TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_PS,
+    TILE_PAINT_CALL_ATTACH_TO_PREVIOUS_ATTACH,
+};
+
+/**
+ * A paint primitive call made while painting the elements of a tile, together with the session
+ * state it read and the state the tile painters left on the struct it created.
+ */
+struct tile_paint_call
+{
+    uint8        Type;
+    uint8        InteractionType;
+    uint8        Flags;
+    uint16       ElementIndex;  // CurrentlyDrawnItem, relative to the first element of the tile
+    LocationXY16 SpritePosition;
+    LocationXY16 MapPosition;
+    uint32       ImageId;
+    uint32       ColourImageId;
+    sint16       Args[9];
+};
+
+/**
+ * Calls recorded by the primitives while a tile is painted into a scratch session.
+ */
+struct tile_paint_recording
+{
+    const rct_tile_element *     FirstElement;
+    size_t                       NumElements;
+    bool                         Cacheable;
+    std::vector<tile_paint_call> Calls;
+    std::vector<void *>          Results;
+};
+
+struct tile_paint_cache_statistics
+{
+    uint32 Hits;
+    uint32 Misses;
+    uint32 Records;
+};
+
+using tile_paint_elements_func = void (*)(paint_session * session, rct_tile_element * tileElement);
+
+bool tile_paint_cache_is_enabled();
+void tile_paint_cache_set_enabled(bool enabled);
+bool tile_paint_cache_can_paint(const paint_session * session, const rct_tile_element * tileElement);
+void tile_paint_cache_paint(paint_session * session, rct_tile_element * tileElement, tile_paint_elements_func paintElements);
+void tile_paint_cache_record_call(
+    paint_session * session, uint8 type, void * result, uint32 imageId, std::initializer_list<sint16> args);
+
+void tile_paint_cache_invalidate_tile(sint32 x, sint32 y);
+void tile_paint_cache_invalidate_all();
+tile_paint_cache_statistics tile_paint_cache_get_statistics();
+
+#endif
@@ -89,6 +89,7 @@ void banner_paint(paint_session * session, uint8 direction, sint32 height, const
 
     scrollingMode += direction;
 
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
 
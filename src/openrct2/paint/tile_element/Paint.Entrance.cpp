@@ -21,8 +21,6 @@
 #include "Paint.TileElement.h"
 #include "../../drawing/LightFX.h"
 
-static uint32 _unk9E32BC;
-
 /**
  *
  *  rct2: 0x0066508C, 0x00665540
@@ -77,12 +75,12 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
     image_id = (colour_1 << 19) | (colour_2 << 24) | IMAGE_TYPE_REMAP | IMAGE_TYPE_REMAP_2_PLUS;
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_RIDE;
-    _unk9E32BC = 0;
+    uint32 ghost_id = 0;
 
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         image_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = image_id;
+        ghost_id = image_id;
         if (transparant_image_id)
             transparant_image_id = image_id;
     }
@@ -139,6 +137,7 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
         !(tile_element->flags & TILE_ELEMENT_FLAG_GHOST) &&
         tile_element->properties.entrance.ride_index != 0xFF){
 
+        std::lock_guard<std::mutex> lock(gPaintTextMutex);
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
 
@@ -170,7 +169,7 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
             height + style->height, 2, 2, height + style->height);
     }
 
-    image_id = _unk9E32BC;
+    image_id = ghost_id;
     if (image_id == 0) {
         image_id = SPRITE_ID_PALETTE_COLOUR_1(COLOUR_SATURATED_BROWN);
     }
@@ -198,12 +197,10 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
 #endif
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_PARK;
-    _unk9E32BC = 0;
     uint32 image_id, ghost_id = 0;
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         ghost_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = ghost_id;
     }
 
     // Index to which part of the entrance
@@ -241,6 +238,7 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
             break;
 
         {
+            std::lock_guard<std::mutex> lock(gPaintTextMutex);
             rct_string_id park_text_id = STR_BANNER_TEXT_CLOSED;
             set_format_arg(0, uint32, 0);
             set_format_arg(4, uint32, 0);
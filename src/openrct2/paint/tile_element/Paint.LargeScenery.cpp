@@ -258,6 +258,7 @@ void large_scenery_paint(paint_session * session, uint8 direction, uint16 height
         }
         // 6B8331:
         // Draw sign text:
+        std::lock_guard<std::mutex> lock(gPaintTextMutex);
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
         sint32 textColour = scenery_large_get_secondary_colour(tileElement);
@@ -344,6 +345,7 @@ void large_scenery_paint(paint_session * session, uint8 direction, uint16 height
         return;
     }
     // Draw scrolling text:
+    std::lock_guard<std::mutex> lock(gPaintTextMutex);
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
     uint8 textColour = scenery_large_get_secondary_colour(tileElement);
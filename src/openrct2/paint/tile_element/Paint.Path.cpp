@@ -452,6 +452,7 @@ static void sub_6A4101(
             uint16 scrollingMode = footpathEntry->scrolling_mode;
             scrollingMode += direction;
 
+            std::lock_guard<std::mutex> lock(gPaintTextMutex);
             set_format_arg(0, uint32, 0);
             set_format_arg(4, uint32, 0);
 
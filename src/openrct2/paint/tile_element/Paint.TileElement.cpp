@@ -26,6 +26,7 @@
 #include "../../sprites.h"
 #include "../Paint.h"
 #include "../Supports.h"
+#include "../TilePaintCache.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
 #include "Paint.TileElement.h"
@@ -129,6 +130,101 @@ static void blank_tiles_paint(paint_session * session, sint32 x, sint32 y)
 
 bool gShowSupportSegmentHeights = false;
 
+/**
+ * Paints the elements of a tile, returns the element after the last one or nullptr when
+ * painting stopped at a corrupt element.
+ */
+static rct_tile_element * sub_68B3FB_paint_elements(paint_session * session, rct_tile_element * tile_element)
+{
+    uint8 rotation = session->CurrentRotation;
+    sint32 previousHeight = 0;
+    do {
+        // Only paint tile_elements below the clip height.
+        if ((gCurrentViewportFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->base_height > gClipHeight))
+            continue;
+
+        sint32 direction = tile_element_get_direction_with_offset(tile_element, rotation);
+        sint32 height = tile_element->base_height * 8;
+
+        // If we are on a new height level, look through elements on the
+        //  same height and store any types might be relevant to others
+        if (height != previousHeight)
+        {
+            previousHeight = height;
+            session->PathElementOnSameHeight = nullptr;
+            session->TrackElementOnSameHeight = nullptr;
+            rct_tile_element * tile_element_sub_iterator = tile_element;
+            while (!(tile_element_sub_iterator++)->IsLastForTile())
+            {
+                if (tile_element_sub_iterator->base_height != tile_element->base_height)
+                {
+                    break;
+                }
+                switch (tile_element_sub_iterator->GetType())
+                {
+                case TILE_ELEMENT_TYPE_PATH:
+                    session->PathElementOnSameHeight = tile_element_sub_iterator;
+                    break;
+                case TILE_ELEMENT_TYPE_TRACK:
+                    session->TrackElementOnSameHeight = tile_element_sub_iterator;
+                    break;
+                case TILE_ELEMENT_TYPE_CORRUPT:
+                    // To preserve regular behaviour, make an element hidden by
+                    //  corruption also invisible to this method.
+                    if (tile_element->IsLastForTile())
+                    {
+                        break;
+                    }
+                    tile_element_sub_iterator++;
+                    break;
+                }
+            }
+        }
+
+        LocationXY16 dword_9DE574 = session->MapPosition;
+        session->CurrentlyDrawnItem = tile_element;
+        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
+        switch (tile_element->GetType())
+        {
+        case TILE_ELEMENT_TYPE_SURFACE:
+            surface_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_PATH:
+            path_paint(session, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_TRACK:
+            track_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            scenery_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            entrance_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_WALL:
+            fence_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            large_scenery_paint(session, direction, height, tile_element);
+            break;
+        case TILE_ELEMENT_TYPE_BANNER:
+            banner_paint(session, direction, height, tile_element);
+            break;
+        // A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
+        case TILE_ELEMENT_TYPE_CORRUPT:
+            if (tile_element->IsLastForTile())
+                return nullptr;
+            tile_element++;
+            break;
+        default:
+            // An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of all elements after it.
+            return nullptr;
+        }
+        session->MapPosition = dword_9DE574;
+    } while (!(tile_element++)->IsLastForTile());
+    return tile_element;
+}
+
 /**
  *
  *  rct2: 0x0068B3FB
@@ -245,91 +341,20 @@ static void sub_68B3FB(paint_session * session, sint32 x, sint32 y)
     session->SpritePosition.x = x;
     session->SpritePosition.y = y;
     session->DidPassSurface = false;
-    sint32 previousHeight = 0;
-    do {
-        // Only paint tile_elements below the clip height.
-        if ((gCurrentViewportFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->base_height > gClipHeight))
-            continue;
 
-        sint32 direction = tile_element_get_direction_with_offset(tile_element, rotation);
-        sint32 height = tile_element->base_height * 8;
-
-        // If we are on a new height level, look through elements on the
-        //  same height and store any types might be relevant to others
-        if (height != previousHeight)
-        {
-            previousHeight = height;
-            session->PathElementOnSameHeight = nullptr;
-            session->TrackElementOnSameHeight = nullptr;
-            rct_tile_element * tile_element_sub_iterator = tile_element;
-            while (!(tile_element_sub_iterator++)->IsLastForTile())
-            {
-                if (tile_element_sub_iterator->base_height != tile_element->base_height)
-                {
-                    break;
-                }
-                switch (tile_element_sub_iterator->GetType())
-                {
-                case TILE_ELEMENT_TYPE_PATH:
-                    session->PathElementOnSameHeight = tile_element_sub_iterator;
-                    break;
-                case TILE_ELEMENT_TYPE_TRACK:
-                    session->TrackElementOnSameHeight = tile_element_sub_iterator;
-                    break;
-                case TILE_ELEMENT_TYPE_CORRUPT:
-                    // To preserve regular behaviour, make an element hidden by
-                    //  corruption also invisible to this method.
-                    if (tile_element->IsLastForTile())
-                    {
-                        break;
-                    }
-                    tile_element_sub_iterator++;
-                    break;
-                }
-            }
-        }
+#ifndef __TESTPAINT__
+    if (!partOfVirtualFloor && !gShowSupportSegmentHeights && tile_paint_cache_can_paint(session, tile_element))
+    {
+        tile_paint_cache_paint(session, tile_element, [](paint_session * s, rct_tile_element * tileElement) {
+            sub_68B3FB_paint_elements(s, tileElement);
+        });
+        return;
+    }
+#endif // __TESTPAINT__
 
-        LocationXY16 dword_9DE574 = session->MapPosition;
-        session->CurrentlyDrawnItem = tile_element;
-        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
-        switch (tile_element->GetType())
-        {
-        case TILE_ELEMENT_TYPE_SURFACE:
-            surface_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_PATH:
-            path_paint(session, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_TRACK:
-            track_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-            scenery_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_ENTRANCE:
-            entrance_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_WALL:
-            fence_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
-            large_scenery_paint(session, direction, height, tile_element);
-            break;
-        case TILE_ELEMENT_TYPE_BANNER:
-            banner_paint(session, direction, height, tile_element);
-            break;
-        // A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
-        case TILE_ELEMENT_TYPE_CORRUPT:
-            if (tile_element->IsLastForTile())
-                return;
-            tile_element++;
-            break;
-        default:
-            // An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of all elements after it.
-            return;
-        }
-        session->MapPosition = dword_9DE574;
-    } while (!(tile_element++)->IsLastForTile());
+    tile_element = sub_68B3FB_paint_elements(session, tile_element);
+    if (tile_element == nullptr)
+        return;
 
 #ifndef __TESTPAINT__
     if (gConfigGeneral.virtual_floor_style != VIRTUAL_FLOOR_STYLE_OFF && partOfVirtualFloor)
@@ -22,20 +22,24 @@
 #include "../OpenRCT2.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
+#include "../world/Ambience.h"
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
 #include "../world/LargeScenery.h"
+#include "../world/LitterIndex.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
 #include "../windows/Intent.h"
 #include "Peep.h"
+#include "StaffJobs.h"
 
 // Locations of the spiral slide platform that a peep walks from the entrance of the ride to the
 // entrance of the slide. Up to 4 waypoints for each 4 sides that an ride entrance can be located
@@ -1612,26 +1616,7 @@ void rct_peep::PickRideToGoOn()
     else
     {
         // Take nearby rides into consideration
-        sint32 cx = floor2(x, 32);
-        sint32 cy = floor2(y, 32);
-        for (sint32 tileX = cx - 320; tileX <= cx + 320; tileX += 32)
-        {
-            for (sint32 tileY = cy - 320; tileY <= cy + 320; tileY += 32)
-            {
-                if (tileX >= 0 && tileY >= 0 && tileX < (256 * 32) && tileY < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(tileX >> 5, tileY >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
-
-                        sint32 rideIndex = track_element_get_ride_index(tileElement);
-                        rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                    } while (!(tileElement++)->IsLastForTile());
-                }
-            }
-        }
+        ride_proximity_get_rides_near(x >> 5, y >> 5, 10, rideConsideration);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         sint32 i;
@@ -2700,97 +2685,54 @@ static uint8 peep_assess_surroundings(sint16 centre_x, sint16 centre_y, sint16 c
     if ((tile_element_height(centre_x, centre_y) & 0xFFFF) > centre_z)
         return PEEP_THOUGHT_TYPE_NONE;
 
-    uint16 num_scenery   = 0;
-    uint16 num_fountains = 0;
-    uint16 nearby_music  = 0;
-    uint16 num_rubbish   = 0;
+    // The 10x10 tiles around the centre
+    sint32 left   = (centre_x - 160) / 32;
+    sint32 top    = (centre_y - 160) / 32;
+    sint32 right  = (centre_x + 128) / 32;
+    sint32 bottom = (centre_y + 128) / 32;
 
-    sint16 initial_x = Math::Max(centre_x - 160, 0);
-    sint16 initial_y = Math::Max(centre_y - 160, 0);
-    sint16 final_x   = Math::Min(centre_x + 160, 8192);
-    sint16 final_y   = Math::Min(centre_y + 160, 8192);
+    ambience_counts ambience = ambience_get_counts(left, top, right, bottom);
+    if (ambience.MissingItems != 0)
+        return PEEP_THOUGHT_TYPE_NONE;
 
-    for (sint16 x = initial_x; x < final_x; x += 32)
+    uint32 num_scenery   = ambience.Scenery;
+    uint32 num_fountains = ambience.Fountains;
+    uint16 nearby_music  = 0;
+    uint32 num_rubbish   = ambience.BrokenItems;
+
+    uint32 nearbyRides[8]{};
+    ride_proximity_get_rides_in(left, top, right, bottom, nearbyRides);
+    for (sint32 i = 0; i < MAX_RIDES; i++)
     {
-        for (sint16 y = initial_y; y < final_y; y += 32)
+        if (!(nearbyRides[i >> 5] & (1u << (i & 0x1F))))
+            continue;
+
+        Ride * ride = get_ride(i);
+        if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RIDE_STATUS_CLOSED &&
+            !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
         {
-            rct_tile_element * tileElement = map_get_first_element_at(x / 32, y / 32);
 
-            do
+            if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
             {
-                Ride *              ride;
-                rct_scenery_entry * scenery;
-
-                switch (tileElement->GetType())
-                {
-                case TILE_ELEMENT_TYPE_PATH:
-                    if (!footpath_element_has_path_scenery(tileElement))
-                        break;
-
-                    scenery = get_footpath_item_entry(footpath_element_get_path_scenery_index(tileElement));
-                    if (scenery == nullptr)
-                    {
-                        return PEEP_THOUGHT_TYPE_NONE;
-                    }
-                    if (footpath_element_path_scenery_is_ghost(tileElement))
-                        break;
-
-                    if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
-                    {
-                        num_fountains++;
-                        break;
-                    }
-                    if (tileElement->flags & TILE_ELEMENT_FLAG_BROKEN)
-                    {
-                        num_rubbish++;
-                    }
-                    break;
-                case TILE_ELEMENT_TYPE_LARGE_SCENERY:
-                case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-                    num_scenery++;
-                    break;
-                case TILE_ELEMENT_TYPE_TRACK:
-                    ride = get_ride(track_element_get_ride_index(tileElement));
-                    if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RIDE_STATUS_CLOSED &&
-                        !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
-                    {
-
-                        if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
-                        {
-                            nearby_music |= 1;
-                            break;
-                        }
+                nearby_music |= 1;
+                continue;
+            }
 
-                        if (ride->music == MUSIC_STYLE_ORGAN)
-                        {
-                            nearby_music |= 1;
-                            break;
-                        }
+            if (ride->music == MUSIC_STYLE_ORGAN)
+            {
+                nearby_music |= 1;
+                continue;
+            }
 
-                        if (ride->type == RIDE_TYPE_DODGEMS)
-                        {
-                            // Dodgems drown out music?
-                            nearby_music |= 2;
-                        }
-                    }
-                    break;
-                }
-            } while (!(tileElement++)->IsLastForTile());
+            if (ride->type == RIDE_TYPE_DODGEMS)
+            {
+                // Dodgems drown out music?
+                nearby_music |= 2;
+            }
         }
     }
 
-    rct_litter * litter;
-    for (uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next)
-    {
-        litter = &(get_sprite(sprite_idx)->litter);
-
-        sint16 dist_x = abs(litter->x - centre_x);
-        sint16 dist_y = abs(litter->y - centre_y);
-        if (Math::Max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
-    }
+    num_rubbish += litter_index_count_within(centre_x, centre_y, 160);
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -2949,28 +2891,17 @@ static void peep_head_for_nearest_ride_type(rct_peep * peep, sint32 rideType)
     else
     {
         // Take nearby rides into consideration
-        sint32 cx = floor2(peep->x, 32);
-        sint32 cy = floor2(peep->y, 32);
-        for (sint32 x = cx - 320; x <= cx + 320; x += 32)
+        uint32 nearbyRides[8]{};
+        ride_proximity_get_rides_near(peep->x >> 5, peep->y >> 5, 10, nearbyRides);
+        for (sint32 i = 0; i < MAX_RIDES; i++)
         {
-            for (sint32 y = cy - 320; y <= cy + 320; y += 32)
-            {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
+            if (!(nearbyRides[i >> 5] & (1u << (i & 0x1F))))
+                continue;
 
-                        sint32 rideIndex = track_element_get_ride_index(tileElement);
-                        ride             = get_ride(rideIndex);
-                        if (ride->type == rideType)
-                        {
-                            rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!(tileElement++)->IsLastForTile());
-                }
+            ride = get_ride(i);
+            if (ride->type == rideType)
+            {
+                rideConsideration[i >> 5] |= (1u << (i & 0x1F));
             }
         }
     }
@@ -3078,28 +3009,17 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep * peep, sint32 rideTy
     else
     {
         // Take nearby rides into consideration
-        sint32 cx = floor2(peep->x, 32);
-        sint32 cy = floor2(peep->y, 32);
-        for (sint32 x = cx - 320; x <= cx + 320; x += 32)
+        uint32 nearbyRides[8]{};
+        ride_proximity_get_rides_near(peep->x >> 5, peep->y >> 5, 10, nearbyRides);
+        for (sint32 i = 0; i < MAX_RIDES; i++)
         {
-            for (sint32 y = cy - 320; y <= cy + 320; y += 32)
-            {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
-                {
-                    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
-                    do
-                    {
-                        if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
-                            continue;
+            if (!(nearbyRides[i >> 5] & (1u << (i & 0x1F))))
+                continue;
 
-                        sint32 rideIndex = track_element_get_ride_index(tileElement);
-                        ride             = get_ride(rideIndex);
-                        if (ride_type_has_flag(ride->type, rideTypeFlags))
-                        {
-                            rideConsideration[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
-                        }
-                    } while (!(tileElement++)->IsLastForTile());
-                }
+            ride = get_ride(i);
+            if (ride_type_has_flag(ride->type, rideTypeFlags))
+            {
+                rideConsideration[i >> 5] |= (1u << (i & 0x1F));
             }
         }
     }
@@ -5861,6 +5781,7 @@ void rct_peep::UpdateUsingBin()
         tileElement->properties.path.addition_status &= ~(3 << selected_bin);
         // Then placing the new value.
         tileElement->properties.path.addition_status |= space_left_in_bin << selected_bin;
+        staff_jobs_invalidate_tile(next_x / 32, next_y / 32);
 
         map_invalidate_tile_zoom0(next_x, next_y, tileElement->base_height << 3, tileElement->clearance_height << 3);
         StateReset();
@@ -6177,6 +6098,8 @@ static void peep_update_walking_break_scenery(rct_peep * peep)
     }
 
     tileElement->flags |= TILE_ELEMENT_FLAG_BROKEN;
+    ambience_invalidate_tile(peep->next_x / 32, peep->next_y / 32);
+    staff_jobs_invalidate_tile(peep->next_x / 32, peep->next_y / 32);
 
     map_invalidate_tile_zoom1(peep->next_x, peep->next_y, (tileElement->base_height << 3) + 32, tileElement->base_height << 3);
 
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include "../world/Entrance.h"
+#include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
+#include "../world/Map.h"
+#include "GuestFlowField.h"
+#include "Peep.h"
+
+// Enough for the rides, park entrances and peep spawns of a large park
+constexpr size_t MAX_FLOW_FIELDS = 64;
+
+/**
+ * The direction to leave each path tile in to walk to a goal the shortest way, for every path
+ * tile a guest can walk to the goal from.
+ */
+struct guest_flow_field
+{
+    uint32                            Goal;
+    std::unordered_map<uint32, uint8> Directions;
+};
+
+// Most recently used first. Guests also find their way on the think threads (see peep_update_all),
+// so the fields are only used while holding the lock.
+static std::mutex _mutex;
+static std::list<guest_flow_field> _fields;
+static std::unordered_map<uint32, std::list<guest_flow_field>::iterator> _index;
+static uint32 _generation;
+static uint32 _hits;
+static uint32 _misses;
+static uint32 _unreached;
+static uint32 _evictions;
+static uint64 _tilesBuilt;
+static uint64 _buildTime;
+
+static uint32 guest_flow_field_get_key(TileCoordsXYZ loc)
+{
+    return (uint32)(loc.x & 0xFF) | ((uint32)(loc.y & 0xFF) << 8) | ((uint32)(loc.z & 0xFF) << 16);
+}
+
+/**
+ * The tiles the flow field is built over: paths that the pathfinding of guests walks through
+ * rather than stopping at.
+ */
+static bool guest_flow_field_is_walkable(const rct_tile_element * tileElement)
+{
+    return tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && !(tileElement->flags & TILE_ELEMENT_FLAG_GHOST) &&
+        !footpath_element_is_wide(tileElement) && !footpath_element_is_queue(tileElement);
+}
+
+/**
+ * Checks whether walking onto the tile of the given location, arriving at the given height in
+ * the given direction, gets to that location.
+ */
+static bool guest_flow_field_arrives_at(TileCoordsXYZ loc, bool isGoal, sint32 height, sint32 direction)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(loc.x, loc.y);
+    do
+    {
+        if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+            continue;
+
+        // The goal can also be a shop, a ride entrance or a park entrance at the height walked onto it
+        if (isGoal && height == loc.z && tileElement->base_height == height)
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+                return true;
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_ENTRANCE &&
+                (tileElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE ||
+                 tile_element_get_direction(tileElement) == direction))
+                return true;
+        }
+
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (tileElement->base_height != loc.z)
+            continue;
+        if (!isGoal && !guest_flow_field_is_walkable(tileElement))
+            continue;
+        if (is_valid_path_z_and_direction(tileElement, height, direction))
+            return true;
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+/**
+ * Walks the footpaths backwards from the goal, breadth first so that each tile gets the direction
+ * of a shortest walk. Has to be called for guests only, as the 'no entry' signs are passed
+ * according to who is finding their way.
+ */
+static void guest_flow_field_build(TileCoordsXYZ goal, guest_flow_field& field)
+{
+    std::queue<TileCoordsXYZ> frontier;
+    frontier.push(goal);
+    bool isGoal = true;
+    while (!frontier.empty())
+    {
+        TileCoordsXYZ target = frontier.front();
+        frontier.pop();
+
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            // The tile walked onto the target from in this direction
+            TileCoordsXY from = { target.x - TileDirectionDelta[direction].x, target.y - TileDirectionDelta[direction].y };
+            if (from.x < 0 || from.y < 0 || from.x >= MAXIMUM_MAP_SIZE_TECHNICAL || from.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                continue;
+
+            rct_tile_element * tileElement = map_get_first_element_at(from.x, from.y);
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                if (!guest_flow_field_is_walkable(tileElement))
+                    continue;
+                if (!(path_get_permitted_edges(tileElement) & (1 << direction)))
+                    continue;
+
+                TileCoordsXYZ fromLoc = { from.x, from.y, tileElement->base_height };
+                uint32 key = guest_flow_field_get_key(fromLoc);
+                if (field.Directions.count(key) != 0 || key == field.Goal)
+                    continue;
+
+                sint32 height = tileElement->base_height;
+                if (footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == direction)
+                {
+                    height += 2;
+                }
+                if (!guest_flow_field_arrives_at(target, isGoal, height, direction))
+                    continue;
+
+                field.Directions[key] = direction;
+                frontier.push(fromLoc);
+            } while (!(tileElement++)->IsLastForTile());
+        }
+        isGoal = false;
+    }
+}
+
+static void guest_flow_field_clear_locked()
+{
+    _fields.clear();
+    _index.clear();
+}
+
+static const guest_flow_field * guest_flow_field_get(TileCoordsXYZ goal)
+{
+    // Any change to the footpaths can change the shortest walks anywhere
+    uint32 generation = footpath_graph_get_generation();
+    if (generation != _generation)
+    {
+        guest_flow_field_clear_locked();
+        _generation = generation;
+    }
+
+    uint32 goalKey = guest_flow_field_get_key(goal);
+    auto it = _index.find(goalKey);
+    if (it != _index.end())
+    {
+        _hits++;
+        _fields.splice(_fields.begin(), _fields, it->second);
+        return &_fields.front();
+    }
+
+    _misses++;
+    if (_fields.size() >= MAX_FLOW_FIELDS)
+    {
+        _index.erase(_fields.back().Goal);
+        _fields.pop_back();
+        _evictions++;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    _fields.emplace_front();
+    guest_flow_field& field = _fields.front();
+    field.Goal = goalKey;
+    guest_flow_field_build(goal, field);
+    _index[goalKey] = _fields.begin();
+
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    _buildTime += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    _tilesBuilt += field.Directions.size();
+    return &field;
+}
+
+/**
+ * Gets the direction a guest on the path at the given location takes to walk to the goal the
+ * shortest way. Returns -1 if the goal cannot be walked to from there without crossing a wide
+ * path or a queue.
+ */
+sint32 guest_flow_field_get_direction(TileCoordsXYZ goal, TileCoordsXYZ loc)
+{
+    if (goal.x < 0 || goal.y < 0 || goal.x >= MAXIMUM_MAP_SIZE_TECHNICAL || goal.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return -1;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const guest_flow_field * field = guest_flow_field_get(goal);
+    auto it = field->Directions.find(guest_flow_field_get_key(loc));
+    if (it == field->Directions.end())
+    {
+        _unreached++;
+        return -1;
+    }
+    return it->second;
+}
+
+void guest_flow_field_clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    guest_flow_field_clear_locked();
+}
+
+guest_flow_field_statistics guest_flow_field_get_statistics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    guest_flow_field_statistics statistics = {};
+    statistics.Fields = (uint32)_fields.size();
+    statistics.Hits = _hits;
+    statistics.Misses = _misses;
+    statistics.Unreached = _unreached;
+    statistics.Evictions = _evictions;
+    statistics.TilesBuilt = _tilesBuilt;
+    statistics.BuildTime = _buildTime;
+    return statistics;
+}
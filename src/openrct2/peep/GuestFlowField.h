@@ -0,0 +1,31 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _GUEST_FLOW_FIELD_H_
+#define _GUEST_FLOW_FIELD_H_
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct guest_flow_field_statistics
+{
+    uint32 Fields;
+    uint32 Hits;
+    uint32 Misses;
+    uint32 Unreached;
+    uint32 Evictions;
+    uint64 TilesBuilt;
+    uint64 BuildTime; // in microseconds
+};
+
+sint32 guest_flow_field_get_direction(TileCoordsXYZ goal, TileCoordsXYZ loc);
+void guest_flow_field_clear();
+guest_flow_field_statistics guest_flow_field_get_statistics();
+
+#endif
@@ -7,20 +7,35 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "GuestFlowField.h"
 #include "Peep.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+#include "../config/Config.h"
+#include "../Game.h"
+#include "../network/network.h"
 #include "../scenario/Scenario.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Entrance.h"
+#include "../world/Sprite.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../util/Util.h"
 
-static bool   _peepPathFindIsStaff;
-static sint8  _peepPathFindNumJunctions;
-static sint8  _peepPathFindMaxJunctions;
-static sint32 _peepPathFindTilesChecked;
-static uint8  _peepPathFindFewestNumSteps;
+// Per thread, as guests also search for their way on the think threads (see peep_update_all)
+static thread_local bool   _peepPathFindIsStaff;
+static thread_local sint8  _peepPathFindNumJunctions;
+static thread_local sint8  _peepPathFindMaxJunctions;
+static thread_local sint32 _peepPathFindTilesChecked;
+static thread_local uint8  _peepPathFindFewestNumSteps;
+// Set while guest_path_finding_think searches on a copy of a guest
+static thread_local bool   _peepPathFindIsThinking;
 
 static sint32 guest_surface_path_finding(rct_peep * peep);
 
@@ -28,7 +43,7 @@ static sint32 guest_surface_path_finding(rct_peep * peep);
 * The magic number 16 is the largest value returned by
 * peep_pathfind_get_max_number_junctions() which should eventually
 * be declared properly. */
-static struct
+static thread_local struct
 {
     TileCoordsXYZ location;
     uint8          direction;
@@ -94,7 +109,7 @@ static sint32 banner_clear_path_edges(rct_tile_element * tileElement, sint32 edg
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
-static sint32 path_get_permitted_edges(rct_tile_element * tileElement)
+sint32 path_get_permitted_edges(rct_tile_element * tileElement)
 {
     return banner_clear_path_edges(tileElement, tileElement->properties.path.edges) & 0x0F;
 }
@@ -448,7 +463,8 @@ static uint8 peep_pathfind_get_max_number_junctions(rct_peep * peep)
     // PEEP_FLAGS_2? It's cleared here but not set anywhere!
     if ((peep->peep_flags & PEEP_FLAGS_2))
     {
-        if ((scenario_rand() & 0xFFFF) <= 7281)
+        // The random number is drawn when the guest really decides, in sprite order
+        if (!_peepPathFindIsThinking && (scenario_rand() & 0xFFFF) <= 7281)
             peep->peep_flags &= ~PEEP_FLAGS_2;
 
         return 8;
@@ -508,6 +524,25 @@ static bool path_is_thin_junction(rct_tile_element * path, TileCoordsXYZ loc)
     return thin_junction;
 }
 
+/**
+ * The heuristic score of a location, i.e. its distance from the goal with the
+ * shorter of the x and y distances weighted down.
+ */
+static uint16 peep_pathfind_heuristic_score(TileCoordsXYZ loc)
+{
+    uint16 x_delta = abs(gPeepPathFindGoalPosition.x - loc.x) * 32;
+    uint16 y_delta = abs(gPeepPathFindGoalPosition.y - loc.y) * 32;
+    if (x_delta < y_delta)
+        x_delta >>= 4;
+    else
+        y_delta >>= 4;
+    uint16 new_score = x_delta + y_delta;
+    uint16 z_delta   = abs(gPeepPathFindGoalPosition.z - loc.z);
+    z_delta <<= 1;
+    new_score += z_delta;
+    return new_score;
+}
+
 /**
  * Searches for the tile with the best heuristic score within the search limits
  * starting from the given tile x,y,z and going in the given direction test_edge.
@@ -594,6 +629,77 @@ static void peep_pathfind_heuristic_search(TileCoordsXYZ loc, rct_peep * peep, r
     bool currentElementIsWide =
         (footpath_element_is_wide(currentTileElement) && !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, loc.z, currentTileElement));
 
+    bool skipPlainTiles = true;
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    // Log every tile of the search path
+    skipPlainTiles = !gPathFindDebug;
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+
+    if (skipPlainTiles)
+    {
+        /* Walk along the plain path tiles ahead (see footpath_graph_segment)
+         * without looking at their map elements again. On these tiles the
+         * search cannot branch or stop other than by the checks below,
+         * which are the same as those made further down for a thin path
+         * with a single edge to continue along. */
+        const footpath_graph_segment * segment = footpath_graph_get_segment(loc, test_edge);
+        for (const auto &step : segment->Steps)
+        {
+            ++counter;
+            _peepPathFindTilesChecked--;
+
+            if ((_peepPathFindHistory[0].location.x == (uint8)step.x) && (_peepPathFindHistory[0].location.y == (uint8)step.y) &&
+                (_peepPathFindHistory[0].location.z == step.ArrivalZ))
+            {
+                return;
+            }
+
+            if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+            {
+                bool stepInPatrolArea = staff_is_location_in_patrol(peep, step.x * 32, step.y * 32);
+                if (inPatrolArea && !stepInPatrolArea)
+                {
+                    return;
+                }
+                inPatrolArea = stepInPatrolArea;
+            }
+
+            TileCoordsXYZ stepLoc = { step.x, step.y, step.BaseZ };
+            uint16 new_score = peep_pathfind_heuristic_score(stepLoc);
+            if (new_score == 0 || counter >= 200 || _peepPathFindTilesChecked <= 0)
+            {
+                /* The goal or a search limit is reached. */
+                if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
+                {
+                    // Update the search results
+                    *endScore = new_score;
+                    *endSteps = counter;
+                    // Update the end x,y,z
+                    *endXYZ = stepLoc;
+                    // Update the telemetry
+                    *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                    for (uint8 junctInd = 0; junctInd < *endJunctions; junctInd++)
+                    {
+                        uint8 histIdx            = _peepPathFindMaxJunctions - junctInd;
+                        junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
+                        junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
+                        junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
+                        directionList[junctInd]  = _peepPathFindHistory[histIdx].direction;
+                    }
+                }
+                return;
+            }
+        }
+
+        if (!segment->Steps.empty())
+        {
+            /* Continue from the last plain path tile. */
+            loc                  = segment->End;
+            test_edge            = segment->EndDirection;
+            currentElementIsWide = false;
+        }
+    }
+
     loc += TileDirectionDelta[test_edge];
 
     ++counter;
@@ -789,16 +895,7 @@ static void peep_pathfind_heuristic_search(TileCoordsXYZ loc, rct_peep * peep, r
          * Ignore for now. */
 
         // Calculate the heuristic score of this map element.
-        uint16 x_delta = abs(gPeepPathFindGoalPosition.x - loc.x) * 32;
-        uint16 y_delta = abs(gPeepPathFindGoalPosition.y - loc.y) * 32;
-        if (x_delta < y_delta)
-            x_delta >>= 4;
-        else
-            y_delta >>= 4;
-        uint16 new_score = x_delta + y_delta;
-        uint16 z_delta   = abs(gPeepPathFindGoalPosition.z - loc.z);
-        z_delta <<= 1;
-        new_score += z_delta;
+        uint16 new_score = peep_pathfind_heuristic_score(loc);
 
         /* If this map element is the search goal the current search path ends here. */
         if (new_score == 0)
@@ -1152,6 +1249,558 @@ static void peep_pathfind_heuristic_search(TileCoordsXYZ loc, rct_peep * peep, r
     }
 }
 
+/**
+ * A search position of peep_pathfind_graph_search: a path tile about to be left in Direction
+ * by a search path that started along FirstEdge.
+ */
+struct pathfind_graph_entry
+{
+    uint16        Steps;
+    uint32        Order;
+    TileCoordsXYZ Location;
+    uint8         Direction;
+    uint8         FirstEdge;
+    bool          FromWide;
+    bool          InPatrolArea;
+
+    bool operator<(const pathfind_graph_entry& other) const
+    {
+        // Reversed for std::priority_queue, which puts the largest on top
+        if (Steps != other.Steps)
+            return Steps > other.Steps;
+        return Order > other.Order;
+    }
+};
+
+static uint32 peep_pathfind_graph_get_key(TileCoordsXYZ loc)
+{
+    return (uint32)(loc.x & 0xFF) | ((uint32)(loc.y & 0xFF) << 8) | ((uint32)(loc.z & 0xFF) << 16);
+}
+
+/**
+ * Whether peep_pathfind_choose_direction uses peep_pathfind_graph_search. It finds different ways
+ * than the heuristic search, so it has to be turned on with pathfinding_graph_search, and network
+ * games always use the heuristic search, where every client has to make the same choices as the server.
+ */
+static bool peep_pathfind_use_graph()
+{
+    return gConfigGeneral.pathfinding_graph_search && network_get_mode() == NETWORK_MODE_NONE;
+}
+
+/**
+ * Searches the footpath navigation graph for the shortest walk to the goal, going from junction
+ * to junction along whole segments of plain path tiles at a time (see footpath_graph_segment).
+ * The tiles along the way are the same as for peep_pathfind_heuristic_search, but there is no
+ * limit on the number of junctions or steps, only on the tiles checked.
+ *
+ * Returns:
+ *   -1   - no direction chosen
+ *   0..3 - the first edge of the shortest walk to the goal, or if the goal could not be
+ *          reached before the search limit, of the walk to the closest tile reached
+ */
+static sint32 peep_pathfind_graph_search(TileCoordsXYZ loc, rct_peep * peep, rct_tile_element * startTileElement, uint8 edges,
+                                         sint32 maxTilesChecked)
+{
+    const TileCoordsXYZ goal = gPeepPathFindGoalPosition;
+    const bool isMechanic = peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC;
+
+    std::priority_queue<pathfind_graph_entry> queue;
+    std::unordered_set<uint32> visited;
+    visited.insert(peep_pathfind_graph_get_key(loc));
+
+    uint32 order = 0;
+    bool startIsWide = footpath_element_is_wide(startTileElement) &&
+        !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, loc.z, startTileElement);
+    bool startInPatrolArea = isMechanic && staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
+    for (sint32 edge = bitscanforward(edges); edge != -1; edge = bitscanforward(edges))
+    {
+        edges &= ~(1 << edge);
+        uint8 height = loc.z;
+        if (footpath_element_is_sloped(startTileElement) && footpath_element_get_slope_direction(startTileElement) == edge)
+        {
+            height += 2;
+        }
+        queue.push({ 0, order++, { loc.x, loc.y, height }, (uint8)edge, (uint8)edge, startIsWide, startInPatrolArea });
+    }
+
+    sint32 tilesChecked = maxTilesChecked;
+    uint16 goalSteps = 0xFFFF;
+    sint32 goalEdge = -1;
+    uint16 bestScore = 0xFFFF;
+    uint16 bestSteps = 0xFFFF;
+    sint32 bestEdge = -1;
+
+    // Updates the closest tile reached so far, or the goal if the score is 0
+    auto reachTile = [&](TileCoordsXYZ tileLoc, uint16 steps, uint8 firstEdge) {
+        uint16 score = peep_pathfind_heuristic_score(tileLoc);
+        if (score == 0 && (steps < goalSteps || (steps == goalSteps && firstEdge < goalEdge)))
+        {
+            goalSteps = steps;
+            goalEdge = firstEdge;
+        }
+        if (score < bestScore || (score == bestScore && steps < bestSteps))
+        {
+            bestScore = score;
+            bestSteps = steps;
+            bestEdge = firstEdge;
+        }
+        return score;
+    };
+
+    while (!queue.empty() && tilesChecked > 0)
+    {
+        pathfind_graph_entry entry = queue.top();
+        queue.pop();
+        if (entry.Steps >= goalSteps)
+            break;
+
+        uint32 steps = entry.Steps;
+        bool inPatrolArea = entry.InPatrolArea;
+        TileCoordsXYZ current = entry.Location;
+        uint8 direction = entry.Direction;
+        bool fromWide = entry.FromWide;
+
+        // Walk the segment ahead in one go unless something on it needs to be looked at
+        const footpath_graph_segment * segment = footpath_graph_get_segment(current, direction);
+        if (!segment->Steps.empty())
+        {
+            if (isMechanic || segment->Contains(goal.x, goal.y) || segment->Contains(loc.x, loc.y))
+            {
+                bool stop = false;
+                for (const auto &step : segment->Steps)
+                {
+                    steps++;
+                    TileCoordsXYZ stepLoc = { step.x, step.y, step.BaseZ };
+                    if (visited.count(peep_pathfind_graph_get_key(stepLoc)) != 0)
+                    {
+                        stop = true;
+                        break;
+                    }
+                    if (isMechanic)
+                    {
+                        bool stepInPatrolArea = staff_is_location_in_patrol(peep, step.x * 32, step.y * 32);
+                        if (inPatrolArea && !stepInPatrolArea)
+                        {
+                            stop = true;
+                            break;
+                        }
+                        inPatrolArea = stepInPatrolArea;
+                    }
+                    if (reachTile(stepLoc, (uint16)std::min<uint32>(steps, 0xFFFE), entry.FirstEdge) == 0)
+                    {
+                        stop = true;
+                        break;
+                    }
+                }
+                tilesChecked -= (sint32)segment->Steps.size();
+                if (stop)
+                    continue;
+            }
+            else
+            {
+                steps += (uint32)segment->Steps.size();
+                tilesChecked -= (sint32)segment->Steps.size();
+            }
+            current = segment->End;
+            direction = segment->EndDirection;
+            fromWide = false;
+        }
+
+        // Look at the node the segment leads to the same way as the heuristic search does
+        current += TileDirectionDelta[direction];
+        steps++;
+        tilesChecked--;
+        if (steps >= 0xFFFF)
+            continue;
+
+        if (isMechanic)
+        {
+            bool nextInPatrolArea = staff_is_location_in_patrol(peep, current.x * 32, current.y * 32);
+            if (inPatrolArea && !nextInPatrolArea)
+                continue;
+            inPatrolArea = nextInPatrolArea;
+        }
+
+        rct_tile_element * tileElement = map_get_first_element_at(current.x, current.y);
+        if (tileElement == nullptr)
+            continue;
+        do
+        {
+            if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+                continue;
+
+            TileCoordsXYZ nodeLoc = current;
+            switch (tileElement->GetType())
+            {
+            case TILE_ELEMENT_TYPE_TRACK:
+                if (current.z != tileElement->base_height)
+                    continue;
+                // For peeps heading for a shop, the goal is the shop tile
+                if (ride_type_has_flag(get_ride(track_element_get_ride_index(tileElement))->type, RIDE_TYPE_FLAG_IS_SHOP) &&
+                    peep_pathfind_heuristic_score(nodeLoc) == 0)
+                {
+                    reachTile(nodeLoc, (uint16)steps, entry.FirstEdge);
+                }
+                continue;
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                if (current.z != tileElement->base_height)
+                    continue;
+                switch (tileElement->properties.entrance.type)
+                {
+                case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                case ENTRANCE_TYPE_RIDE_EXIT:
+                    if (tile_element_get_direction(tileElement) != direction)
+                        continue;
+                    // fall-through
+                case ENTRANCE_TYPE_PARK_ENTRANCE:
+                    if (peep_pathfind_heuristic_score(nodeLoc) == 0)
+                    {
+                        reachTile(nodeLoc, (uint16)steps, entry.FirstEdge);
+                    }
+                    break;
+                }
+                continue;
+            case TILE_ELEMENT_TYPE_PATH:
+                break;
+            default:
+                continue;
+            }
+
+            if (!is_valid_path_z_and_direction(tileElement, current.z, direction))
+                continue;
+
+            // Path may be sloped, so set z to path base height.
+            nodeLoc.z = tileElement->base_height;
+            current.z = tileElement->base_height;
+
+            if (footpath_element_is_wide(tileElement) &&
+                !staff_can_ignore_wide_flag(peep, nodeLoc.x * 32, nodeLoc.y * 32, nodeLoc.z, tileElement))
+            {
+                /* Wide paths are only crossed from the wide path the peep is on,
+                 * and are not continued along. */
+                if (fromWide || peep_pathfind_heuristic_score(nodeLoc) == 0)
+                {
+                    reachTile(nodeLoc, (uint16)steps, entry.FirstEdge);
+                }
+                continue;
+            }
+
+            uint8 numEdges = bitcount(footpath_get_edges(tileElement));
+            if (numEdges == 2 && footpath_element_is_queue(tileElement) &&
+                tileElement->properties.path.ride_index != gPeepPathFindQueueRideIndex && gPeepPathFindIgnoreForeignQueues &&
+                tileElement->properties.path.ride_index != 0xFF)
+            {
+                // Path is a queue we aren't interested in
+                if (peep_pathfind_heuristic_score(nodeLoc) == 0)
+                {
+                    reachTile(nodeLoc, (uint16)steps, entry.FirstEdge);
+                }
+                continue;
+            }
+
+            // Dead ends are only of interest if they are the goal
+            uint8 nextEdges = path_get_permitted_edges(tileElement) & ~(1 << (direction ^ 2));
+            if (nextEdges == 0 && peep_pathfind_heuristic_score(nodeLoc) != 0)
+                continue;
+            if (reachTile(nodeLoc, (uint16)steps, entry.FirstEdge) == 0 || nextEdges == 0)
+                continue;
+
+            if (!visited.insert(peep_pathfind_graph_get_key(nodeLoc)).second)
+                continue;
+
+            for (sint32 edge = bitscanforward(nextEdges); edge != -1; edge = bitscanforward(nextEdges))
+            {
+                nextEdges &= ~(1 << edge);
+                uint8 height = nodeLoc.z;
+                if (footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == edge)
+                {
+                    height += 2;
+                }
+                queue.push({ (uint16)steps, order++, { nodeLoc.x, nodeLoc.y, height }, (uint8)edge, entry.FirstEdge, false,
+                             inPatrolArea });
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    if (goalEdge != -1)
+        return goalEdge;
+
+    // The goal is not reachable at all if the whole network has been searched
+    if (tilesChecked > 0 && queue.empty())
+        return -1;
+    return bestEdge;
+}
+
+/**
+ * Searches which of the given edges, at least two, the peep leaves its tile in to walk to
+ * gPeepPathFindGoalPosition. Returns the edge, or -1 if the search failed.
+ */
+static sint32 peep_pathfind_search_edges(TileCoordsXYZ loc, rct_peep * peep, rct_tile_element * first_tile_element, uint8 edges,
+                                         sint32 maxTilesChecked)
+{
+    TileCoordsXYZ goal        = gPeepPathFindGoalPosition;
+    sint32        chosen_edge = bitscanforward(edges);
+
+    if (peep_pathfind_use_graph())
+    {
+        /* Guests share the walks to their common goals, which are
+         * searched once for all of them. */
+        sint32 flowDirection = -1;
+        if (peep->type == PEEP_TYPE_GUEST && gPeepPathFindIgnoreForeignQueues)
+        {
+            flowDirection = guest_flow_field_get_direction(goal, loc);
+        }
+
+        if (flowDirection != -1 && (edges & (1 << flowDirection)))
+            return flowDirection;
+        return peep_pathfind_graph_search(loc, peep, first_tile_element, edges, maxTilesChecked);
+    }
+
+    uint16 best_score = 0xFFFF;
+    uint8  best_sub   = 0xFF;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    uint8         bestJunctions = 0;
+    TileCoordsXYZ bestJunctionList[16];
+    uint8         bestDirectionList[16];
+    TileCoordsXYZ bestXYZ;
+
+    if (gPathFindDebug)
+    {
+        log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    /* Call the search heuristic on each edge, keeping track of the
+     * edge that gives the best (i.e. smallest) value (best_score)
+     * or for different edges with equal value, the edge with the
+     * least steps (best_sub). */
+    sint32 numEdges = bitcount(edges);
+    for (sint32 test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
+    {
+        edges &= ~(1 << test_edge);
+        uint8 height = loc.z;
+
+        if (footpath_element_is_sloped(first_tile_element) &&
+            footpath_element_get_slope_direction(first_tile_element) == test_edge)
+        {
+            height += 0x2;
+        }
+
+        _peepPathFindFewestNumSteps = 255;
+        /* Divide the maxTilesChecked global search limit
+         * between the remaining edges to ensure the search
+         * covers all of the remaining edges. */
+        _peepPathFindTilesChecked = maxTilesChecked / numEdges;
+        _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
+
+        // Initialise _peepPathFindHistory.
+        memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
+
+        /* The pathfinding will only use elements
+         * 1.._peepPathFindMaxJunctions, so the starting point
+         * is placed in element 0 */
+        _peepPathFindHistory[0].location.x = (uint8)(loc.x);
+        _peepPathFindHistory[0].location.y = (uint8)(loc.y);
+        _peepPathFindHistory[0].location.z = loc.z;
+        _peepPathFindHistory[0].direction  = 0xF;
+
+        uint16 score = 0xFFFF;
+        /* Variable endXYZ contains the end location of the
+         * search path. */
+        TileCoordsXYZ endXYZ;
+        endXYZ.x = 0;
+        endXYZ.y = 0;
+        endXYZ.z = 0;
+
+        uint8 endSteps = 255;
+
+        /* Variable endJunctions is the number of junctions
+         * passed through in the search path.
+         * Variables endJunctionList and endDirectionList
+         * contain the junctions and corresponding directions
+         * of the search path.
+         * In the future these could be used to visualise the
+         * pathfinding on the map. */
+        uint8          endJunctions         = 0;
+        TileCoordsXYZ endJunctionList[16];
+        uint8          endDirectionList[16] = { 0 };
+
+        bool inPatrolArea = false;
+        if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+        {
+            /* Mechanics are the only staff type that
+             * pathfind to a destination. Determine if the
+             * mechanic is in their patrol area. */
+            inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
+        }
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
+        }
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+
+        peep_pathfind_heuristic_search({ loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge,
+                                       &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score,
+                        endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
+            for (uint8 listIdx = 0; listIdx < endJunctions; listIdx++)
+            {
+                log_info("Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
+                         endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
+            }
+        }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+        if (score < best_score || (score == best_score && endSteps < best_sub))
+        {
+            chosen_edge = test_edge;
+            best_score  = score;
+            best_sub    = endSteps;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+            bestJunctions = endJunctions;
+            for (uint8 index = 0; index < endJunctions; index++)
+            {
+                bestJunctionList[index].x = endJunctionList[index].x;
+                bestJunctionList[index].y = endJunctionList[index].y;
+                bestJunctionList[index].z = endJunctionList[index].z;
+                bestDirectionList[index]  = endDirectionList[index];
+            }
+            bestXYZ.x = endXYZ.x;
+            bestXYZ.y = endXYZ.y;
+            bestXYZ.z = endXYZ.z;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        }
+    }
+
+    /* Check if the heuristic search failed. e.g. all connected
+     * paths are within the search limits and none reaches the
+     * goal. */
+    if (best_score == 0xFFFF)
+    {
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind heuristic search failed.");
+        }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        return -1;
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug)
+    {
+        log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
+        for (uint8 listIdx = 0; listIdx < bestJunctions; listIdx++)
+        {
+            log_verbose("Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
+                        bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
+        }
+        log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    return chosen_edge;
+}
+
+/**
+ * Everything the choice of peep_pathfind_search_edges depends on for a guest, other than the
+ * map and the rides.
+ */
+struct peep_pathfind_think_key
+{
+    TileCoordsXYZ Location;
+    TileCoordsXYZ Goal;
+    rct12_xyzd8   History[4];
+    uint8         Edges;
+    sint8         MaxJunctions;
+    uint8         QueueRideIndex;
+    bool          IgnoreForeignQueues;
+    bool          UseGraph;
+
+    bool operator==(const peep_pathfind_think_key& other) const
+    {
+        return Location.x == other.Location.x && Location.y == other.Location.y && Location.z == other.Location.z &&
+            Goal.x == other.Goal.x && Goal.y == other.Goal.y && Goal.z == other.Goal.z &&
+            std::memcmp(History, other.History, sizeof(History)) == 0 && Edges == other.Edges &&
+            MaxJunctions == other.MaxJunctions && QueueRideIndex == other.QueueRideIndex &&
+            IgnoreForeignQueues == other.IgnoreForeignQueues && UseGraph == other.UseGraph;
+    }
+};
+
+/**
+ * The edge a guest chose on a think thread, kept until the guest really decides in the same tick.
+ */
+struct peep_pathfind_thought
+{
+    peep_pathfind_think_key Key;
+    uint32                  Tick;
+    uint32                  Generation;
+    sint8                   Edge;
+    bool                    Valid;
+};
+
+// Each think thread only writes the thoughts of the guests it was given
+static std::array<peep_pathfind_thought, MAX_SPRITES_TECHNICAL> _thoughts;
+static std::atomic<uint32> _numThoughts;
+static uint32 _numThoughtsUsed;
+static uint32 _numThoughtsDiscarded;
+
+static peep_pathfind_think_key peep_pathfind_get_think_key(TileCoordsXYZ loc, rct_peep * peep, uint8 edges)
+{
+    peep_pathfind_think_key key;
+    key.Location = loc;
+    key.Goal = gPeepPathFindGoalPosition;
+    std::memcpy(key.History, peep->pathfind_history, sizeof(key.History));
+    key.Edges = edges;
+    key.MaxJunctions = _peepPathFindMaxJunctions;
+    key.QueueRideIndex = gPeepPathFindQueueRideIndex;
+    key.IgnoreForeignQueues = gPeepPathFindIgnoreForeignQueues;
+    key.UseGraph = peep_pathfind_use_graph();
+    return key;
+}
+
+/**
+ * Calls peep_pathfind_search_edges, or for guests, remembers its result while thinking and uses
+ * what was thought when all of its inputs are still the same. The search only reads the world,
+ * so the edge is the same either way.
+ */
+static sint32 peep_pathfind_choose_edge(TileCoordsXYZ loc, rct_peep * peep, rct_tile_element * first_tile_element, uint8 edges,
+                                        sint32 maxTilesChecked)
+{
+    if (peep->type != PEEP_TYPE_GUEST)
+        return peep_pathfind_search_edges(loc, peep, first_tile_element, edges, maxTilesChecked);
+
+    peep_pathfind_thought& thought = _thoughts[peep->sprite_index];
+    if (_peepPathFindIsThinking)
+    {
+        thought.Key = peep_pathfind_get_think_key(loc, peep, edges);
+        thought.Tick = gCurrentTicks;
+        thought.Generation = footpath_graph_get_generation();
+        thought.Edge = peep_pathfind_search_edges(loc, peep, first_tile_element, edges, maxTilesChecked);
+        thought.Valid = true;
+        _numThoughts++;
+        return thought.Edge;
+    }
+
+    if (thought.Valid)
+    {
+        thought.Valid = false;
+        if (thought.Tick == gCurrentTicks && thought.Generation == footpath_graph_get_generation() &&
+            thought.Key == peep_pathfind_get_think_key(loc, peep, edges))
+        {
+            _numThoughtsUsed++;
+            return thought.Edge;
+        }
+        _numThoughtsDiscarded++;
+    }
+    return peep_pathfind_search_edges(loc, peep, first_tile_element, edges, maxTilesChecked);
+}
+
 /**
  * Returns:
  *   -1   - no direction chosen
@@ -1327,154 +1976,9 @@ sint32 peep_pathfind_choose_direction(TileCoordsXYZ loc, rct_peep * peep)
     // Peep has multiple edges still to try.
     if (edges & ~(1 << chosen_edge))
     {
-        uint16 best_score = 0xFFFF;
-        uint8  best_sub   = 0xFF;
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        uint8         bestJunctions = 0;
-        TileCoordsXYZ bestJunctionList[16];
-        uint8         bestDirectionList[16];
-        TileCoordsXYZ bestXYZ;
-
-        if (gPathFindDebug)
-        {
-            log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, loc.x, loc.y, loc.z);
-        }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
-        /* Call the search heuristic on each edge, keeping track of the
-         * edge that gives the best (i.e. smallest) value (best_score)
-         * or for different edges with equal value, the edge with the
-         * least steps (best_sub). */
-        sint32 numEdges = bitcount(edges);
-        for (sint32 test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
-        {
-            edges &= ~(1 << test_edge);
-            uint8 height = loc.z;
-
-            if (footpath_element_is_sloped(first_tile_element) &&
-                footpath_element_get_slope_direction(first_tile_element) == test_edge)
-            {
-                height += 0x2;
-            }
-
-            _peepPathFindFewestNumSteps = 255;
-            /* Divide the maxTilesChecked global search limit
-             * between the remaining edges to ensure the search
-             * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
-
-            // Initialise _peepPathFindHistory.
-            memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
-
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = (uint8)(loc.x);
-            _peepPathFindHistory[0].location.y = (uint8)(loc.y);
-            _peepPathFindHistory[0].location.z = loc.z;
-            _peepPathFindHistory[0].direction  = 0xF;
-
-            uint16 score = 0xFFFF;
-            /* Variable endXYZ contains the end location of the
-             * search path. */
-            TileCoordsXYZ endXYZ;
-            endXYZ.x = 0;
-            endXYZ.y = 0;
-            endXYZ.z = 0;
-
-            uint8 endSteps = 255;
-
-            /* Variable endJunctions is the number of junctions
-             * passed through in the search path.
-             * Variables endJunctionList and endDirectionList
-             * contain the junctions and corresponding directions
-             * of the search path.
-             * In the future these could be used to visualise the
-             * pathfinding on the map. */
-            uint8          endJunctions         = 0;
-            TileCoordsXYZ endJunctionList[16];
-            uint8          endDirectionList[16] = { 0 };
-
-            bool inPatrolArea = false;
-            if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
-            {
-                /* Mechanics are the only staff type that
-                 * pathfind to a destination. Determine if the
-                 * mechanic is in their patrol area. */
-                inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
-            }
-
-#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
-            }
-#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-
-            peep_pathfind_heuristic_search({ loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge,
-                                           &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score,
-                            endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
-                for (uint8 listIdx = 0; listIdx < endJunctions; listIdx++)
-                {
-                    log_info("Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
-                             endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
-                }
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
-            if (score < best_score || (score == best_score && endSteps < best_sub))
-            {
-                chosen_edge = test_edge;
-                best_score  = score;
-                best_sub    = endSteps;
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-                bestJunctions = endJunctions;
-                for (uint8 index = 0; index < endJunctions; index++)
-                {
-                    bestJunctionList[index].x = endJunctionList[index].x;
-                    bestJunctionList[index].y = endJunctionList[index].y;
-                    bestJunctionList[index].z = endJunctionList[index].z;
-                    bestDirectionList[index]  = endDirectionList[index];
-                }
-                bestXYZ.x = endXYZ.x;
-                bestXYZ.y = endXYZ.y;
-                bestXYZ.z = endXYZ.z;
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            }
-        }
-
-        /* Check if the heuristic search failed. e.g. all connected
-         * paths are within the search limits and none reaches the
-         * goal. */
-        if (best_score == 0xFFFF)
-        {
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind heuristic search failed.");
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        chosen_edge = peep_pathfind_choose_edge(loc, peep, first_tile_element, edges, maxTilesChecked);
+        if (chosen_edge == -1)
             return -1;
-        }
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        if (gPathFindDebug)
-        {
-            log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
-            for (uint8 listIdx = 0; listIdx < bestJunctions; listIdx++)
-            {
-                log_verbose("Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
-                            bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
-            }
-            log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
-        }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     }
 
     if (isThin)
@@ -2169,3 +2673,61 @@ sint32 guest_path_finding(rct_peep * peep)
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     return peep_move_one_tile(direction, peep);
 }
+
+/**
+ * Searches the way on for a guest that is about to reach the middle of a path tile this tick,
+ * as guest_path_finding would, without changing the guest or drawing random numbers. Only reads
+ * the world, so it can be called for many guests at once from the think threads before the
+ * guests are updated. The searched edge is only used by the guest if it then really decides
+ * the same way from the same place.
+ */
+void guest_path_finding_think(rct_peep * peep)
+{
+    if (peep->type != PEEP_TYPE_GUEST || peep->state != PEEP_STATE_WALKING || peep->GetNextIsSurface())
+        return;
+    if (peep->action != PEEP_ACTION_NONE_1 && peep->action != PEEP_ACTION_NONE_2)
+        return;
+    // Without a goal, the guest is walking aimlessly
+    if (peep->pathfind_goal.direction > 3)
+        return;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug || (peep->peep_flags & PEEP_FLAGS_TRACKING))
+        return;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    // Whether the guest takes a step this tick, as in rct_peep::Update
+    uint32 stepsToTake = peep->energy;
+    if (peep->peep_flags & PEEP_FLAGS_SLOW_WALK)
+        stepsToTake /= 2;
+    if (peep->action == PEEP_ACTION_NONE_2 && peep->GetNextIsSloped())
+        stepsToTake /= 2;
+    if (peep->step_progress + stepsToTake <= 255)
+        return;
+
+    // Whether the step reaches the destination, as in rct_peep::UpdateAction
+    if (abs(peep->x - peep->destination_x) + abs(peep->y - peep->destination_y) > peep->destination_tolerance)
+        return;
+
+    // Guests keep heading for the same goal until they get there
+    gPeepPathFindGoalPosition = { peep->pathfind_goal.x, peep->pathfind_goal.y, peep->pathfind_goal.z };
+    gPeepPathFindIgnoreForeignQueues = true;
+    gPeepPathFindQueueRideIndex = 255;
+    if (peep->outside_of_park == 0 && !(peep->peep_flags & PEEP_FLAGS_LEAVING_PARK))
+    {
+        gPeepPathFindQueueRideIndex = peep->guest_heading_to_ride_id;
+    }
+
+    rct_peep thinker = *peep;
+    _peepPathFindIsThinking = true;
+    peep_pathfind_choose_direction({ peep->next_x / 32, peep->next_y / 32, peep->next_z }, &thinker);
+    _peepPathFindIsThinking = false;
+}
+
+guest_think_statistics guest_path_finding_get_think_statistics()
+{
+    guest_think_statistics statistics = {};
+    statistics.Thoughts = _numThoughts;
+    statistics.Used = _numThoughtsUsed;
+    statistics.Discarded = _numThoughtsDiscarded;
+    return statistics;
+}
@@ -0,0 +1,253 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <array>
+#include <vector>
+#include "../world/Sprite.h"
+#include "GuestStore.h"
+#include "Peep.h"
+
+constexpr uint16 SLOT_NULL = 0xFFFF;
+
+/**
+ * Copies of the fields of the guests that the passes over all guests read, one array per field so
+ * that a pass only reads the fields it needs. The guests themselves stay what is saved and what
+ * the fields are copied from; the order of the guests is not kept.
+ */
+static struct
+{
+    std::vector<uint16> SpriteIndex;
+    std::vector<sint16> X;
+    std::vector<sint16> Y;
+    std::vector<sint16> Z;
+    std::vector<sint16> SpriteLeft;
+    std::vector<sint16> SpriteTop;
+    std::vector<sint16> SpriteRight;
+    std::vector<sint16> SpriteBottom;
+    std::vector<uint32> PeepFlags;
+    std::vector<uint8>  State;
+    std::vector<uint8>  Happiness;
+    std::vector<uint8>  Energy;
+    std::vector<uint8>  OutsideOfPark;
+    std::vector<uint8>  LostCountdown;
+    std::vector<uint8>  HeadingToRide;
+} _guests;
+
+// The slot of each guest sprite in the arrays
+static std::array<uint16, MAX_SPRITES_TECHNICAL> _slots;
+// The arrays are built from the guest sprites when first needed after the sprites are loaded or
+// changed by a game command, and kept up to date as the guests change after that
+static bool _valid;
+static uint32 _rebuilds;
+static uint32 _updates;
+static uint32 _queries;
+
+static void guest_store_write(uint16 slot, const rct_peep * peep)
+{
+    _guests.X[slot] = peep->x;
+    _guests.Y[slot] = peep->y;
+    _guests.Z[slot] = peep->z;
+    _guests.SpriteLeft[slot] = peep->sprite_left;
+    _guests.SpriteTop[slot] = peep->sprite_top;
+    _guests.SpriteRight[slot] = peep->sprite_right;
+    _guests.SpriteBottom[slot] = peep->sprite_bottom;
+    _guests.PeepFlags[slot] = peep->peep_flags;
+    _guests.State[slot] = peep->state;
+    _guests.Happiness[slot] = peep->happiness;
+    _guests.Energy[slot] = peep->energy;
+    _guests.OutsideOfPark[slot] = peep->outside_of_park;
+    _guests.LostCountdown[slot] = peep->peep_is_lost_countdown;
+    _guests.HeadingToRide[slot] = peep->guest_heading_to_ride_id;
+}
+
+static void guest_store_insert(const rct_peep * peep)
+{
+    uint16 slot = (uint16)_guests.SpriteIndex.size();
+    _guests.SpriteIndex.push_back(peep->sprite_index);
+    _guests.X.emplace_back();
+    _guests.Y.emplace_back();
+    _guests.Z.emplace_back();
+    _guests.SpriteLeft.emplace_back();
+    _guests.SpriteTop.emplace_back();
+    _guests.SpriteRight.emplace_back();
+    _guests.SpriteBottom.emplace_back();
+    _guests.PeepFlags.emplace_back();
+    _guests.State.emplace_back();
+    _guests.Happiness.emplace_back();
+    _guests.Energy.emplace_back();
+    _guests.OutsideOfPark.emplace_back();
+    _guests.LostCountdown.emplace_back();
+    _guests.HeadingToRide.emplace_back();
+    _slots[peep->sprite_index] = slot;
+    guest_store_write(slot, peep);
+}
+
+template<typename T>
+static void guest_store_move_last(std::vector<T>& column, uint16 slot)
+{
+    column[slot] = column.back();
+    column.pop_back();
+}
+
+static void guest_store_build()
+{
+    _guests = {};
+    _slots.fill(SLOT_NULL);
+
+    uint16     spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        guest_store_insert(peep);
+    }
+    _valid = true;
+    _rebuilds++;
+}
+
+/**
+ * Drops the copies, for when the guests have been replaced or changed other than by the peep code.
+ */
+void guest_store_invalidate()
+{
+    _valid = false;
+}
+
+void guest_store_add(const rct_peep * peep)
+{
+    if (_valid && _slots[peep->sprite_index] == SLOT_NULL)
+    {
+        guest_store_insert(peep);
+    }
+}
+
+/**
+ * Copies the fields of the given peep again if it is a guest. Needs to be called whenever one of
+ * the copied fields of a guest changes outside of the guest's own update.
+ */
+void guest_store_update(const rct_peep * peep)
+{
+    if (!_valid)
+        return;
+
+    uint16 slot = _slots[peep->sprite_index];
+    if (slot != SLOT_NULL)
+    {
+        _updates++;
+        guest_store_write(slot, peep);
+    }
+}
+
+void guest_store_remove(const rct_peep * peep)
+{
+    if (!_valid)
+        return;
+
+    uint16 slot = _slots[peep->sprite_index];
+    if (slot == SLOT_NULL)
+        return;
+
+    // The last guest takes the place of the removed one
+    uint16 lastSpriteIndex = _guests.SpriteIndex.back();
+    guest_store_move_last(_guests.SpriteIndex, slot);
+    guest_store_move_last(_guests.X, slot);
+    guest_store_move_last(_guests.Y, slot);
+    guest_store_move_last(_guests.Z, slot);
+    guest_store_move_last(_guests.SpriteLeft, slot);
+    guest_store_move_last(_guests.SpriteTop, slot);
+    guest_store_move_last(_guests.SpriteRight, slot);
+    guest_store_move_last(_guests.SpriteBottom, slot);
+    guest_store_move_last(_guests.PeepFlags, slot);
+    guest_store_move_last(_guests.State, slot);
+    guest_store_move_last(_guests.Happiness, slot);
+    guest_store_move_last(_guests.Energy, slot);
+    guest_store_move_last(_guests.OutsideOfPark, slot);
+    guest_store_move_last(_guests.LostCountdown, slot);
+    guest_store_move_last(_guests.HeadingToRide, slot);
+    _slots[lastSpriteIndex] = slot;
+    _slots[peep->sprite_index] = SLOT_NULL;
+}
+
+static size_t guest_store_begin_query()
+{
+    if (!_valid)
+    {
+        guest_store_build();
+    }
+    _queries++;
+    return _guests.SpriteIndex.size();
+}
+
+/**
+ * Counts the guests in the park, and of those the happy and the lost ones, for the park rating.
+ */
+guest_store_park_counts guest_store_get_park_counts()
+{
+    size_t count = guest_store_begin_query();
+
+    // Without branches, so that the loop can be vectorised
+    sint32 inPark = 0;
+    sint32 happy = 0;
+    sint32 lost = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        sint32 isInPark = _guests.OutsideOfPark[i] == 0;
+        inPark += isInPark;
+        happy += isInPark & (_guests.Happiness[i] > 128);
+        lost += isInPark & ((_guests.PeepFlags[i] & PEEP_FLAGS_LEAVING_PARK) != 0) & (_guests.LostCountdown[i] < 90);
+    }
+
+    guest_store_park_counts result;
+    result.InPark = inPark;
+    result.Happy = happy;
+    result.Lost = lost;
+    return result;
+}
+
+/**
+ * Counts the guests in the park that have all of the given peep flags.
+ */
+sint32 guest_store_count_in_park(uint32 peepFlags)
+{
+    size_t count = guest_store_begin_query();
+
+    sint32 result = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        result += (_guests.OutsideOfPark[i] == 0) & ((_guests.PeepFlags[i] & peepFlags) == peepFlags);
+    }
+    return result;
+}
+
+/**
+ * Counts the guests whose sprites overlap the given view, with those queuing counting once and the
+ * others twice, for the noise of the crowd.
+ */
+sint32 guest_store_get_crowd_size(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    size_t count = guest_store_begin_query();
+
+    sint32 result = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        sint32 isVisible = (_guests.SpriteLeft[i] != LOCATION_NULL) & (left <= _guests.SpriteRight[i]) &
+            (right >= _guests.SpriteLeft[i]) & (top <= _guests.SpriteBottom[i]) & (bottom >= _guests.SpriteTop[i]);
+        result += isVisible * (_guests.State[i] == PEEP_STATE_QUEUING ? 1 : 2);
+    }
+    return result;
+}
+
+guest_store_statistics guest_store_get_statistics()
+{
+    guest_store_statistics statistics = {};
+    statistics.Guests = _valid ? (uint32)_guests.SpriteIndex.size() : 0;
+    statistics.Rebuilds = _rebuilds;
+    statistics.Updates = _updates;
+    statistics.Queries = _queries;
+    return statistics;
+}
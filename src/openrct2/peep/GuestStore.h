@@ -0,0 +1,41 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _GUEST_STORE_H_
+#define _GUEST_STORE_H_
+
+#include "../common.h"
+
+struct rct_peep;
+
+struct guest_store_park_counts
+{
+    sint32 InPark;
+    sint32 Happy; // in the park with a happiness above 128
+    sint32 Lost;  // in the park, leaving but unable to find the way out
+};
+
+struct guest_store_statistics
+{
+    uint32 Guests;
+    uint32 Rebuilds;
+    uint32 Updates;
+    uint32 Queries;
+};
+
+void guest_store_invalidate();
+void guest_store_add(const rct_peep * peep);
+void guest_store_update(const rct_peep * peep);
+void guest_store_remove(const rct_peep * peep);
+guest_store_park_counts guest_store_get_park_counts();
+sint32 guest_store_count_in_park(uint32 peepFlags);
+sint32 guest_store_get_crowd_size(sint32 left, sint32 top, sint32 right, sint32 bottom);
+guest_store_statistics guest_store_get_statistics();
+
+#endif
@@ -8,6 +8,9 @@
  *****************************************************************************/
 
 #include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "../Context.h"
 #include "../OpenRCT2.h"
@@ -16,6 +19,7 @@
 #include "../Cheats.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../Game.h"
@@ -45,8 +49,10 @@
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
+#include "GuestStore.h"
 #include "Peep.h"
 #include "Staff.h"
+#include "StaffJobs.h"
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 bool gPathFindDebug = false;
@@ -67,9 +73,10 @@ uint32 gNextGuestNumber;
 
 uint8 gPeepWarningThrottle[16];
 
-TileCoordsXYZ gPeepPathFindGoalPosition;
-bool          gPeepPathFindIgnoreForeignQueues;
-uint8         gPeepPathFindQueueRideIndex;
+// Per thread, as guests also search for their way on the think threads (see peep_update_all)
+thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+thread_local bool          gPeepPathFindIgnoreForeignQueues;
+thread_local uint8         gPeepPathFindQueueRideIndex;
 // uint32 gPeepPathFindAltStationNum;
 
 
@@ -78,6 +85,8 @@ static rct_tile_element * _peepRideEntranceExitElement;
 
 static void * _crowdSoundChannel = nullptr;
 
+static std::unique_ptr<JobPool> _thinkJobs;
+
 static void   peep_128_tick_update(rct_peep * peep, sint32 index);
 static void   peep_easter_egg_peep_interactions(rct_peep * peep);
 static void   peep_give_real_name(rct_peep * peep);
@@ -415,6 +424,45 @@ sint32 peep_get_staff_count()
     return count;
 }
 
+/**
+ * Returns the job pool the guests think on before they are updated, or nullptr if the guests
+ * only decide as they are updated.
+ */
+static JobPool * peep_get_think_jobs()
+{
+    sint32 numThreads = gConfigGeneral.guest_think_threads;
+    if (numThreads <= 1)
+    {
+        _thinkJobs = nullptr;
+        return nullptr;
+    }
+
+    size_t maxThreads = Math::Min<size_t>((size_t)numThreads, std::thread::hardware_concurrency());
+    if (_thinkJobs == nullptr || _thinkJobs->GetThreadCount() != maxThreads)
+    {
+        _thinkJobs = std::make_unique<JobPool>(maxThreads);
+    }
+    return _thinkJobs.get();
+}
+
+/**
+ * Lets the guests search for their way on the think threads. The searches only read the world;
+ * the guests are changed as they are updated afterwards, in sprite order, so the park plays out
+ * the same with any number of threads.
+ */
+static void peep_think_all(JobPool * jobs)
+{
+    uint16     spriteIndex;
+    rct_peep * peep;
+
+    std::vector<rct_peep *> guests;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        guests.push_back(peep);
+    }
+    jobs->ParallelFor(guests.size(), [&guests](size_t i) { guest_path_finding_think(guests[i]); });
+}
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -428,6 +476,12 @@ void peep_update_all()
     if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
         return;
 
+    JobPool * thinkJobs = peep_get_think_jobs();
+    if (thinkJobs != nullptr)
+    {
+        peep_think_all(thinkJobs);
+    }
+
     spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
     i           = 0;
     while (spriteIndex != SPRITE_INDEX_NULL)
@@ -448,6 +502,12 @@ void peep_update_all()
             }
         }
 
+        // The guest was just read and written, so copying its fields costs little
+        if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2)
+        {
+            guest_store_update(peep);
+        }
+
         i++;
     }
 }
@@ -838,7 +898,7 @@ bool rct_peep::Place(TileCoordsXYZ location, bool apply)
 
 bool peep_pickup_command(uint32 peepnum, sint32 x, sint32 y, sint32 z, sint32 action, bool apply)
 {
-    if (peepnum >= MAX_SPRITES)
+    if (peepnum >= sprite_get_capacity())
     {
         log_error("Failed to pick up peep for sprite %d", peepnum);
         return false;
@@ -1133,6 +1193,7 @@ void rct_peep::SetState(uint8 new_state)
     peep_decrement_num_riders(this);
     state = new_state;
     peep_window_state_update(this);
+    guest_store_update(this);
 }
 
 /**
@@ -1509,8 +1570,6 @@ void peep_stop_crowd_noise()
 void peep_update_crowd_noise()
 {
     rct_viewport * viewport;
-    uint16         spriteIndex;
-    rct_peep *     peep;
     sint32         visiblePeeps;
 
     if (gGameSoundsOff)
@@ -1527,23 +1586,8 @@ void peep_update_crowd_noise()
         return;
 
     // Count the number of peeps visible
-    visiblePeeps = 0;
-
-    FOR_ALL_GUESTS(spriteIndex, peep)
-    {
-        if (peep->sprite_left == LOCATION_NULL)
-            continue;
-        if (viewport->view_x > peep->sprite_right)
-            continue;
-        if (viewport->view_x + viewport->view_width < peep->sprite_left)
-            continue;
-        if (viewport->view_y > peep->sprite_bottom)
-            continue;
-        if (viewport->view_y + viewport->view_height < peep->sprite_top)
-            continue;
-
-        visiblePeeps += peep->state == PEEP_STATE_QUEUING ? 1 : 2;
-    }
+    visiblePeeps = guest_store_get_crowd_size(viewport->view_x, viewport->view_y, viewport->view_x + viewport->view_width,
+                                              viewport->view_y + viewport->view_height);
 
     // This function doesn't account for the fact that the screen might be so big that 100 peeps could potentially be very
     // spread out and therefore not produce any crowd noise. Perhaps a more sophisticated solution would check how many peeps
@@ -1721,7 +1765,7 @@ static constexpr const uint8 tshirt_colours[] = {
  */
 rct_peep * peep_generate(sint32 x, sint32 y, sint32 z)
 {
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_num_free() < 400)
         return nullptr;
 
     rct_peep * peep = (rct_peep *)create_sprite(1);
@@ -1903,6 +1947,7 @@ rct_peep * peep_generate(sint32 x, sint32 y, sint32 z)
 
     increment_guests_heading_for_park();
 
+    guest_store_add(peep);
     return peep;
 }
 
@@ -3615,6 +3660,10 @@ void peep_update_name_sort(rct_peep * peep)
 finish_peep_sort:
     // This is required at the moment because this function reorders peeps in the sprite list
     sprite_position_tween_reset();
+    if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+    {
+        staff_jobs_invalidate_mechanics();
+    }
 }
 
 void peep_sort()
@@ -3649,6 +3698,7 @@ void peep_sort()
     }
     // Make sure the first peep is set
     gSpriteListHead[SPRITE_LIST_PEEP] = peep_list[0];
+    staff_jobs_invalidate_mechanics();
 
     free(peep_list);
 
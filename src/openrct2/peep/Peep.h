@@ -917,9 +917,9 @@ extern uint32 gNextGuestNumber;
 
 extern uint8 gPeepWarningThrottle[16];
 
-extern TileCoordsXYZ gPeepPathFindGoalPosition;
-extern bool      gPeepPathFindIgnoreForeignQueues;
-extern uint8     gPeepPathFindQueueRideIndex;
+extern thread_local TileCoordsXYZ gPeepPathFindGoalPosition;
+extern thread_local bool          gPeepPathFindIgnoreForeignQueues;
+extern thread_local uint8         gPeepPathFindQueueRideIndex;
 
 rct_peep * try_get_guest(uint16 spriteIndex);
 sint32     peep_get_staff_count();
@@ -968,7 +968,18 @@ sint32 peep_pathfind_choose_direction(TileCoordsXYZ loc, rct_peep * peep);
 void   peep_reset_pathfind_goal(rct_peep * peep);
 
 bool is_valid_path_z_and_direction(rct_tile_element * tileElement, sint32 currentZ, sint32 currentDirection);
+sint32 path_get_permitted_edges(rct_tile_element * tileElement);
 sint32 guest_path_finding(rct_peep * peep);
+void   guest_path_finding_think(rct_peep * peep);
+
+struct guest_think_statistics
+{
+    uint32 Thoughts;  // edges searched on the think threads
+    uint32 Used;      // by the guests deciding the same way
+    uint32 Discarded; // as the guests decided differently
+};
+
+guest_think_statistics guest_path_finding_get_think_statistics();
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 #define PATHFIND_DEBUG 0 // Set to 0 to disable pathfinding debugging;
@@ -29,12 +29,14 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/LitterIndex.h"
 #include "../world/Scenery.h"
 #include "../world/SmallScenery.h"
 #include "../world/Sprite.h"
 #include "../world/Surface.h"
 #include "Peep.h"
 #include "Staff.h"
+#include "StaffJobs.h"
 
 // clang-format off
 const rct_string_id StaffCostumeNames[] = {
@@ -175,7 +177,7 @@ static money32 staff_hire_new_staff_member(uint8 staff_type, uint8 flags, sint16
     gCommandPosition.y      = command_y;
     gCommandPosition.z      = command_z;
 
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_num_free() < 400)
     {
         gGameCommandErrorText = STR_TOO_MANY_PEOPLE_IN_GAME;
         return MONEY32_UNDEFINED;
@@ -407,7 +409,7 @@ void game_command_set_staff_order(
     gCommandExpenditureType = RCT_EXPENDITURE_TYPE_WAGES;
     uint8  order_id         = *ebx >> 8;
     uint16 sprite_id        = *edx;
-    if (sprite_id >= MAX_SPRITES)
+    if (sprite_id >= sprite_get_capacity())
     {
         log_warning("Invalid game command, sprite_id = %u", sprite_id);
         *ebx = MONEY32_UNDEFINED;
@@ -466,7 +468,7 @@ void game_command_set_staff_patrol(
         sint32 x         = *eax;
         sint32 y         = *ecx;
         uint16 sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             *ebx = MONEY32_UNDEFINED;
             log_warning("Invalid sprite id %u", sprite_id);
@@ -526,7 +528,7 @@ void game_command_fire_staff_member(
     {
         window_close_by_class(WC_FIRE_PROMPT);
         uint16 sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             log_warning("Invalid game command, sprite_id = %u", sprite_id);
             *ebx = MONEY32_UNDEFINED;
@@ -880,24 +882,8 @@ void staff_toggle_patrol_area(sint32 staffIndex, sint32 x, sint32 y)
  */
 static uint8 staff_handyman_direction_to_nearest_litter(rct_peep * peep)
 {
-    uint16       nearestLitterDist = (uint16)-1;
-    rct_litter * nearestLitter     = nullptr;
-    rct_litter * litter            = nullptr;
-
-    for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16 distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter     = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    rct_litter * nearestLitter = nullptr;
+    if (litter_index_find_nearest(peep->x, peep->y, peep->z, 0x60, &nearestLitter, 1) == 0)
     {
         return 0xFF;
     }
@@ -1003,6 +989,9 @@ static uint8 staff_handyman_direction_to_uncut_grass(rct_peep * peep, uint8 vali
         if (chosenTile.x > 0x1FFF || chosenTile.y > 0x1FFF)
             continue;
 
+        if (!(staff_jobs_get_tile(chosenTile.x / 32, chosenTile.y / 32) & STAFF_JOB_MOWING))
+            continue;
+
         rct_tile_element * tileElement = map_get_surface_element_at(chosenTile);
 
         if (surface_get_terrain(tileElement) != 0)
@@ -1464,11 +1453,13 @@ static bool staff_path_finding_misc(rct_peep * peep)
  */
 static void staff_entertainer_update_nearby_peeps(rct_peep * peep)
 {
-    uint16     spriteIndex;
-    rct_peep * guest;
-
-    FOR_ALL_GUESTS(spriteIndex, guest)
+    // Only the guests of the tiles around the entertainer can be near enough
+    for (rct_sprite * sprite : sprite_get_in_rect(peep->x - 96, peep->y - 96, peep->x + 96, peep->y + 96))
     {
+        if (sprite->unknown.linked_list_type_offset != SPRITE_LIST_PEEP * 2 || sprite->peep.type != PEEP_TYPE_GUEST)
+            continue;
+
+        rct_peep * guest = &sprite->peep;
         if (guest->x == LOCATION_NULL)
             continue;
 
@@ -1696,6 +1687,7 @@ void rct_peep::UpdateMowing()
         if ((tile_element->properties.surface.terrain & TILE_ELEMENT_SURFACE_TERRAIN_MASK) == (TERRAIN_GRASS << 5))
         {
             tile_element->properties.surface.grass_length = GRASS_LENGTH_MOWED;
+            staff_jobs_invalidate_tile(next_x / 32, next_y / 32);
             map_invalidate_tile_zoom0(next_x, next_y, tile_element->base_height * 8,
                                       tile_element->base_height * 8 + 16);
         }
@@ -1758,6 +1750,7 @@ void rct_peep::UpdateWatering()
                 continue;
 
             tile_element->properties.scenery.age = 0;
+            staff_jobs_invalidate_tile(actionX / 32, actionY / 32);
             map_invalidate_tile_zoom0(actionX, actionY, tile_element->base_height * 8, tile_element->clearance_height * 8);
             staff_gardens_watered++;
             window_invalidate_flags |= PEEP_INVALIDATE_STAFF_STATS;
@@ -1841,6 +1834,7 @@ void rct_peep::UpdateEmptyingBin()
         }
 
         tile_element->properties.path.addition_status |= ((3 << var_37) << var_37);
+        staff_jobs_invalidate_tile(next_x / 32, next_y / 32);
 
         map_invalidate_tile_zoom0(next_x, next_y, tile_element->base_height * 8, tile_element->clearance_height * 8);
 
@@ -2146,6 +2140,9 @@ static sint32 peep_update_patrolling_find_watering(rct_peep * peep)
         sint32 x = peep->next_x + CoordsDirectionDelta[chosen_position].x;
         sint32 y = peep->next_y + CoordsDirectionDelta[chosen_position].y;
 
+        if (!(staff_jobs_get_tile(x / 32, y / 32) & STAFF_JOB_WATERING))
+            continue;
+
         rct_tile_element * tile_element = map_get_first_element_at(x / 32, y / 32);
 
         // This seems to happen in some SV4 files.
@@ -2214,6 +2211,9 @@ static sint32 peep_update_patrolling_find_bin(rct_peep * peep)
     if (peep->GetNextIsSurface())
         return 0;
 
+    if (!(staff_jobs_get_tile(peep->next_x / 32, peep->next_y / 32) & STAFF_JOB_EMPTYING))
+        return 0;
+
     rct_tile_element * tileElement = map_get_first_element_at(peep->next_x / 32, peep->next_y / 32);
     if (tileElement == nullptr)
         return 0;
@@ -2281,6 +2281,9 @@ static sint32 peep_update_patrolling_find_grass(rct_peep * peep)
     if (!(peep->GetNextIsSurface()))
         return 0;
 
+    if (!(staff_jobs_get_tile(peep->next_x / 32, peep->next_y / 32) & STAFF_JOB_MOWING))
+        return 0;
+
     rct_tile_element * tile_element = map_get_surface_element_at({peep->next_x, peep->next_y});
 
     if ((tile_element->properties.surface.terrain & TILE_ELEMENT_SURFACE_TERRAIN_MASK) != TERRAIN_GRASS)
@@ -2307,6 +2310,10 @@ static sint32 peep_update_patrolling_find_sweeping(rct_peep * peep)
     if (!(peep->staff_orders & STAFF_ORDERS_SWEEPING))
         return 0;
 
+    // Saves looking through the guests on busy paths
+    if (!(staff_jobs_get_tile(peep->x / 32, peep->y / 32) & STAFF_JOB_SWEEPING))
+        return 0;
+
     uint16 sprite_id = sprite_get_first_in_quadrant(peep->x, peep->y);
 
     for (rct_sprite * sprite = nullptr; sprite_id != SPRITE_INDEX_NULL; sprite_id = sprite->unknown.next_in_quadrant)
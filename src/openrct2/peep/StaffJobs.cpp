@@ -0,0 +1,248 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <array>
+#include "../world/Footpath.h"
+#include "../world/LitterIndex.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/Sprite.h"
+#include "../world/Surface.h"
+#include "Peep.h"
+#include "Staff.h"
+#include "StaffJobs.h"
+
+// This is a board of the jobs on each tile, not a queue of jobs claimed by staff. Handymen still
+// wander their patrol areas and take up the work they come across as in the original game, the
+// board only saves them looking through tiles that have none. Handing out the nearest job would
+// change where staff walk, and with it the outcome of every existing save and network game.
+
+// Cells of 4x4 tiles, the same as the cells of the staff patrol areas
+constexpr sint32 CELL_SHIFT = 2;
+constexpr sint32 CELL_SIZE = 1 << CELL_SHIFT;
+constexpr sint32 CELLS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / CELL_SIZE;
+
+// One bit for each tile of a cell, for each of the jobs found by looking through the tile elements
+struct staff_jobs_cell
+{
+    uint16 Watering;
+    uint16 Mowing;
+    uint16 Emptying;
+};
+
+// The cells are found again when next asked for after their tiles have changed
+static std::array<staff_jobs_cell, CELLS_PER_ROW * CELLS_PER_ROW> _cells;
+static std::array<bool, CELLS_PER_ROW * CELLS_PER_ROW> _cellValid;
+
+// The mechanics in the order of the peep list, which rides calling for a mechanic go through
+static std::vector<uint16> _mechanics;
+static bool _mechanicsValid;
+
+static uint32 _queries;
+static uint32 _cellsRebuilt;
+static uint32 _mechanicRebuilds;
+
+static bool staff_jobs_plant_needs_watering(const rct_tile_element * tileElement)
+{
+    // Younger plants are never watered, see peep_update_patrolling_find_watering
+    if (tileElement->properties.scenery.age < SCENERY_WITHER_AGE_THRESHOLD_1)
+        return false;
+
+    rct_scenery_entry * sceneryEntry = get_small_scenery_entry(tileElement->properties.scenery.type);
+    return sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_CAN_BE_WATERED);
+}
+
+static bool staff_jobs_grass_needs_mowing(const rct_tile_element * tileElement)
+{
+    // See peep_update_patrolling_find_grass
+    return surface_get_terrain(tileElement) == TERRAIN_GRASS &&
+        (tileElement->properties.surface.grass_length & 0x7) >= GRASS_LENGTH_CLEAR_1;
+}
+
+static bool staff_jobs_bin_needs_emptying(const rct_tile_element * tileElement)
+{
+    // See peep_update_patrolling_find_bin
+    if (!footpath_element_has_path_scenery(tileElement) || footpath_element_path_scenery_is_ghost(tileElement))
+        return false;
+    if (tileElement->flags & TILE_ELEMENT_FLAG_BROKEN)
+        return false;
+
+    rct_scenery_entry * sceneryEntry = get_footpath_item_entry(footpath_element_get_path_scenery_index(tileElement));
+    if (sceneryEntry == nullptr || !(sceneryEntry->path_bit.flags & PATH_BIT_FLAG_IS_BIN))
+        return false;
+
+    uint8 binPositions = tileElement->properties.path.edges & 0xF;
+    uint8 binQuantity = tileElement->properties.path.addition_status;
+    for (sint32 position = 0; position < 4; position++)
+    {
+        if (!(binPositions & (1 << position)) && !((binQuantity >> (position * 2)) & 3))
+            return true;
+    }
+    return false;
+}
+
+static uint8 staff_jobs_find_on_tile(sint32 x, sint32 y)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    if (tileElement == nullptr)
+        return 0;
+
+    uint8 result = 0;
+    do
+    {
+        switch (tileElement->GetType())
+        {
+        case TILE_ELEMENT_TYPE_SURFACE:
+            if (staff_jobs_grass_needs_mowing(tileElement))
+                result |= STAFF_JOB_MOWING;
+            break;
+        case TILE_ELEMENT_TYPE_PATH:
+            if (staff_jobs_bin_needs_emptying(tileElement))
+                result |= STAFF_JOB_EMPTYING;
+            break;
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            if (staff_jobs_plant_needs_watering(tileElement))
+                result |= STAFF_JOB_WATERING;
+            break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return result;
+}
+
+static void staff_jobs_build_cell(sint32 cell)
+{
+    sint32 left = (cell % CELLS_PER_ROW) << CELL_SHIFT;
+    sint32 top = (cell / CELLS_PER_ROW) << CELL_SHIFT;
+
+    staff_jobs_cell jobs = {};
+    for (sint32 y = 0; y < CELL_SIZE; y++)
+    {
+        for (sint32 x = 0; x < CELL_SIZE; x++)
+        {
+            uint8 tileJobs = staff_jobs_find_on_tile(left + x, top + y);
+            uint16 bit = 1 << (y * CELL_SIZE + x);
+            if (tileJobs & STAFF_JOB_WATERING)
+                jobs.Watering |= bit;
+            if (tileJobs & STAFF_JOB_MOWING)
+                jobs.Mowing |= bit;
+            if (tileJobs & STAFF_JOB_EMPTYING)
+                jobs.Emptying |= bit;
+        }
+    }
+    _cells[cell] = jobs;
+    _cellValid[cell] = true;
+    _cellsRebuilt++;
+}
+
+/**
+ * Gets the jobs (STAFF_JOB) a handyman patrolling the given tile could find there. Handymen only
+ * look for work on the tiles they step onto and next to, so the tiles without jobs can be passed
+ * over without looking through their elements or sprites. Tiles outside of the map are given all
+ * jobs so that they are looked through as before.
+ */
+uint8 staff_jobs_get_tile(sint32 x, sint32 y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return STAFF_JOB_ALL;
+
+    _queries++;
+    sint32 cell = (y >> CELL_SHIFT) * CELLS_PER_ROW + (x >> CELL_SHIFT);
+    if (!_cellValid[cell])
+    {
+        staff_jobs_build_cell(cell);
+    }
+
+    const staff_jobs_cell& jobs = _cells[cell];
+    uint16 bit = 1 << ((y & (CELL_SIZE - 1)) * CELL_SIZE + (x & (CELL_SIZE - 1)));
+    uint8 result = 0;
+    if (jobs.Watering & bit)
+        result |= STAFF_JOB_WATERING;
+    if (jobs.Mowing & bit)
+        result |= STAFF_JOB_MOWING;
+    if (jobs.Emptying & bit)
+        result |= STAFF_JOB_EMPTYING;
+    // Litter is kept track of as it is created and removed by the litter index
+    if (litter_index_has_on_tile(x * 32, y * 32))
+    {
+        result |= STAFF_JOB_SWEEPING;
+    }
+    return result;
+}
+
+/**
+ * Drops the jobs of the cell of the given tile, for when its elements, the age of its plants, the
+ * length of its grass or the litter in its bins have changed.
+ */
+void staff_jobs_invalidate_tile(sint32 x, sint32 y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    _cellValid[(y >> CELL_SHIFT) * CELLS_PER_ROW + (x >> CELL_SHIFT)] = false;
+}
+
+/**
+ * Drops the jobs of all tiles and the list of mechanics, to be found again when next asked for.
+ */
+void staff_jobs_invalidate_all()
+{
+    _cellValid.fill(false);
+    _mechanicsValid = false;
+}
+
+/**
+ * Gets the sprite indices of the mechanics, in the order of the peep list, so that rides calling
+ * for a mechanic do not have to go through all the guests and pick the same mechanic as before.
+ */
+const std::vector<uint16>& staff_jobs_get_mechanics()
+{
+    if (!_mechanicsValid)
+    {
+        _mechanics.clear();
+        uint16 spriteIndex;
+        rct_peep * peep;
+        FOR_ALL_STAFF(spriteIndex, peep)
+        {
+            if (peep->staff_type == STAFF_TYPE_MECHANIC)
+            {
+                _mechanics.push_back(spriteIndex);
+            }
+        }
+        _mechanicsValid = true;
+        _mechanicRebuilds++;
+    }
+    return _mechanics;
+}
+
+/**
+ * Drops the list of mechanics, for when staff are hired or fired or the peep list is reordered.
+ */
+void staff_jobs_invalidate_mechanics()
+{
+    _mechanicsValid = false;
+}
+
+staff_jobs_statistics staff_jobs_get_statistics()
+{
+    staff_jobs_statistics statistics = {};
+    statistics.Queries = _queries;
+    statistics.CellsRebuilt = _cellsRebuilt;
+    statistics.Mechanics = _mechanicsValid ? (uint32)_mechanics.size() : 0;
+    statistics.MechanicRebuilds = _mechanicRebuilds;
+    for (size_t i = 0; i < _cellValid.size(); i++)
+    {
+        const staff_jobs_cell& jobs = _cells[i];
+        if (_cellValid[i] && (jobs.Watering | jobs.Mowing | jobs.Emptying) != 0)
+        {
+            statistics.CellsWithJobs++;
+        }
+    }
+    return statistics;
+}
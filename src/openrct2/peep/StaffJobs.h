@@ -0,0 +1,41 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _STAFF_JOBS_H_
+#define _STAFF_JOBS_H_
+
+#include <vector>
+#include "../common.h"
+
+enum STAFF_JOB
+{
+    STAFF_JOB_SWEEPING = (1 << 0), // litter on the tile
+    STAFF_JOB_WATERING = (1 << 1), // plants on the tile old enough to be watered
+    STAFF_JOB_MOWING = (1 << 2),   // grass on the tile long enough to be mown
+    STAFF_JOB_EMPTYING = (1 << 3), // a bin on a path of the tile with a full side
+    STAFF_JOB_ALL = STAFF_JOB_SWEEPING | STAFF_JOB_WATERING | STAFF_JOB_MOWING | STAFF_JOB_EMPTYING,
+};
+
+struct staff_jobs_statistics
+{
+    uint32 Queries;
+    uint32 CellsRebuilt;
+    uint32 CellsWithJobs;
+    uint32 Mechanics;
+    uint32 MechanicRebuilds;
+};
+
+uint8 staff_jobs_get_tile(sint32 x, sint32 y);
+void staff_jobs_invalidate_tile(sint32 x, sint32 y);
+void staff_jobs_invalidate_all();
+const std::vector<uint16>& staff_jobs_get_mechanics();
+void staff_jobs_invalidate_mechanics();
+staff_jobs_statistics staff_jobs_get_statistics();
+
+#endif
@@ -210,6 +210,7 @@ public:
         //game_convert_strings_to_utf8();
         game_convert_news_items_to_utf8();
         map_count_remaining_land_rights();
+        park_size_invalidate();
     }
 
     bool GetDetails(scenario_index_entry * dst) override
@@ -1320,7 +1321,7 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite * sprite = get_sprite(i);
             if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <stdexcept>
 #include "../common.h"
 #include "../config/Config.h"
 #include "../Context.h"
@@ -44,6 +45,7 @@
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
+#include "../world/Map.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
 #include "../world/Sprite.h"
@@ -188,7 +190,7 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.tile_elements, gTileElements, sizeof(_s6.tile_elements));
+    ExportTileElements();
 
     _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
     // Sprites needs to be reset before they get used.
@@ -196,16 +198,7 @@ void S6Exporter::Export()
     // compression ratios. Especially useful for multiplayer servers that
     // use zlib on the sent stream.
     sprite_clear_all_unused();
-    for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
-    {
-        memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
-    }
-
-    for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
-    {
-        _s6.sprite_lists_head[i]  = gSpriteListHead[i];
-        _s6.sprite_lists_count[i] = gSpriteListCount[i];
-    }
+    ExportSprites();
     _s6.park_name = gParkName;
     // pad_013573D6
     _s6.park_name_args    = gParkNameArgs;
@@ -415,10 +408,237 @@ void S6Exporter::Export()
         scenario_remove_trackless_rides(&_s6);
     }
 
+    RemapSpriteIndices();
+
     scenario_fix_ghosts(&_s6);
     game_convert_strings_to_rct2(&_s6);
 }
 
+void S6Exporter::ExportTileElements()
+{
+    // Tiles are saved in order, which is how they are found again when the park is loaded
+    rct_tile_element * dst = _s6.tile_elements;
+    rct_tile_element * dstEnd = std::end(_s6.tile_elements);
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const rct_tile_element * src = map_get_first_element_at(x, y);
+            do
+            {
+                if (dst == dstEnd)
+                {
+                    throw std::runtime_error("Too many map elements in use to save the park.");
+                }
+                *dst++ = *src;
+            }
+            while (!(src++)->IsLastForTile());
+        }
+    }
+    std::fill(dst, dstEnd, rct_tile_element{});
+}
+
+void S6Exporter::ExportSprites()
+{
+    _spriteIndexMap.clear();
+    if (sprite_get_capacity() <= RCT2_MAX_SPRITES)
+    {
+        for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
+        {
+            memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
+        }
+
+        for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
+        {
+            _s6.sprite_lists_head[i]  = gSpriteListHead[i];
+            _s6.sprite_lists_count[i] = gSpriteListCount[i];
+        }
+        return;
+    }
+
+    // The sprite store has grown past what the saved game holds, so the sprites past it are moved
+    // into the unused slots before it and every saved sprite index is mapped to the new slot.
+    size_t capacity = sprite_get_capacity();
+    std::vector<bool> slotUsed(RCT2_MAX_SPRITES, false);
+    size_t numUsed = 0;
+    for (sint32 list = 0; list < NUM_SPRITE_LISTS; list++)
+    {
+        if (list == SPRITE_LIST_NULL)
+            continue;
+
+        for (uint16 i = gSpriteListHead[list]; i != SPRITE_INDEX_NULL; i = get_sprite(i)->unknown.next)
+        {
+            if (i < RCT2_MAX_SPRITES)
+            {
+                slotUsed[i] = true;
+            }
+            numUsed++;
+        }
+    }
+    if (numUsed > RCT2_MAX_SPRITES)
+    {
+        throw std::runtime_error("Too many sprites in use to save the park.");
+    }
+
+    _spriteIndexMap.assign(capacity, SPRITE_INDEX_NULL);
+    size_t nextFreeSlot = 0;
+    for (sint32 list = 0; list < NUM_SPRITE_LISTS; list++)
+    {
+        if (list == SPRITE_LIST_NULL)
+            continue;
+
+        uint16 previous = SPRITE_INDEX_NULL;
+        _s6.sprite_lists_head[list] = SPRITE_INDEX_NULL;
+        _s6.sprite_lists_count[list] = 0;
+        for (uint16 i = gSpriteListHead[list]; i != SPRITE_INDEX_NULL; i = get_sprite(i)->unknown.next)
+        {
+            uint16 slot = i;
+            if (i >= RCT2_MAX_SPRITES)
+            {
+                while (slotUsed[nextFreeSlot])
+                {
+                    nextFreeSlot++;
+                }
+                slot = (uint16)nextFreeSlot;
+                slotUsed[slot] = true;
+            }
+            _spriteIndexMap[i] = slot;
+
+            rct_sprite * dst = &_s6.sprites[slot];
+            memcpy(dst, get_sprite(i), sizeof(rct_sprite));
+            dst->unknown.sprite_index = slot;
+            dst->unknown.previous = previous;
+            dst->unknown.next = SPRITE_INDEX_NULL;
+            if (previous == SPRITE_INDEX_NULL)
+            {
+                _s6.sprite_lists_head[list] = slot;
+            }
+            else
+            {
+                _s6.sprites[previous].unknown.next = slot;
+            }
+            previous = slot;
+            _s6.sprite_lists_count[list]++;
+        }
+    }
+
+    // The unused slots are linked in order, as they are after the sprites are reset
+    uint16 previous = SPRITE_INDEX_NULL;
+    _s6.sprite_lists_head[SPRITE_LIST_NULL] = SPRITE_INDEX_NULL;
+    _s6.sprite_lists_count[SPRITE_LIST_NULL] = 0;
+    for (uint16 slot = 0; slot < RCT2_MAX_SPRITES; slot++)
+    {
+        if (slotUsed[slot])
+            continue;
+
+        rct_sprite * dst = &_s6.sprites[slot];
+        memset(dst, 0, sizeof(rct_sprite));
+        dst->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        dst->unknown.sprite_index = slot;
+        dst->unknown.linked_list_type_offset = SPRITE_LIST_NULL * 2;
+        dst->unknown.next_in_quadrant = SPRITE_INDEX_NULL;
+        dst->unknown.previous = previous;
+        dst->unknown.next = SPRITE_INDEX_NULL;
+        if (previous == SPRITE_INDEX_NULL)
+        {
+            _s6.sprite_lists_head[SPRITE_LIST_NULL] = slot;
+        }
+        else
+        {
+            _s6.sprites[previous].unknown.next = slot;
+        }
+        previous = slot;
+        _s6.sprite_lists_count[SPRITE_LIST_NULL]++;
+    }
+}
+
+uint16 S6Exporter::MapSpriteIndex(uint16 spriteIndex) const
+{
+    if (spriteIndex >= _spriteIndexMap.size())
+        return spriteIndex;
+
+    uint16 mapped = _spriteIndexMap[spriteIndex];
+    if (mapped == SPRITE_INDEX_NULL && spriteIndex < RCT2_MAX_SPRITES)
+    {
+        // Unused sprites keep their slot
+        return spriteIndex;
+    }
+    return mapped;
+}
+
+/**
+ * Maps the sprite indices held by the saved sprites, rides and news items to where the sprites
+ * were moved to by ExportSprites.
+ */
+void S6Exporter::RemapSpriteIndices()
+{
+    if (_spriteIndexMap.empty())
+        return;
+
+    std::vector<bool> isCableLift(RCT2_MAX_SPRITES, false);
+    for (auto& ride : _s6.rides)
+    {
+        if (ride.type == RIDE_TYPE_NULL)
+            continue;
+
+        for (auto& vehicle : ride.vehicles)
+        {
+            vehicle = MapSpriteIndex(vehicle);
+        }
+        for (auto& peep : ride.last_peep_in_queue)
+        {
+            peep = MapSpriteIndex(peep);
+        }
+        ride.mechanic = MapSpriteIndex(ride.mechanic);
+        ride.race_winner = MapSpriteIndex(ride.race_winner);
+        ride.cable_lift = MapSpriteIndex(ride.cable_lift);
+        if (ride.cable_lift < RCT2_MAX_SPRITES)
+        {
+            isCableLift[ride.cable_lift] = true;
+        }
+        if (ride.type == RIDE_TYPE_SPIRAL_SLIDE && ride.slide_in_use)
+        {
+            ride.slide_peep = MapSpriteIndex(ride.slide_peep);
+        }
+    }
+
+    for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
+    {
+        rct_sprite * sprite = &_s6.sprites[i];
+        if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL)
+            continue;
+
+        sprite->unknown.next_in_quadrant = MapSpriteIndex(sprite->unknown.next_in_quadrant);
+        if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+        {
+            rct_vehicle * vehicle = &sprite->vehicle;
+            vehicle->next_vehicle_on_train = MapSpriteIndex(vehicle->next_vehicle_on_train);
+            vehicle->prev_vehicle_on_ride = MapSpriteIndex(vehicle->prev_vehicle_on_ride);
+            vehicle->next_vehicle_on_ride = MapSpriteIndex(vehicle->next_vehicle_on_ride);
+            for (auto& peep : vehicle->peep)
+            {
+                peep = MapSpriteIndex(peep);
+            }
+            if (isCableLift[i])
+            {
+                vehicle->cable_lift_target = MapSpriteIndex(vehicle->cable_lift_target);
+            }
+        }
+        else if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP && sprite->peep.type == PEEP_TYPE_GUEST)
+        {
+            sprite->peep.next_in_queue = MapSpriteIndex(sprite->peep.next_in_queue);
+        }
+    }
+
+    for (auto& newsItem : _s6.news_items)
+    {
+        if (newsItem.Type == NEWS_ITEM_PEEP_ON_RIDE || newsItem.Type == NEWS_ITEM_PEEP)
+        {
+            newsItem.Assoc = MapSpriteIndex((uint16)newsItem.Assoc);
+        }
+    }
+}
+
 void S6Exporter::ExportPeepSpawns()
 {
     for (size_t i = 0; i < RCT12_MAX_PEEP_SPAWNS; i++)
@@ -790,8 +1010,9 @@ sint32 scenario_save(const utf8 * path, sint32 flags)
         }
         result = true;
     }
-    catch (const std::exception &)
+    catch (const std::exception & e)
     {
+        log_error("Unable to save park: '%s'", e.what());
     }
     delete s6exporter;
 
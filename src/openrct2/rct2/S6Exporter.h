@@ -38,6 +38,8 @@ public:
 
 private:
     rct_s6_data _s6{};
+    // Where each sprite is moved to when the sprite store has grown past the saved sprites
+    std::vector<uint16> _spriteIndexMap;
 
     void Save(IStream * stream, bool isScenario);
     static uint32 GetLoanHash(money32 initialCash, money32 bankLoan, uint32 maxBankLoan);
@@ -46,4 +48,8 @@ private:
     void ExportResearchedSceneryItems();
     void ExportResearchList();
     void ExportPeepSpawns();
+    void ExportTileElements();
+    void ExportSprites();
+    uint16 MapSpriteIndex(uint16 spriteIndex) const;
+    void RemapSpriteIndices();
 };
@@ -203,6 +203,7 @@ public:
         memcpy(gTileElements, _s6.tile_elements, sizeof(_s6.tile_elements));
 
         gNextFreeTileElementPointerIndex = _s6.next_free_tile_element_pointer_index;
+        sprite_reset_capacity();
         for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
         {
             memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
@@ -438,6 +439,7 @@ public:
         map_update_tile_pointers();
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
+        park_size_invalidate();
         determine_ride_entrance_and_exit_locations();
 
         // We try to fix the cycles on import, hence the 'true' parameter
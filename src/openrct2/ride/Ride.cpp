@@ -31,8 +31,10 @@
 #include "../object/ObjectManager.h"
 #include "../OpenRCT2.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/GuestStore.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
+#include "../peep/StaffJobs.h"
 #include "../rct1/RCT1.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
@@ -1166,6 +1168,7 @@ void ride_remove_peeps(sint32 rideIndex)
             peep->happiness = Math::Min(peep->happiness, peep->happiness_target) / 2;
             peep->happiness_target = peep->happiness;
             peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
+            guest_store_update(peep);
         }
     }
 
@@ -2714,13 +2717,11 @@ rct_peep *ride_find_closest_mechanic(Ride *ride, sint32 forInspection)
 rct_peep *find_closest_mechanic(sint32 x, sint32 y, sint32 forInspection)
 {
     uint32 closestDistance, distance;
-    uint16 spriteIndex;
-    rct_peep *peep, *closestMechanic = nullptr;
+    rct_peep *closestMechanic = nullptr;
 
     closestDistance = UINT_MAX;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
+    for (uint16 spriteIndex : staff_jobs_get_mechanics()) {
+        rct_peep *peep = GET_PEEP(spriteIndex);
 
         if (!forInspection) {
             if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
@@ -4496,7 +4497,7 @@ static void ride_set_start_finish_points(sint32 rideIndex, CoordsXYE *startEleme
 static sint32 count_free_misc_sprite_slots()
 {
     sint32 miscSpriteCount = gSpriteListCount[SPRITE_LIST_MISC];
-    sint32 remainingSpriteCount = gSpriteListCount[SPRITE_LIST_NULL];
+    sint32 remainingSpriteCount = (sint32)sprite_get_num_free();
     return Math::Max(0, miscSpriteCount + remainingSpriteCount - 300);
 }
 
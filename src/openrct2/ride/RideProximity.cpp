@@ -0,0 +1,169 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "../world/Map.h"
+#include "Ride.h"
+#include "RideProximity.h"
+#include "Track.h"
+
+// Cells of 8x8 tiles
+constexpr sint32 CELL_SHIFT = 3;
+constexpr sint32 CELL_SIZE = 1 << CELL_SHIFT;
+constexpr sint32 CELLS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / CELL_SIZE;
+constexpr sint32 RIDE_WORDS = (MAX_RIDES + 31) / 32;
+
+/**
+ * The rides with track in a cell. Rides lists the rides of the whole cell, Tracks the ride of each
+ * tile, as the tile within the cell in the upper byte and the ride index in the lower byte, for
+ * when only part of the cell is near.
+ */
+struct ride_proximity_cell
+{
+    uint32              Rides[RIDE_WORDS];
+    std::vector<uint16> Tracks;
+    bool                Valid;
+};
+
+// Guests only choose rides on the main thread, so there is no locking
+static std::array<ride_proximity_cell, CELLS_PER_ROW * CELLS_PER_ROW> _cells;
+static uint32 _queries;
+static uint32 _cellsRebuilt;
+static uint32 _cellsMerged;
+static uint32 _cellsScanned;
+
+static void ride_proximity_build_cell(ride_proximity_cell& cell, sint32 cellX, sint32 cellY)
+{
+    std::fill(std::begin(cell.Rides), std::end(cell.Rides), 0);
+    cell.Tracks.clear();
+    for (sint32 y = 0; y < CELL_SIZE; y++)
+    {
+        for (sint32 x = 0; x < CELL_SIZE; x++)
+        {
+            rct_tile_element * tileElement = map_get_first_element_at((cellX << CELL_SHIFT) + x, (cellY << CELL_SHIFT) + y);
+            if (tileElement == nullptr)
+                continue;
+
+            uint16 tile = (uint16)((y * CELL_SIZE + x) << 8);
+            size_t tileStart = cell.Tracks.size();
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
+                    continue;
+
+                sint32 rideIndex = track_element_get_ride_index(tileElement);
+                cell.Rides[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+
+                uint16 track = tile | (uint16)rideIndex;
+                if (std::find(cell.Tracks.begin() + tileStart, cell.Tracks.end(), track) == cell.Tracks.end())
+                {
+                    cell.Tracks.push_back(track);
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+    cell.Valid = true;
+    _cellsRebuilt++;
+}
+
+/**
+ * Adds the rides with track on the tiles of the given area, inclusive, to the given set of
+ * rides, a bit for each ride index.
+ */
+void ride_proximity_get_rides_in(sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 * rides)
+{
+    _queries++;
+
+    left = std::max(0, left);
+    top = std::max(0, top);
+    right = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, right);
+    bottom = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, bottom);
+    if (left > right || top > bottom)
+        return;
+
+    for (sint32 cellY = top >> CELL_SHIFT; cellY <= bottom >> CELL_SHIFT; cellY++)
+    {
+        for (sint32 cellX = left >> CELL_SHIFT; cellX <= right >> CELL_SHIFT; cellX++)
+        {
+            ride_proximity_cell& cell = _cells[cellY * CELLS_PER_ROW + cellX];
+            if (!cell.Valid)
+            {
+                ride_proximity_build_cell(cell, cellX, cellY);
+            }
+
+            // The tiles of the cell that are near
+            sint32 cellLeft = std::max(left - (cellX << CELL_SHIFT), 0);
+            sint32 cellTop = std::max(top - (cellY << CELL_SHIFT), 0);
+            sint32 cellRight = std::min(right - (cellX << CELL_SHIFT), CELL_SIZE - 1);
+            sint32 cellBottom = std::min(bottom - (cellY << CELL_SHIFT), CELL_SIZE - 1);
+            if (cellLeft == 0 && cellTop == 0 && cellRight == CELL_SIZE - 1 && cellBottom == CELL_SIZE - 1)
+            {
+                for (sint32 i = 0; i < RIDE_WORDS; i++)
+                {
+                    rides[i] |= cell.Rides[i];
+                }
+                _cellsMerged++;
+            }
+            else
+            {
+                for (uint16 track : cell.Tracks)
+                {
+                    sint32 tileX = (track >> 8) % CELL_SIZE;
+                    sint32 tileY = (track >> 8) / CELL_SIZE;
+                    if (tileX >= cellLeft && tileX <= cellRight && tileY >= cellTop && tileY <= cellBottom)
+                    {
+                        sint32 rideIndex = track & 0xFF;
+                        rides[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+                    }
+                }
+                _cellsScanned++;
+            }
+        }
+    }
+}
+
+/**
+ * Adds the rides with track on the tiles no further than the given radius from the given tile
+ * along either axis to the given set of rides.
+ */
+void ride_proximity_get_rides_near(sint32 x, sint32 y, sint32 radius, uint32 * rides)
+{
+    ride_proximity_get_rides_in(x - radius, y - radius, x + radius, y + radius, rides);
+}
+
+void ride_proximity_invalidate_tile(sint32 x, sint32 y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    _cells[(y >> CELL_SHIFT) * CELLS_PER_ROW + (x >> CELL_SHIFT)].Valid = false;
+}
+
+/**
+ * Drops all cells, to be rebuilt when next near a guest, for when tiles may have changed anywhere.
+ */
+void ride_proximity_invalidate_all()
+{
+    for (auto& cell : _cells)
+    {
+        cell.Valid = false;
+    }
+}
+
+ride_proximity_statistics ride_proximity_get_statistics()
+{
+    ride_proximity_statistics statistics = {};
+    statistics.Queries = _queries;
+    statistics.CellsRebuilt = _cellsRebuilt;
+    statistics.CellsMerged = _cellsMerged;
+    statistics.CellsScanned = _cellsScanned;
+    return statistics;
+}
@@ -0,0 +1,29 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _RIDE_PROXIMITY_H_
+#define _RIDE_PROXIMITY_H_
+
+#include "../common.h"
+
+struct ride_proximity_statistics
+{
+    uint32 Queries;
+    uint32 CellsRebuilt;
+    uint32 CellsMerged;
+    uint32 CellsScanned;
+};
+
+void ride_proximity_get_rides_in(sint32 left, sint32 top, sint32 right, sint32 bottom, uint32 * rides);
+void ride_proximity_get_rides_near(sint32 x, sint32 y, sint32 radius, uint32 * rides);
+void ride_proximity_invalidate_tile(sint32 x, sint32 y);
+void ride_proximity_invalidate_all();
+ride_proximity_statistics ride_proximity_get_statistics();
+
+#endif
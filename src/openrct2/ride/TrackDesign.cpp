@@ -45,6 +45,7 @@ struct map_backup
     rct_tile_element tile_elements[MAX_TILE_ELEMENTS];
     rct_tile_element * tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
     rct_tile_element * next_free_tile_element;
+    TileElementBlocks tile_element_blocks;
     uint16          map_size_units;
     uint16          map_size_units_minus_2;
     uint16          map_size;
@@ -2329,7 +2330,7 @@ void track_design_draw_preview(rct_track_td6 * td6, uint8 * pixels)
  */
 static map_backup * track_design_preview_backup_map()
 {
-    map_backup * backup = (map_backup *) malloc(sizeof(map_backup));
+    map_backup * backup = new (std::nothrow) map_backup();
     if (backup != nullptr)
     {
         memcpy(
@@ -2343,6 +2344,7 @@ static map_backup * track_design_preview_backup_map()
             sizeof(backup->tile_pointers)
         );
         backup->next_free_tile_element  = gNextFreeTileElement;
+        backup->tile_element_blocks     = map_take_tile_element_blocks();
         backup->map_size_units         = gMapSizeUnits;
         backup->map_size_units_minus_2 = gMapSizeMinus2;
         backup->map_size               = gMapSize;
@@ -2368,12 +2370,16 @@ static void track_design_preview_restore_map(map_backup * backup)
         sizeof(backup->tile_pointers)
     );
     gNextFreeTileElement = backup->next_free_tile_element;
+    map_restore_tile_element_blocks(std::move(backup->tile_element_blocks));
     gMapSizeUnits       = backup->map_size_units;
     gMapSizeMinus2      = backup->map_size_units_minus_2;
     gMapSize            = backup->map_size;
     gCurrentRotation    = backup->current_rotation;
 
-    free(backup);
+    // The preview was built on a map of its own
+    map_derived_data_invalidate_all();
+
+    delete backup;
 }
 
 /**
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include "Ambience.h"
+#include "Footpath.h"
+#include "Map.h"
+#include "Scenery.h"
+
+// Cells of 8x8 tiles, the unit the counts of tiles are rebuilt in
+constexpr sint32 CELL_SHIFT = 3;
+constexpr sint32 CELL_SIZE = 1 << CELL_SHIFT;
+constexpr sint32 CELLS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / CELL_SIZE;
+constexpr sint32 SUMS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL + 1;
+
+struct ambience_tile
+{
+    uint16 Scenery;
+    uint16 Fountains;
+    uint16 BrokenItems;
+    uint16 MissingItems;
+};
+
+// The counts of each tile, and the summed-area table of them: the sums of all tiles above and to
+// the left of each tile, with an extra row and column of zeroes so any area is four reads.
+// Guests only think on the main thread, so there is no locking.
+static std::array<ambience_tile, MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _tiles;
+static std::array<ambience_counts, SUMS_PER_ROW * SUMS_PER_ROW> _sums;
+static std::array<bool, CELLS_PER_ROW * CELLS_PER_ROW> _cellValid;
+
+// The first row of tiles the summed-area table is out of date from
+static sint32 _dirtyRow;
+
+static uint32 _queries;
+static uint32 _tilesRebuilt;
+static uint32 _rowsSummed;
+
+static ambience_tile ambience_count_tile(sint32 x, sint32 y)
+{
+    ambience_tile result = {};
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    if (tileElement == nullptr)
+        return result;
+
+    do
+    {
+        switch (tileElement->GetType())
+        {
+        case TILE_ELEMENT_TYPE_PATH:
+        {
+            if (!footpath_element_has_path_scenery(tileElement))
+                break;
+
+            rct_scenery_entry * scenery = get_footpath_item_entry(footpath_element_get_path_scenery_index(tileElement));
+            if (scenery == nullptr)
+            {
+                result.MissingItems++;
+                break;
+            }
+            if (footpath_element_path_scenery_is_ghost(tileElement))
+                break;
+
+            if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
+            {
+                result.Fountains++;
+                break;
+            }
+            if (tileElement->flags & TILE_ELEMENT_FLAG_BROKEN)
+            {
+                result.BrokenItems++;
+            }
+            break;
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            result.Scenery++;
+            break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return result;
+}
+
+static void ambience_update()
+{
+    if (_dirtyRow >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    for (sint32 cellY = _dirtyRow >> CELL_SHIFT; cellY < CELLS_PER_ROW; cellY++)
+    {
+        for (sint32 cellX = 0; cellX < CELLS_PER_ROW; cellX++)
+        {
+            if (_cellValid[cellY * CELLS_PER_ROW + cellX])
+                continue;
+
+            for (sint32 y = cellY << CELL_SHIFT; y < (cellY + 1) << CELL_SHIFT; y++)
+            {
+                for (sint32 x = cellX << CELL_SHIFT; x < (cellX + 1) << CELL_SHIFT; x++)
+                {
+                    _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = ambience_count_tile(x, y);
+                }
+            }
+            _cellValid[cellY * CELLS_PER_ROW + cellX] = true;
+            _tilesRebuilt += CELL_SIZE * CELL_SIZE;
+        }
+    }
+
+    for (sint32 y = _dirtyRow; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        ambience_counts rowSum = {};
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const ambience_tile& tile = _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+            rowSum.Scenery += tile.Scenery;
+            rowSum.Fountains += tile.Fountains;
+            rowSum.BrokenItems += tile.BrokenItems;
+            rowSum.MissingItems += tile.MissingItems;
+
+            const ambience_counts& above = _sums[y * SUMS_PER_ROW + x + 1];
+            ambience_counts& sum = _sums[(y + 1) * SUMS_PER_ROW + x + 1];
+            sum.Scenery = above.Scenery + rowSum.Scenery;
+            sum.Fountains = above.Fountains + rowSum.Fountains;
+            sum.BrokenItems = above.BrokenItems + rowSum.BrokenItems;
+            sum.MissingItems = above.MissingItems + rowSum.MissingItems;
+        }
+    }
+    _rowsSummed += MAXIMUM_MAP_SIZE_TECHNICAL - _dirtyRow;
+    _dirtyRow = MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+/**
+ * Gets the counts of the tiles of the given area, inclusive.
+ */
+ambience_counts ambience_get_counts(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    _queries++;
+    ambience_update();
+
+    left = std::max(0, left);
+    top = std::max(0, top);
+    right = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, right);
+    bottom = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, bottom);
+    if (left > right || top > bottom)
+        return {};
+
+    const ambience_counts& a = _sums[top * SUMS_PER_ROW + left];
+    const ambience_counts& b = _sums[top * SUMS_PER_ROW + right + 1];
+    const ambience_counts& c = _sums[(bottom + 1) * SUMS_PER_ROW + left];
+    const ambience_counts& d = _sums[(bottom + 1) * SUMS_PER_ROW + right + 1];
+
+    ambience_counts result;
+    result.Scenery = d.Scenery - b.Scenery - c.Scenery + a.Scenery;
+    result.Fountains = d.Fountains - b.Fountains - c.Fountains + a.Fountains;
+    result.BrokenItems = d.BrokenItems - b.BrokenItems - c.BrokenItems + a.BrokenItems;
+    result.MissingItems = d.MissingItems - b.MissingItems - c.MissingItems + a.MissingItems;
+    return result;
+}
+
+void ambience_invalidate_tile(sint32 x, sint32 y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    _cellValid[(y >> CELL_SHIFT) * CELLS_PER_ROW + (x >> CELL_SHIFT)] = false;
+    _dirtyRow = std::min(_dirtyRow, (y >> CELL_SHIFT) << CELL_SHIFT);
+}
+
+/**
+ * Drops the counts of all tiles, to be counted again when next asked for.
+ */
+void ambience_invalidate_all()
+{
+    _cellValid.fill(false);
+    _dirtyRow = 0;
+}
+
+ambience_statistics ambience_get_statistics()
+{
+    ambience_statistics statistics = {};
+    statistics.Queries = _queries;
+    statistics.TilesRebuilt = _tilesRebuilt;
+    statistics.RowsSummed = _rowsSummed;
+    return statistics;
+}
@@ -0,0 +1,38 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _AMBIENCE_H_
+#define _AMBIENCE_H_
+
+#include "../common.h"
+
+/**
+ * What guests take in of an area of the map when thinking about their surroundings.
+ */
+struct ambience_counts
+{
+    uint32 Scenery;      // small and large scenery elements
+    uint32 Fountains;    // jumping fountains on paths
+    uint32 BrokenItems;  // vandalised path items other than fountains
+    uint32 MissingItems; // path items whose object is not loaded
+};
+
+struct ambience_statistics
+{
+    uint32 Queries;
+    uint32 TilesRebuilt;
+    uint32 RowsSummed;
+};
+
+ambience_counts ambience_get_counts(sint32 left, sint32 top, sint32 right, sint32 bottom);
+void ambience_invalidate_tile(sint32 x, sint32 y);
+void ambience_invalidate_all();
+ambience_statistics ambience_get_statistics();
+
+#endif
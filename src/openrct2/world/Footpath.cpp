@@ -20,10 +20,15 @@
 #include "../object/ObjectManager.h"
 #include "../OpenRCT2.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/StaffJobs.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
+#include "Ambience.h"
+#include "FootpathConnectivity.h"
+#include "FootpathGraph.h"
+#include "LitterIndex.h"
 #include "Map.h"
 #include "Park.h"
 #include "Sprite.h"
@@ -297,6 +302,10 @@ static money32 footpath_element_insert(sint32 type, sint32 x, sint32 y, sint32 z
 
 static money32 footpath_element_update(sint32 x, sint32 y, rct_tile_element *tileElement, sint32 type, sint32 flags, uint8 pathItemType)
 {
+    // The path additions are changed in place
+    if (flags & GAME_COMMAND_FLAG_APPLY)
+        ambience_invalidate_tile(x / 32, y / 32);
+
     const sint32 newFootpathType = (type & (FOOTPATH_PROPERTIES_TYPE_MASK >> 4));
     const bool   newPathIsQueue  = ((type >> 7) == 1);
 
@@ -982,18 +991,12 @@ void footpath_bridge_get_info_from_pos(sint32 screenX, sint32 screenY, sint32 *x
  */
 void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
 {
-    uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL) {
-        rct_litter *sprite = &get_sprite(spriteIndex)->litter;
-        uint16 nextSpriteIndex = sprite->next_in_quadrant;
-        if (sprite->linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-            sint32 distanceZ = abs(sprite->z - z);
-            if (distanceZ <= 32) {
-                invalidate_sprite_0((rct_sprite*)sprite);
-                sprite_remove((rct_sprite*)sprite);
-            }
+    for (rct_litter *litter : litter_index_get_on_tile(x, y)) {
+        sint32 distanceZ = abs(litter->z - z);
+        if (distanceZ <= 32) {
+            invalidate_sprite_0((rct_sprite*)litter);
+            sprite_remove((rct_sprite*)litter);
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
@@ -1451,6 +1454,26 @@ static void loc_6A6C85(
     loc_6A6D7E(x, y, z, direction, tileElement, flags, query, neighbourList);
 }
 
+/**
+ * Drops the footpath navigation graph segments and the staff jobs of the given tile and its
+ * neighbours, whose edges are connected to or removed from the tile. Handymen only empty the
+ * bins on the sides without an edge.
+ * @param x x-coordinate in units (not tiles)
+ * @param y y-coordinate in units (not tiles)
+ */
+static void footpath_invalidate_edges_around(sint32 x, sint32 y)
+{
+    footpath_graph_invalidate_tile(x / 32, y / 32);
+    staff_jobs_invalidate_tile(x / 32, y / 32);
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        sint32 neighbourX = (x + CoordsDirectionDelta[direction].x) / 32;
+        sint32 neighbourY = (y + CoordsDirectionDelta[direction].y) / 32;
+        footpath_graph_invalidate_tile(neighbourX, neighbourY);
+        staff_jobs_invalidate_tile(neighbourX, neighbourY);
+    }
+}
+
 /**
  *
  *  rct2: 0x006A6C66
@@ -1460,6 +1483,8 @@ void footpath_connect_edges(sint32 x, sint32 y, rct_tile_element *tileElement, s
     rct_neighbour_list neighbourList;
     rct_neighbour neighbour;
 
+
+    footpath_invalidate_edges_around(x, y);
     footpath_update_queue_chains();
 
     neighbour_list_init(&neighbourList);
@@ -1710,6 +1735,62 @@ static bool get_next_direction(sint32 edges, sint32 *direction)
     return true;
 }
 
+/**
+ * Finds the path element a search for the map edge walks onto when entering the tile at the given
+ * world coordinates in the given direction at the given height, or nullptr if there is none.
+ */
+rct_tile_element * footpath_search_get_element(sint32 x, sint32 y, sint32 z, sint32 direction, bool allowQueues)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
+    do {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+
+        sint32 slopeDirection;
+        if (
+            footpath_element_is_sloped(tileElement) &&
+            (slopeDirection = footpath_element_get_slope_direction(tileElement)) != direction
+        ) {
+            if ((slopeDirection ^ 2) != direction) continue;
+            if (tileElement->base_height + 2 != z) continue;
+        } else if (tileElement->base_height != z) {
+            continue;
+        }
+
+        if (!allowQueues && footpath_element_is_queue(tileElement))
+            continue;
+
+        return tileElement;
+    } while (!(tileElement++)->IsLastForTile());
+    return nullptr;
+}
+
+/**
+ * Gets the edges a search for the map edge can leave the given path element by, which unless
+ * ignored excludes those closed by no entry signs.
+ */
+uint8 footpath_search_get_exit_edges(const rct_tile_element * tileElement, bool ignoreNoEntry)
+{
+    uint8 edges = tileElement->properties.path.edges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK;
+    if (!ignoreNoEntry) {
+        if (tileElement[1].type == TILE_ELEMENT_TYPE_BANNER) {
+            for (sint32 i = 1; i < 4; i++) {
+                if ((&tileElement[i - 1])->IsLastForTile()) break;
+                if (tileElement[i].type != TILE_ELEMENT_TYPE_BANNER) break;
+                edges &= tileElement[i].properties.banner.flags;
+            }
+        }
+        if (tileElement[2].type == TILE_ELEMENT_TYPE_BANNER && tileElement[1].type != TILE_ELEMENT_TYPE_PATH) {
+            for (sint32 i = 1; i < 6; i++) {
+                if ((&tileElement[i - 1])->IsLastForTile()) break;
+                if (tileElement[i].type != TILE_ELEMENT_TYPE_BANNER) break;
+                edges &= tileElement[i].properties.banner.flags;
+            }
+        }
+    }
+    return edges;
+}
+
 /**
  *
  *  rct2: 0x0069AC1A
@@ -1722,7 +1803,7 @@ static sint32 footpath_is_connected_to_map_edge_recurse(
     sint32 level, sint32 distanceFromJunction, sint32 junctionTolerance
 ) {
     rct_tile_element *tileElement;
-    sint32 edges, slopeDirection;
+    sint32 edges;
 
     x += CoordsDirectionDelta[direction].x;
     y += CoordsDirectionDelta[direction].y;
@@ -1735,53 +1816,16 @@ static sint32 footpath_is_connected_to_map_edge_recurse(
     if (x >= gMapSizeUnits || y >= gMapSizeUnits)
         return FOOTPATH_SEARCH_SUCCESS;
 
-    tileElement = map_get_first_element_at(x >> 5, y >> 5);
-    do {
-        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
-            continue;
-
-        if (
-            footpath_element_is_sloped(tileElement) &&
-            (slopeDirection = footpath_element_get_slope_direction(tileElement)) != direction
-        ) {
-            if ((slopeDirection ^ 2) != direction) continue;
-            if (tileElement->base_height + 2 != z) continue;
-        } else if (tileElement->base_height != z) {
-            continue;
-        }
-
-        if (!(flags & (1 << 0))) {
-            if (footpath_element_is_queue(tileElement)) {
-                continue;
-            }
-        }
+    tileElement = footpath_search_get_element(x, y, z, direction, (flags & (1 << 0)) != 0);
+    if (tileElement == nullptr)
+        return level == 1 ? FOOTPATH_SEARCH_NOT_FOUND : FOOTPATH_SEARCH_INCOMPLETE;
 
-        if (flags & (1 << 5)) {
-            footpath_fix_ownership(x, y);
-        }
-        edges = tileElement->properties.path.edges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK;
-        direction ^= 2;
-        if (!(flags & (1 << 7))) {
-            if (tileElement[1].type == TILE_ELEMENT_TYPE_BANNER) {
-                for (sint32 i = 1; i < 4; i++) {
-                    if ((&tileElement[i - 1])->IsLastForTile()) break;
-                    if (tileElement[i].type != TILE_ELEMENT_TYPE_BANNER) break;
-                    edges &= tileElement[i].properties.banner.flags;
-                }
-            }
-            if (tileElement[2].type == TILE_ELEMENT_TYPE_BANNER && tileElement[1].type != TILE_ELEMENT_TYPE_PATH) {
-                for (sint32 i = 1; i < 6; i++) {
-                    if ((&tileElement[i - 1])->IsLastForTile()) break;
-                    if (tileElement[i].type != TILE_ELEMENT_TYPE_BANNER) break;
-                    edges &= tileElement[i].properties.banner.flags;
-                }
-            }
-        }
-        goto searchFromFootpath;
-    } while (!(tileElement++)->IsLastForTile());
-    return level == 1 ? FOOTPATH_SEARCH_NOT_FOUND : FOOTPATH_SEARCH_INCOMPLETE;
+    if (flags & (1 << 5)) {
+        footpath_fix_ownership(x, y);
+    }
+    edges = footpath_search_get_exit_edges(tileElement, (flags & (1 << 7)) != 0);
+    direction ^= 2;
 
-searchFromFootpath:
     // Exclude direction we came from
     z = tileElement->base_height;
     edges &= ~(1 << direction);
@@ -1826,10 +1870,34 @@ searchFromFootpath:
     }
 }
 
+/**
+ * Searches for the map edge from the given location, walking onto the path in the given direction.
+ * Unless the path is to be unowned on the way, the answer is looked up in the labels of the path
+ * that can reach the map edge, which unlike the search never gives up on a complex network.
+ * @param flags (1 << 5): Unown
+ *              (1 << 7): Ignore no entry signs
+ */
 sint32 footpath_is_connected_to_map_edge(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 flags)
 {
     flags |= (1 << 0);
-    return footpath_is_connected_to_map_edge_recurse(x, y, z, direction, flags, 0, 0, 16);
+    if (flags & (1 << 5))
+    {
+        return footpath_is_connected_to_map_edge_recurse(x, y, z, direction, flags, 0, 0, 16);
+    }
+
+    x += CoordsDirectionDelta[direction].x;
+    y += CoordsDirectionDelta[direction].y;
+    if (x < 32 || y < 32 || x >= gMapSizeUnits || y >= gMapSizeUnits)
+        return FOOTPATH_SEARCH_SUCCESS;
+
+    rct_tile_element * tileElement = footpath_search_get_element(x, y, z, direction, true);
+    if (tileElement == nullptr)
+        return FOOTPATH_SEARCH_NOT_FOUND;
+
+    TileCoordsXYZ loc = { x >> 5, y >> 5, tileElement->base_height };
+    bool ignoreNoEntry = (flags & (1 << 7)) != 0;
+    return footpath_connectivity_reaches_map_edge(loc, direction, ignoreNoEntry) ? FOOTPATH_SEARCH_SUCCESS
+                                                                                 : FOOTPATH_SEARCH_INCOMPLETE;
 }
 
 bool footpath_element_is_sloped(const rct_tile_element * tileElement)
@@ -1944,6 +2012,26 @@ void footpath_element_set_direction(rct_tile_element * tileElement, uint8 direct
 *  clears the wide footpath flag for all footpaths
 *  at location
 */
+/**
+ * Gets the wide flags of the first 32 path elements on a tile.
+ */
+static uint32 footpath_get_wide_flags(sint32 x, sint32 y)
+{
+    uint32 wideFlags = 0;
+    sint32 pathIndex = 0;
+    rct_tile_element *tileElement = map_get_first_element_at(x / 32, y / 32);
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (footpath_element_is_wide(tileElement))
+            wideFlags |= 1u << (pathIndex & 31);
+        pathIndex++;
+    }
+    while (!(tileElement++)->IsLastForTile());
+    return wideFlags;
+}
+
 static void footpath_clear_wide(sint32 x, sint32 y)
 {
     rct_tile_element *tileElement = map_get_first_element_at(x / 32, y / 32);
@@ -1996,6 +2084,10 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
     if (y > 0x1FDF)
         return;
 
+    sint32 originalX = x;
+    sint32 originalY = y;
+    uint32 oldWideFlags = footpath_get_wide_flags(originalX, originalY);
+
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -2169,6 +2261,12 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
                 footpath_element_set_wide(tileElement, true);
         }
     } while (!(tileElement++)->IsLastForTile());
+
+    // Wide paths end the segments of the footpath navigation graph
+    if (footpath_get_wide_flags(originalX, originalY) != oldWideFlags)
+    {
+        footpath_graph_invalidate_tile(originalX / 32, originalY / 32);
+    }
 }
 
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
@@ -2416,6 +2514,7 @@ void footpath_remove_edges_at(sint32 x, sint32 y, rct_tile_element *tileElement)
             return;
     }
 
+    footpath_invalidate_edges_around(x, y);
     footpath_update_queue_entrance_banner(x, y, tileElement);
 
     bool fixCorners = false;
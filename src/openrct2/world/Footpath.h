@@ -145,6 +145,8 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y);
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position);
 
 sint32 footpath_is_connected_to_map_edge(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 flags);
+rct_tile_element * footpath_search_get_element(sint32 x, sint32 y, sint32 z, sint32 direction, bool allowQueues);
+uint8 footpath_search_get_exit_edges(const rct_tile_element * tileElement, bool ignoreNoEntry);
 bool footpath_element_is_sloped(const rct_tile_element * tileElement);
 void footpath_element_set_sloped(rct_tile_element * tileElement, bool isSloped);
 uint8 footpath_element_get_slope_direction(const rct_tile_element * tileElement);
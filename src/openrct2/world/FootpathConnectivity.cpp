@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Footpath.h"
+#include "FootpathConnectivity.h"
+#include "FootpathGraph.h"
+#include "Map.h"
+
+/**
+ * Which path elements a search for the map edge (see footpath_is_connected_to_map_edge) reaches it
+ * from, for each direction the element can be walked onto in. A search only leaves a path element
+ * by the element's own edges, and no entry signs only stop it leaving, so the path forms a
+ * directed graph in which the two ends of a connection can differ. The labels are found by walking
+ * that graph backwards from the moves that leave the map.
+ *
+ * The labels are built again for the whole map once the tiles or the size of the map have changed.
+ * The only caller is the scenario editor checking its park entrances, which asks about every
+ * entrance in one go after the map was edited, so there is one build per check. Building only the
+ * part of the path that changed would need every change to a path, banner or entrance reported.
+ */
+struct footpath_connectivity_labels
+{
+    // The index of each path element, by tile and height
+    std::unordered_map<uint32, uint32> Elements;
+    // For each path element, one per direction it is walked onto in
+    std::vector<bool> ReachesMapEdge;
+    uint32 Generation;
+    sint32 MapSizeUnits;
+    bool   Valid;
+};
+
+// With and without no entry signs stopping the search
+static std::array<footpath_connectivity_labels, 2> _labels;
+static uint32 _builds;
+static uint32 _queries;
+
+static uint32 footpath_connectivity_get_key(sint32 x, sint32 y, sint32 z)
+{
+    return (uint32)(x & 0xFF) | ((uint32)(y & 0xFF) << 8) | ((uint32)(z & 0xFF) << 16);
+}
+
+static void footpath_connectivity_build(footpath_connectivity_labels& labels, bool ignoreNoEntry)
+{
+    std::vector<const rct_tile_element *> elements;
+    std::vector<TileCoordsXY> tiles;
+    labels.Elements.clear();
+
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (it.element->GetType() == TILE_ELEMENT_TYPE_PATH)
+        {
+            labels.Elements[footpath_connectivity_get_key(it.x, it.y, it.element->base_height)] = (uint32)elements.size();
+            elements.push_back(it.element);
+            tiles.push_back({ it.x, it.y });
+        }
+    } while (tile_element_iterator_next(&it));
+
+    // Each move as the state it arrives at and the state it leaves from, a state being a path
+    // element and the direction it was walked onto in
+    std::vector<std::pair<uint32, uint32>> moves;
+    std::vector<uint32> reached;
+    labels.ReachesMapEdge.assign(elements.size() * 4, false);
+    for (uint32 i = 0; i < (uint32)elements.size(); i++)
+    {
+        const rct_tile_element * pathElement = elements[i];
+        uint8 edges = footpath_search_get_exit_edges(pathElement, ignoreNoEntry);
+        for (sint32 arrivalDirection = 0; arrivalDirection < 4; arrivalDirection++)
+        {
+            uint32 state = i * 4 + arrivalDirection;
+            // The search does not go back the way it came
+            uint8 exits = edges & ~(1 << (arrivalDirection ^ 2));
+            for (sint32 direction = 0; direction < 4; direction++)
+            {
+                if (!(exits & (1 << direction)))
+                    continue;
+
+                sint32 x = tiles[i].x * 32 + CoordsDirectionDelta[direction].x;
+                sint32 y = tiles[i].y * 32 + CoordsDirectionDelta[direction].y;
+                if (x < 32 || y < 32 || x >= gMapSizeUnits || y >= gMapSizeUnits)
+                {
+                    if (!labels.ReachesMapEdge[state])
+                    {
+                        labels.ReachesMapEdge[state] = true;
+                        reached.push_back(state);
+                    }
+                    continue;
+                }
+
+                // Like the search, which raises the height when trying the direction up the slope
+                // and keeps it raised for the directions tried after that one
+                sint32 z = pathElement->base_height;
+                if (footpath_element_is_sloped(pathElement))
+                {
+                    sint32 slopeDirection = footpath_element_get_slope_direction(pathElement);
+                    if ((exits & (1 << slopeDirection)) && slopeDirection <= direction)
+                    {
+                        z += 2;
+                    }
+                }
+                const rct_tile_element * nextElement = footpath_search_get_element(x, y, z, direction, true);
+                if (nextElement != nullptr)
+                {
+                    uint32 nextIndex = labels.Elements[footpath_connectivity_get_key(x >> 5, y >> 5, nextElement->base_height)];
+                    moves.emplace_back(nextIndex * 4 + direction, state);
+                }
+            }
+        }
+    }
+
+    // Walk the moves backwards from the states that can leave the map
+    std::sort(moves.begin(), moves.end());
+    while (!reached.empty())
+    {
+        uint32 state = reached.back();
+        reached.pop_back();
+        auto from = std::lower_bound(moves.begin(), moves.end(), std::make_pair(state, (uint32)0));
+        for (; from != moves.end() && from->first == state; from++)
+        {
+            if (!labels.ReachesMapEdge[from->second])
+            {
+                labels.ReachesMapEdge[from->second] = true;
+                reached.push_back(from->second);
+            }
+        }
+    }
+
+    labels.Generation = footpath_graph_get_generation();
+    labels.MapSizeUnits = gMapSizeUnits;
+    labels.Valid = true;
+    _builds++;
+}
+
+/**
+ * Returns whether a search for the map edge reaches it from the path element at the given tile and
+ * height, having walked onto the element in the given direction. Unlike the search itself, this
+ * does not give up on large networks.
+ */
+bool footpath_connectivity_reaches_map_edge(TileCoordsXYZ loc, sint32 direction, bool ignoreNoEntry)
+{
+    auto& labels = _labels[ignoreNoEntry ? 1 : 0];
+    if (!labels.Valid || labels.Generation != footpath_graph_get_generation() || labels.MapSizeUnits != gMapSizeUnits)
+    {
+        footpath_connectivity_build(labels, ignoreNoEntry);
+    }
+    _queries++;
+
+    auto it = labels.Elements.find(footpath_connectivity_get_key(loc.x, loc.y, loc.z));
+    if (it == labels.Elements.end())
+        return false;
+
+    return labels.ReachesMapEdge[it->second * 4 + (direction & 3)];
+}
+
+footpath_connectivity_statistics footpath_connectivity_get_statistics()
+{
+    footpath_connectivity_statistics statistics = {};
+    statistics.Builds = _builds;
+    statistics.Elements = (uint32)(_labels[0].Elements.size() + _labels[1].Elements.size());
+    statistics.Queries = _queries;
+    return statistics;
+}
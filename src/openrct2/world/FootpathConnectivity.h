@@ -0,0 +1,26 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _FOOTPATH_CONNECTIVITY_H_
+#define _FOOTPATH_CONNECTIVITY_H_
+
+#include "../common.h"
+#include "Location.hpp"
+
+struct footpath_connectivity_statistics
+{
+    uint32 Builds;
+    uint32 Elements;
+    uint32 Queries;
+};
+
+bool footpath_connectivity_reaches_map_edge(TileCoordsXYZ loc, sint32 direction, bool ignoreNoEntry);
+footpath_connectivity_statistics footpath_connectivity_get_statistics();
+
+#endif
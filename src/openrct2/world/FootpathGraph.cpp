@@ -0,0 +1,234 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include "../peep/Peep.h"
+#include "../util/Util.h"
+#include "Footpath.h"
+#include "FootpathGraph.h"
+#include "Map.h"
+
+// Longer runs are split, which also stops the walk around a ring of plain tiles
+constexpr size_t MAX_SEGMENT_STEPS = 255;
+
+// Segments are also built by guests thinking on other threads (see peep_update_all). The segments
+// are only dropped on the main thread while the guests are not thinking, so the segments handed out
+// stay valid without holding the lock.
+static std::mutex _mutex;
+static std::unordered_map<uint64, footpath_graph_segment> _segments;
+// The segments that read each tile, so that they can be dropped when the tile changes
+static std::unordered_map<uint32, std::vector<uint64>> _tileSegments;
+static uint32 _numSteps;
+static bool _enabled = true;
+// Counts the changes to the footpaths, for the users of the network that keep their own data
+static uint32 _generation;
+static uint32 _hits;
+static uint32 _misses;
+
+static uint32 footpath_graph_get_tile_key(sint32 x, sint32 y)
+{
+    return (uint32)(x & 0xFFFF) | ((uint32)(y & 0xFFFF) << 16);
+}
+
+static uint64 footpath_graph_get_segment_key(TileCoordsXYZ loc, sint32 direction)
+{
+    return (uint64)footpath_graph_get_tile_key(loc.x, loc.y) | ((uint64)(loc.z & 0xFF) << 32) | ((uint64)(direction & 3) << 40);
+}
+
+/**
+ * Returns the path element of the given tile if it is a plain path tile when arriving at the
+ * given height in the given direction, i.e. the pathfinding would find exactly this path element
+ * and nothing else on the tile, and could only continue in one direction from it.
+ * This is stricter than needed where it costs little: any banner, ghost, queue or wide path
+ * makes a tile a node, so that what makes a tile plain does not depend on who is searching and
+ * cannot change without the tile being invalidated.
+ */
+static rct_tile_element * footpath_graph_get_plain_path(TileCoordsXYZ loc, sint32 direction)
+{
+    if (loc.x < 0 || loc.y < 0 || loc.x >= MAXIMUM_MAP_SIZE_TECHNICAL || loc.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return nullptr;
+
+    rct_tile_element * pathElement = nullptr;
+    rct_tile_element * tileElement = map_get_first_element_at(loc.x, loc.y);
+    if (tileElement == nullptr)
+        return nullptr;
+
+    // The same height the pathfinding checks elements against, which becomes the base height
+    // of the path once found
+    sint32 z = loc.z;
+    do
+    {
+        switch (tileElement->GetType())
+        {
+        case TILE_ELEMENT_TYPE_BANNER:
+            return nullptr;
+        case TILE_ELEMENT_TYPE_TRACK:
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+                return nullptr;
+            if (tileElement->base_height == z)
+                return nullptr;
+            break;
+        case TILE_ELEMENT_TYPE_PATH:
+            if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+                return nullptr;
+            if (!is_valid_path_z_and_direction(tileElement, z, direction))
+                break;
+            if (pathElement != nullptr)
+                return nullptr;
+            pathElement = tileElement;
+            z = tileElement->base_height;
+            break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (pathElement == nullptr || footpath_element_is_wide(pathElement) || footpath_element_is_queue(pathElement))
+        return nullptr;
+
+    uint8 edges = footpath_get_edges(pathElement);
+    if (bitcount(edges) != 2 || !(edges & (1 << (direction ^ 2))))
+        return nullptr;
+    return pathElement;
+}
+
+static void footpath_graph_add_tile_segment(sint32 x, sint32 y, uint64 segmentKey)
+{
+    auto& segmentKeys = _tileSegments[footpath_graph_get_tile_key(x, y)];
+    if (std::find(segmentKeys.begin(), segmentKeys.end(), segmentKey) == segmentKeys.end())
+    {
+        segmentKeys.push_back(segmentKey);
+    }
+}
+
+static void footpath_graph_trace(TileCoordsXYZ loc, sint32 direction, uint64 segmentKey, footpath_graph_segment& segment)
+{
+    segment.MinX = segment.MaxX = loc.x;
+    segment.MinY = segment.MaxY = loc.y;
+    while (segment.Steps.size() < MAX_SEGMENT_STEPS)
+    {
+        TileCoordsXYZ next = loc;
+        next += TileDirectionDelta[direction];
+        rct_tile_element * pathElement = footpath_graph_get_plain_path(next, direction);
+        if (pathElement == nullptr)
+            break;
+
+        footpath_graph_step step;
+        step.x = next.x;
+        step.y = next.y;
+        step.ArrivalZ = next.z;
+        step.BaseZ = pathElement->base_height;
+        step.Direction = bitscanforward(footpath_get_edges(pathElement) & ~(1 << (direction ^ 2)));
+        segment.Steps.push_back(step);
+        segment.MinX = std::min<sint16>(segment.MinX, step.x);
+        segment.MinY = std::min<sint16>(segment.MinY, step.y);
+        segment.MaxX = std::max<sint16>(segment.MaxX, step.x);
+        segment.MaxY = std::max<sint16>(segment.MaxY, step.y);
+        footpath_graph_add_tile_segment(step.x, step.y, segmentKey);
+
+        loc = { next.x, next.y, pathElement->base_height };
+        if (footpath_element_is_sloped(pathElement) && footpath_element_get_slope_direction(pathElement) == step.Direction)
+        {
+            loc.z += 2;
+        }
+        direction = step.Direction;
+    }
+    segment.End = loc;
+    segment.EndDirection = direction;
+
+    // The tile the segment stops at is read as well, a segment ending there may get longer
+    TileCoordsXYZ next = loc;
+    next += TileDirectionDelta[direction];
+    footpath_graph_add_tile_segment(next.x, next.y, segmentKey);
+}
+
+/**
+ * Gets the segment walked when leaving the given tile, at the given height, in the given direction.
+ * The tile left itself can be anything.
+ */
+const footpath_graph_segment * footpath_graph_get_segment(TileCoordsXYZ loc, sint32 direction)
+{
+    if (!_enabled)
+    {
+        // Every tile is walked to one at a time
+        static const footpath_graph_segment emptySegment = {};
+        return &emptySegment;
+    }
+
+    uint64 segmentKey = footpath_graph_get_segment_key(loc, direction);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _segments.find(segmentKey);
+    if (it != _segments.end())
+    {
+        _hits++;
+        return &it->second;
+    }
+
+    _misses++;
+    auto& segment = _segments[segmentKey];
+    footpath_graph_trace(loc, direction, segmentKey, segment);
+    _numSteps += (uint32)segment.Steps.size();
+    return &segment;
+}
+
+/**
+ * Drops the segments that pass through or stop at the given tile. Needs to be called whenever an
+ * element on the tile is added or changed in a way that matters to the pathfinding.
+ */
+void footpath_graph_invalidate_tile(sint32 x, sint32 y)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _generation++;
+    auto it = _tileSegments.find(footpath_graph_get_tile_key(x, y));
+    if (it == _tileSegments.end())
+        return;
+
+    for (uint64 segmentKey : it->second)
+    {
+        auto segment = _segments.find(segmentKey);
+        if (segment != _segments.end())
+        {
+            _numSteps -= (uint32)segment->second.Steps.size();
+            _segments.erase(segment);
+        }
+    }
+    _tileSegments.erase(it);
+}
+
+void footpath_graph_invalidate_all()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _generation++;
+    _segments.clear();
+    _tileSegments.clear();
+    _numSteps = 0;
+}
+
+uint32 footpath_graph_get_generation()
+{
+    return _generation;
+}
+
+void footpath_graph_set_enabled(bool enabled)
+{
+    _enabled = enabled;
+    footpath_graph_invalidate_all();
+}
+
+footpath_graph_statistics footpath_graph_get_statistics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    footpath_graph_statistics statistics = {};
+    statistics.Segments = (uint32)_segments.size();
+    statistics.Steps = _numSteps;
+    statistics.Hits = _hits;
+    statistics.Misses = _misses;
+    return statistics;
+}
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _FOOTPATH_GRAPH_H_
+#define _FOOTPATH_GRAPH_H_
+
+#include <vector>
+#include "../common.h"
+#include "Location.hpp"
+
+/**
+ * A tile of a segment, which a peep walking along the segment arrives at from the previous tile
+ * and leaves in Direction.
+ */
+struct footpath_graph_step
+{
+    sint16 x;
+    sint16 y;
+    uint8  ArrivalZ;
+    uint8  BaseZ;
+    uint8  Direction;
+};
+
+/**
+ * The edges of the footpath navigation graph. A segment is the run of plain path tiles walked
+ * when leaving a tile in a direction: tiles with a single non-wide, non-queue path that can
+ * only be left in one direction other than the one it was entered from, and nothing else a
+ * search could stop at. The nodes of the graph are the tiles segments end at: junctions,
+ * dead ends, wide paths, queues, ride entrances and exits, shops and park entrances.
+ */
+struct footpath_graph_segment
+{
+    std::vector<footpath_graph_step> Steps;
+
+    // The tile and height the last step is left from and the direction it is left in
+    TileCoordsXYZ End;
+    uint8         EndDirection;
+
+    // Bounds of the steps, to test quickly whether a location can be on the segment
+    sint16 MinX;
+    sint16 MinY;
+    sint16 MaxX;
+    sint16 MaxY;
+
+    bool Contains(sint32 x, sint32 y) const
+    {
+        return x >= MinX && x <= MaxX && y >= MinY && y <= MaxY;
+    }
+};
+
+struct footpath_graph_statistics
+{
+    uint32 Segments;
+    uint32 Steps;
+    uint32 Hits;
+    uint32 Misses;
+};
+
+const footpath_graph_segment * footpath_graph_get_segment(TileCoordsXYZ loc, sint32 direction);
+void footpath_graph_invalidate_tile(sint32 x, sint32 y);
+void footpath_graph_invalidate_all();
+uint32 footpath_graph_get_generation();
+void footpath_graph_set_enabled(bool enabled);
+footpath_graph_statistics footpath_graph_get_statistics();
+
+#endif
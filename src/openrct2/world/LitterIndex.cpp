@@ -0,0 +1,280 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include "../core/Math.hpp"
+#include "LitterIndex.h"
+#include "Map.h"
+#include "Sprite.h"
+
+// Cells of 4x4 tiles, few enough to be stored for the whole map
+constexpr sint32 CELL_SHIFT = 7;
+constexpr sint32 CELLS_PER_ROW = (MAXIMUM_MAP_SIZE_TECHNICAL * 32) >> CELL_SHIFT;
+constexpr uint16 CELL_NULL = 0xFFFF;
+
+// The litter of each cell and the cell of each litter sprite, built from the litter sprite list
+// when first needed after sprites are loaded
+static std::array<std::vector<uint16>, CELLS_PER_ROW * CELLS_PER_ROW> _cells;
+static std::array<uint16, MAX_SPRITES_TECHNICAL> _spriteCells;
+// The number of litter sprites created on each tick, for counting the litter by age
+static std::map<uint32, uint32> _creationTicks;
+static uint32 _count;
+static bool _valid;
+
+static sint32 litter_index_get_cell_coordinate(sint32 coordinate)
+{
+    return Math::Clamp(0, coordinate >> CELL_SHIFT, CELLS_PER_ROW - 1);
+}
+
+static void litter_index_insert(const rct_litter * litter)
+{
+    sint32 cell = litter_index_get_cell_coordinate(litter->x) + litter_index_get_cell_coordinate(litter->y) * CELLS_PER_ROW;
+    _cells[cell].push_back(litter->sprite_index);
+    _spriteCells[litter->sprite_index] = (uint16)cell;
+    _creationTicks[litter->creationTick]++;
+    _count++;
+}
+
+static void litter_index_build()
+{
+    for (auto& cell : _cells)
+    {
+        cell.clear();
+    }
+    _spriteCells.fill(CELL_NULL);
+    _creationTicks.clear();
+    _count = 0;
+
+    for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+         spriteIndex = get_sprite(spriteIndex)->unknown.next)
+    {
+        litter_index_insert(&get_sprite(spriteIndex)->litter);
+    }
+    _valid = true;
+}
+
+/**
+ * Calls the given function for each litter sprite in the cells overlapping the given area.
+ */
+template<typename TFunc>
+static void litter_index_for_each(sint32 left, sint32 top, sint32 right, sint32 bottom, TFunc func)
+{
+    if (!_valid)
+    {
+        litter_index_build();
+    }
+
+    sint32 cellLeft = litter_index_get_cell_coordinate(left);
+    sint32 cellTop = litter_index_get_cell_coordinate(top);
+    sint32 cellRight = litter_index_get_cell_coordinate(right);
+    sint32 cellBottom = litter_index_get_cell_coordinate(bottom);
+    for (sint32 cellY = cellTop; cellY <= cellBottom; cellY++)
+    {
+        for (sint32 cellX = cellLeft; cellX <= cellRight; cellX++)
+        {
+            for (uint16 spriteIndex : _cells[cellX + cellY * CELLS_PER_ROW])
+            {
+                func(&get_sprite(spriteIndex)->litter);
+            }
+        }
+    }
+}
+
+/**
+ * Drops the index, for when the sprites have been replaced.
+ */
+void litter_index_invalidate()
+{
+    _valid = false;
+}
+
+void litter_index_add(const rct_litter * litter)
+{
+    if (_valid)
+    {
+        litter_index_insert(litter);
+    }
+}
+
+void litter_index_remove(const rct_litter * litter)
+{
+    if (!_valid)
+        return;
+
+    uint16 cell = _spriteCells[litter->sprite_index];
+    if (cell == CELL_NULL)
+        return;
+
+    auto& cellSprites = _cells[cell];
+    auto it = std::find(cellSprites.begin(), cellSprites.end(), litter->sprite_index);
+    if (it != cellSprites.end())
+    {
+        cellSprites.erase(it);
+    }
+    _spriteCells[litter->sprite_index] = CELL_NULL;
+
+    auto creationTick = _creationTicks.find(litter->creationTick);
+    if (creationTick != _creationTicks.end() && --creationTick->second == 0)
+    {
+        _creationTicks.erase(creationTick);
+    }
+    _count--;
+}
+
+/**
+ * Finds the litter nearest to the given position, measuring distance as the sum of the x, y and
+ * four times the z distance. Litter at the same distance is ordered by sprite index.
+ * @param maxDistance the largest distance to find litter at.
+ * @param nearest array the nearest litter is written to, nearest first.
+ * @param count the number of litter sprites to find at most.
+ * @returns the number of litter sprites found.
+ */
+size_t litter_index_find_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance, rct_litter ** nearest, size_t count)
+{
+    struct candidate
+    {
+        sint32       Distance;
+        rct_litter * Litter;
+        uint32       ListPosition;
+    };
+
+    std::vector<candidate> candidates;
+    litter_index_for_each(x - maxDistance, y - maxDistance, x + maxDistance, y + maxDistance, [&](rct_litter * litter) {
+        sint32 distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+        if (distance <= maxDistance)
+        {
+            candidates.push_back({ distance, litter, 0 });
+        }
+    });
+
+    count = std::min(count, candidates.size());
+    std::sort(candidates.begin(), candidates.end(), [](const candidate& a, const candidate& b) {
+        return a.Distance < b.Distance;
+    });
+
+    // Equally distant litter is taken in the order of the litter list, like the full scan this replaces.
+    // The list is only walked as far as the last tied litter sprite.
+    std::vector<candidate *> tied;
+    size_t tiedEnd = 0;
+    for (size_t i = 0; i < count; i = tiedEnd)
+    {
+        tiedEnd = i + 1;
+        while (tiedEnd < candidates.size() && candidates[tiedEnd].Distance == candidates[i].Distance)
+        {
+            tiedEnd++;
+        }
+        if (tiedEnd - i > 1)
+        {
+            for (size_t j = i; j < tiedEnd; j++)
+            {
+                tied.push_back(&candidates[j]);
+            }
+        }
+    }
+    if (!tied.empty())
+    {
+        size_t numFound = 0;
+        uint32 listPosition = 0;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL && numFound < tied.size();
+             spriteIndex = get_sprite(spriteIndex)->unknown.next)
+        {
+            for (candidate * c : tied)
+            {
+                if (c->Litter->sprite_index == spriteIndex)
+                {
+                    c->ListPosition = listPosition;
+                    numFound++;
+                    break;
+                }
+            }
+            listPosition++;
+        }
+        std::sort(candidates.begin(), candidates.begin() + tiedEnd, [](const candidate& a, const candidate& b) {
+            if (a.Distance != b.Distance)
+                return a.Distance < b.Distance;
+            return a.ListPosition < b.ListPosition;
+        });
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        nearest[i] = candidates[i].Litter;
+    }
+    return count;
+}
+
+/**
+ * Counts the litter no further than the given range from the given position along either axis.
+ */
+uint32 litter_index_count_within(sint32 x, sint32 y, sint32 range)
+{
+    uint32 result = 0;
+    litter_index_for_each(x - range, y - range, x + range, y + range, [&](rct_litter * litter) {
+        if (std::max(abs(litter->x - x), abs(litter->y - y)) <= range)
+        {
+            result++;
+        }
+    });
+    return result;
+}
+
+/**
+ * Gets the litter on the tile of the given position.
+ */
+std::vector<rct_litter *> litter_index_get_on_tile(sint32 x, sint32 y)
+{
+    std::vector<rct_litter *> result;
+    litter_index_for_each(x, y, x, y, [&](rct_litter * litter) {
+        if ((litter->x >> 5) == (x >> 5) && (litter->y >> 5) == (y >> 5))
+        {
+            result.push_back(litter);
+        }
+    });
+    return result;
+}
+
+/**
+ * Gets whether there is any litter on the tile of the given position.
+ */
+bool litter_index_has_on_tile(sint32 x, sint32 y)
+{
+    bool result = false;
+    litter_index_for_each(x, y, x, y, [&](rct_litter * litter) {
+        result |= (litter->x >> 5) == (x >> 5) && (litter->y >> 5) == (y >> 5);
+    });
+    return result;
+}
+
+/**
+ * Counts the litter except that created in the given number of ticks from the given tick on, with
+ * the ticks wrapping around like the tick counter does.
+ */
+uint32 litter_index_count_excluding_created_within(uint32 tick, uint32 numTicks)
+{
+    if (!_valid)
+    {
+        litter_index_build();
+    }
+
+    uint32 result = _count;
+    uint32 end = tick + numTicks;
+    for (auto it = _creationTicks.lower_bound(tick); it != _creationTicks.end() && (end < tick || it->first < end); it++)
+    {
+        result -= it->second;
+    }
+    if (end < tick)
+    {
+        for (auto it = _creationTicks.begin(); it != _creationTicks.end() && it->first < end; it++)
+        {
+            result -= it->second;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,27 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef _LITTER_INDEX_H_
+#define _LITTER_INDEX_H_
+
+#include <vector>
+#include "../common.h"
+
+struct rct_litter;
+
+void litter_index_invalidate();
+void litter_index_add(const rct_litter * litter);
+void litter_index_remove(const rct_litter * litter);
+size_t litter_index_find_nearest(sint32 x, sint32 y, sint32 z, sint32 maxDistance, rct_litter ** nearest, size_t count);
+uint32 litter_index_count_within(sint32 x, sint32 y, sint32 range);
+std::vector<rct_litter *> litter_index_get_on_tile(sint32 x, sint32 y);
+bool litter_index_has_on_tile(sint32 x, sint32 y);
+uint32 litter_index_count_excluding_created_within(uint32 tick, uint32 numTicks);
+
+#endif
@@ -7,6 +7,11 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../config/Config.h"
@@ -15,7 +20,6 @@
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../Game.h"
-#include "../interface/Cursors.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -23,7 +27,10 @@
 #include "../management/Finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../paint/TilePaintCache.h"
+#include "../peep/StaffJobs.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -31,9 +38,11 @@
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../actions/WallRemoveAction.hpp"
+#include "Ambience.h"
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "Map.h"
 #include "MapAnimation.h"
@@ -114,6 +123,43 @@ PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 rct_tile_element *gNextFreeTileElement;
 uint32 gNextFreeTileElementPointerIndex;
 
+// Tiles that do not fit in gTileElements, which is what saved games hold, go into blocks that are
+// never moved, so that pointers to the elements of other tiles stay valid when the store grows
+constexpr size_t TILE_ELEMENT_BLOCK_SIZE = 0x10000;
+static TileElementBlocks _tileElementBlocks;
+
+// Dead elements left behind a tile that has been moved to the end of the store, so that it can grow
+// where it is. Gaps this small are also left by the compaction until the store is running out.
+constexpr size_t TILE_ELEMENT_SLACK = 4;
+constexpr size_t TILE_ELEMENT_RUNNING_OUT = TILE_ELEMENT_BLOCK_SIZE / 8;
+constexpr sint32 TILE_ELEMENT_COMPACTION_BUDGET = 64;
+
+// The tiles in the order they are in the store, which the compaction goes through so that the dead
+// elements it moves tiles down over reach the end of the store in one pass
+static std::vector<uint32> _tileElementCompactionOrder;
+
+// The tiles by their first element, to find the tile of an element. Tiles that have been moved by
+// the store since are looked up by where they were moved to, and any others that have moved are
+// noticed when they are looked up, which sorts them again.
+static std::vector<std::pair<const rct_tile_element *, uint32>> _tileElementTilesByFirstElement;
+static std::unordered_map<const rct_tile_element *, uint32> _tileElementTilesMoved;
+
+static void tile_element_note_moved(uint32 tileIndex)
+{
+    // Past this many, the tiles are sorted again when next looked up
+    if (_tileElementTilesMoved.size() >= MAX_TILE_TILE_ELEMENT_POINTERS / 4)
+    {
+        _tileElementTilesMoved.clear();
+        _tileElementTilesByFirstElement.clear();
+        return;
+    }
+    _tileElementTilesMoved[gTileElementTilePointers[tileIndex]] = tileIndex;
+}
+
+static uint32 _tileElementInPlaceInserts;
+static uint32 _tileElementRelocations;
+static uint32 _tileElementCompactedTiles;
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -333,6 +379,7 @@ rct_tile_element* map_get_banner_element_at(sint32 x, sint32 y, sint32 z, uint8
  */
 void map_init(sint32 size)
 {
+    map_derived_data_invalidate_all();
     gNumMapAnimations = 0;
     gNextFreeTileElementPointerIndex = 0;
 
@@ -367,6 +414,46 @@ void map_init(sint32 size)
     context_broadcast_intent(&intent);
 }
 
+/**
+ * Drops everything that is kept about the tile elements outside of them, for when the whole map
+ * has been replaced.
+ */
+void map_derived_data_invalidate_all()
+{
+    park_size_invalidate();
+    tile_paint_cache_invalidate_all();
+    footpath_graph_invalidate_all();
+    ride_proximity_invalidate_all();
+    ambience_invalidate_all();
+    staff_jobs_invalidate_all();
+}
+
+/**
+ * Drops what is kept about elements that game commands and actions change in place, e.g. the
+ * height of the land that neighbouring tiles paint edges against, or the edges of paths that the
+ * pathfinding walks along. Elements inserted and removed are covered by the tile hooks, as are
+ * the path additions that the ambience counts.
+ */
+void map_derived_data_invalidate_in_place()
+{
+    tile_paint_cache_invalidate_all();
+    footpath_graph_invalidate_all();
+    ride_proximity_invalidate_all();
+    staff_jobs_invalidate_all();
+}
+
+/**
+ * Drops what is kept about a tile whose elements have been inserted, removed or changed.
+ */
+void map_derived_data_invalidate_tile(sint32 x, sint32 y)
+{
+    tile_paint_cache_invalidate_tile(x, y);
+    footpath_graph_invalidate_tile(x, y);
+    ride_proximity_invalidate_tile(x, y);
+    ambience_invalidate_tile(x, y);
+    staff_jobs_invalidate_tile(x, y);
+}
+
 /**
  * Counts the number of surface tiles that offer land ownership rights for sale,
  * but haven't been bought yet. It updates gLandRemainingOwnershipSales and
@@ -407,6 +494,120 @@ void map_count_remaining_land_rights()
     }
 }
 
+/**
+ * Gets which store holds the element, 0 being gTileElements and the blocks following it.
+ */
+static size_t tile_element_get_store_index(const rct_tile_element * tileElement)
+{
+    for (size_t i = 0; i < _tileElementBlocks.size(); i++)
+    {
+        const rct_tile_element * block = _tileElementBlocks[i].get();
+        if (tileElement >= block && tileElement < block + TILE_ELEMENT_BLOCK_SIZE)
+            return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * Gets the start of gTileElements or of the block that holds the element.
+ */
+static rct_tile_element * tile_element_get_store(const rct_tile_element * tileElement)
+{
+    size_t storeIndex = tile_element_get_store_index(tileElement);
+    return storeIndex == 0 ? gTileElements : _tileElementBlocks[storeIndex - 1].get();
+}
+
+static rct_tile_element * tile_element_get_store_end(const rct_tile_element * store)
+{
+    return store == gTileElements ? gTileElements + MAX_TILE_ELEMENTS : (rct_tile_element *)store + TILE_ELEMENT_BLOCK_SIZE;
+}
+
+/**
+ * Gets the store that new elements are taken from, which is always the last one added.
+ */
+static rct_tile_element * tile_element_get_free_store()
+{
+    return _tileElementBlocks.empty() ? gTileElements : _tileElementBlocks.back().get();
+}
+
+static bool tile_element_has_free(size_t numElements)
+{
+    return gNextFreeTileElement + numElements <= tile_element_get_store_end(tile_element_get_free_store());
+}
+
+/**
+ * Starts taking new elements from a new block. The elements left at the end of the last store are
+ * marked dead, so the tile before them can still grow into them.
+ */
+static void tile_element_add_block()
+{
+    rct_tile_element * storeEnd = tile_element_get_store_end(tile_element_get_free_store());
+    for (rct_tile_element * tileElement = gNextFreeTileElement; tileElement < storeEnd; tileElement++)
+    {
+        tileElement->base_height = 255;
+    }
+
+    _tileElementBlocks.push_back(std::make_unique<rct_tile_element[]>(TILE_ELEMENT_BLOCK_SIZE));
+    gNextFreeTileElement = _tileElementBlocks.back().get();
+    log_verbose("Tile element store grown to %u blocks", (uint32)_tileElementBlocks.size());
+}
+
+/**
+ * Moves the dead elements at the end of the store that new elements are taken from back to the free ones.
+ */
+static void tile_element_trim_free()
+{
+    rct_tile_element * store = tile_element_get_free_store();
+    while (gNextFreeTileElement > store && (gNextFreeTileElement - 1)->base_height == 255)
+    {
+        gNextFreeTileElement--;
+    }
+}
+
+TileElementBlocks map_take_tile_element_blocks()
+{
+    TileElementBlocks blocks = std::move(_tileElementBlocks);
+    _tileElementBlocks.clear();
+    return blocks;
+}
+
+void map_restore_tile_element_blocks(TileElementBlocks blocks)
+{
+    _tileElementBlocks = std::move(blocks);
+}
+
+/**
+ * Counts the elements of all tiles, leaving out the dead and free ones wherever they are.
+ */
+static size_t tile_element_count_live()
+{
+    size_t numLive = 0;
+    for (const auto tileElementFirst : gTileElementTilePointers)
+    {
+        if (tileElementFirst == TILE_UNDEFINED_TILE_ELEMENT)
+            continue;
+
+        const rct_tile_element * tileElement = tileElementFirst;
+        while (!(tileElement++)->IsLastForTile());
+        numLive += (size_t)(tileElement - tileElementFirst);
+    }
+    return numLive;
+}
+
+tile_element_store_statistics map_get_tile_element_statistics()
+{
+    tile_element_store_statistics statistics = {};
+    statistics.Live = (uint32)tile_element_count_live();
+    statistics.Blocks = (uint32)_tileElementBlocks.size();
+    statistics.Capacity = (uint32)(MAX_TILE_ELEMENTS + _tileElementBlocks.size() * TILE_ELEMENT_BLOCK_SIZE);
+    statistics.Free = (uint32)(tile_element_get_store_end(tile_element_get_free_store()) - gNextFreeTileElement);
+    statistics.Dead = statistics.Capacity - statistics.Free - statistics.Live;
+    statistics.InPlaceInserts = _tileElementInPlaceInserts;
+    statistics.Relocations = _tileElementRelocations;
+    statistics.CompactedTiles = _tileElementCompactedTiles;
+    return statistics;
+}
+
 /**
  * This is meant to strip TILE_ELEMENT_FLAG_GHOST flag from all elements when
  * importing a park.
@@ -422,16 +623,30 @@ void map_strip_ghost_flag_from_elements()
     do {
         tileElement->flags &= ~TILE_ELEMENT_FLAG_GHOST;
     } while (++tileElement < gTileElements + MAX_TILE_ELEMENTS);
+    for (auto& block : _tileElementBlocks)
+    {
+        for (size_t i = 0; i < TILE_ELEMENT_BLOCK_SIZE; i++)
+        {
+            block[i].flags &= ~TILE_ELEMENT_FLAG_GHOST;
+        }
+    }
+    footpath_graph_invalidate_all();
 }
 
 /**
- *
+ * Points each tile at its elements, which must be in tile order at the start of gTileElements.
  *  rct2: 0x0068AFFD
  */
 void map_update_tile_pointers()
 {
     sint32 i, x, y;
 
+    _tileElementBlocks.clear();
+    _tileElementCompactionOrder.clear();
+    _tileElementInPlaceInserts = 0;
+    _tileElementRelocations = 0;
+    _tileElementCompactedTiles = 0;
+
     for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++) {
         gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
     }
@@ -603,52 +818,90 @@ sint32 tile_element_height(sint32 x, sint32 y)
     return height;
 }
 
+static void tile_element_sort_compaction_order()
+{
+    std::vector<uint64> keys;
+    keys.reserve(MAX_TILE_TILE_ELEMENT_POINTERS);
+    for (uint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        const rct_tile_element * tileElement = gTileElementTilePointers[i];
+        if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+            continue;
+
+        uint64 storeIndex = tile_element_get_store_index(tileElement);
+        uint64 offset = (uint64)(tileElement - tile_element_get_store(tileElement));
+        keys.push_back((storeIndex << 48) | (offset << 16) | i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    _tileElementCompactionOrder.clear();
+    for (auto key : keys)
+    {
+        _tileElementCompactionOrder.push_back((uint32)(key & 0xFFFF));
+    }
+}
+
 /**
- *
- *  rct2: 0x0068B089
+ * Moves the next tile down over the dead elements before it. Gaps of up to TILE_ELEMENT_SLACK
+ * elements can be left as room for the tile before it to grow into. The tiles are gone through in
+ * the order they were in the store at the start of the pass, which is tile order for a loaded park,
+ * with gNextFreeTileElementPointerIndex being how far the pass has got.
  */
-void sub_68B089()
+static void tile_element_compact_next(bool keepSlack)
 {
-    sint32 i;
-    rct_tile_element *tileElementFirst, *tileElement;
+    if (gNextFreeTileElementPointerIndex >= _tileElementCompactionOrder.size())
+    {
+        bool isPassDone = !_tileElementCompactionOrder.empty();
+        tile_element_sort_compaction_order();
+        if (isPassDone || gNextFreeTileElementPointerIndex >= _tileElementCompactionOrder.size())
+            gNextFreeTileElementPointerIndex = 0;
+        if (_tileElementCompactionOrder.empty())
+            return;
+    }
+    uint32 i = _tileElementCompactionOrder[gNextFreeTileElementPointerIndex++];
 
-    if (gTrackDesignSaveMode)
+    rct_tile_element * tileElementFirst = gTileElementTilePointers[i];
+    if (tileElementFirst == TILE_UNDEFINED_TILE_ELEMENT)
         return;
 
-    i = gNextFreeTileElementPointerIndex;
-    do {
-        i++;
-        if (i >= MAX_TILE_TILE_ELEMENT_POINTERS)
-            i = 0;
-    } while (gTileElementTilePointers[i] == TILE_UNDEFINED_TILE_ELEMENT);
-    gNextFreeTileElementPointerIndex = i;
-
-    tileElementFirst = tileElement = gTileElementTilePointers[i];
-    do {
+    rct_tile_element * store = tile_element_get_store(tileElementFirst);
+    rct_tile_element * tileElement = tileElementFirst;
+    while (tileElement > store && (tileElement - 1)->base_height == 255)
+    {
         tileElement--;
-        if (tileElement < gTileElements)
-            break;
-    } while (tileElement->base_height == 255);
-    tileElement++;
+    }
 
-    if (tileElement == tileElementFirst)
+    size_t numDead = (size_t)(tileElementFirst - tileElement);
+    if (numDead == 0 || (keepSlack && numDead <= TILE_ELEMENT_SLACK))
         return;
 
-    //
     gTileElementTilePointers[i] = tileElement;
+    tile_element_note_moved(i);
     do {
         *tileElement = *tileElementFirst;
         tileElementFirst->base_height = 255;
 
         tileElementFirst++;
     } while (!(tileElement++)->IsLastForTile());
+    _tileElementCompactedTiles++;
+}
 
-    tileElement = gNextFreeTileElement;
-    do {
-        tileElement--;
-    } while (tileElement->base_height == 255);
-    tileElement++;
-    gNextFreeTileElement = tileElement;
+/**
+ * Compacts the tile elements a few tiles at a time, more of them when the store is running out.
+ *  rct2: 0x0068B089
+ */
+void sub_68B089()
+{
+    if (gTrackDesignSaveMode)
+        return;
+
+    bool isRunningOut = !tile_element_has_free(TILE_ELEMENT_RUNNING_OUT);
+    sint32 numTiles = isRunningOut ? TILE_ELEMENT_COMPACTION_BUDGET : 1;
+    for (sint32 i = 0; i < numTiles; i++)
+    {
+        tile_element_compact_next(!isRunningOut);
+    }
+    tile_element_trim_free();
 }
 
 
@@ -3005,12 +3258,81 @@ sint32 tile_element_get_station(const rct_tile_element * tileElement)
     return (tileElement->properties.track.sequence & MAP_ELEM_TRACK_SEQUENCE_STATION_INDEX_MASK) >> 4;
 }
 
+static void tile_element_sort_tiles_by_first_element()
+{
+    _tileElementTilesMoved.clear();
+    _tileElementTilesByFirstElement.clear();
+    for (uint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        if (gTileElementTilePointers[i] != TILE_UNDEFINED_TILE_ELEMENT)
+        {
+            _tileElementTilesByFirstElement.emplace_back(gTileElementTilePointers[i], i);
+        }
+    }
+    std::sort(_tileElementTilesByFirstElement.begin(), _tileElementTilesByFirstElement.end(), [](const auto& a, const auto& b) {
+        return std::less<const rct_tile_element *>()(a.first, b.first);
+    });
+}
+
+/**
+ * Finds the tile of an element. The first element of its tile is found by walking back to the end
+ * of the tile or the dead elements before it.
+ */
+static bool tile_element_find_tile(const rct_tile_element * tileElement, sint32 * x, sint32 * y)
+{
+    const rct_tile_element * store = tile_element_get_store(tileElement);
+    const rct_tile_element * tileElementFirst = tileElement;
+    while (tileElementFirst > store && !(tileElementFirst - 1)->IsLastForTile() && (tileElementFirst - 1)->base_height != 255)
+    {
+        tileElementFirst--;
+    }
+
+    auto moved = _tileElementTilesMoved.find(tileElementFirst);
+    if (moved != _tileElementTilesMoved.end() && gTileElementTilePointers[moved->second] == tileElementFirst)
+    {
+        *x = moved->second % MAXIMUM_MAP_SIZE_TECHNICAL;
+        *y = moved->second / MAXIMUM_MAP_SIZE_TECHNICAL;
+        return true;
+    }
+
+    for (sint32 attempt = 0; attempt < 2; attempt++)
+    {
+        auto it = std::lower_bound(
+            _tileElementTilesByFirstElement.begin(), _tileElementTilesByFirstElement.end(), tileElementFirst,
+            [](const auto& entry, const rct_tile_element * element) {
+                return std::less<const rct_tile_element *>()(entry.first, element);
+            });
+        if (it != _tileElementTilesByFirstElement.end() && it->first == tileElementFirst &&
+            gTileElementTilePointers[it->second] == tileElementFirst)
+        {
+            *x = it->second % MAXIMUM_MAP_SIZE_TECHNICAL;
+            *y = it->second / MAXIMUM_MAP_SIZE_TECHNICAL;
+            return true;
+        }
+        if (attempt == 0)
+        {
+            tile_element_sort_tiles_by_first_element();
+        }
+    }
+    return false;
+}
+
 /**
  *
  *  rct2: 0x0068B280
  */
 void tile_element_remove(rct_tile_element *tileElement)
 {
+    sint32 x, y;
+    if (tile_element_find_tile(tileElement, &x, &y))
+    {
+        map_derived_data_invalidate_tile(x, y);
+    }
+    else
+    {
+        map_derived_data_invalidate_all();
+    }
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -3060,6 +3382,9 @@ void map_remove_all_rides()
             break;
         }
     } while (tile_element_iterator_next(&it));
+
+    // Queues without a ride are now plain paths
+    footpath_graph_invalidate_all();
 }
 
 /**
@@ -3141,89 +3466,159 @@ void map_invalidate_selection_rect()
 }
 
 /**
- *
+ * Puts the tiles back in order from the start of the store, leaving no dead elements between them.
  *  rct2: 0x0068B111
  */
 void map_reorganise_elements()
 {
-    context_setcurrentcursor(CURSOR_ZZZ);
-
-    rct_tile_element* new_tile_elements = (rct_tile_element *)malloc(3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_tile_element));
-    rct_tile_element* new_elements_pointer = new_tile_elements;
-
-    if (new_tile_elements == nullptr) {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
-    }
-
-    uint32 num_elements;
-
+    std::vector<rct_tile_element> elements;
     for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
         for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
             rct_tile_element *startElement = map_get_first_element_at(x, y);
             rct_tile_element *endElement = startElement;
             while (!(endElement++)->IsLastForTile());
 
-            num_elements = (uint32)(endElement - startElement);
-            memcpy(new_elements_pointer, startElement, num_elements * sizeof(rct_tile_element));
-            new_elements_pointer += num_elements;
+            elements.insert(elements.end(), startElement, endElement);
         }
     }
 
-    num_elements = (uint32)(new_elements_pointer - new_tile_elements);
-    memcpy(gTileElements, new_tile_elements, num_elements * sizeof(rct_tile_element));
-    memset(gTileElements + num_elements, 0, (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(rct_tile_element));
+    _tileElementBlocks.clear();
+    _tileElementCompactionOrder.clear();
+    gNextFreeTileElement = gTileElements;
 
-    free(new_tile_elements);
+    const rct_tile_element * sourceElement = elements.data();
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+            const rct_tile_element * endElement = sourceElement;
+            while (!(endElement++)->IsLastForTile());
 
-    map_update_tile_pointers();
+            size_t numElements = (size_t)(endElement - sourceElement);
+            if (!tile_element_has_free(numElements)) {
+                tile_element_add_block();
+            }
+
+            memcpy(gNextFreeTileElement, sourceElement, numElements * sizeof(rct_tile_element));
+            gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = gNextFreeTileElement;
+            gNextFreeTileElement += numElements;
+            sourceElement = endElement;
+        }
+    }
+
+    if (_tileElementBlocks.empty()) {
+        std::fill(gNextFreeTileElement, std::end(gTileElements), rct_tile_element{});
+    }
 }
 
 /**
- *
- *  rct2: 0x0068B044
- *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
+ * Makes room for the given number of elements after gNextFreeTileElement, by compacting the store
+ * or adding a block to it. Returns false when there is still no room.
  */
-bool map_check_free_elements_and_reorganise(sint32 num_elements)
+static bool tile_element_make_room(size_t numElements)
 {
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
+    if (tile_element_has_free(numElements))
         return true;
 
     for (sint32 i = 1000; i != 0; --i)
-        sub_68B089();
+        tile_element_compact_next(false);
+    tile_element_trim_free();
 
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
+    if (tile_element_has_free(numElements))
         return true;
 
+    // Games played over the network are sent as saved games, so they are kept in gTileElements
+    if (network_get_mode() == NETWORK_MODE_NONE) {
+        tile_element_add_block();
+        return true;
+    }
+
     map_reorganise_elements();
+    return tile_element_has_free(numElements);
+}
 
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
+/**
+ *
+ *  rct2: 0x0068B044
+ *  Returns true on space available for more elements
+ *  Compacts the map elements to make space, or adds a block to the store. The blocks hold tiles
+ *  that have been moved while being changed, but no more elements are let in than a saved game
+ *  can hold, which is only counted once the store has grown or run out.
+ */
+bool map_check_free_elements_and_reorganise(sint32 num_elements)
+{
+    bool fitsInStore = tile_element_has_free(num_elements);
+    if (fitsInStore && _tileElementBlocks.empty())
         return true;
-    else{
+
+    if (tile_element_count_live() + num_elements > MAX_TILE_ELEMENTS) {
         gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
         return false;
     }
+
+    if (fitsInStore || tile_element_make_room(num_elements))
+        return true;
+
+    gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+    return false;
 }
 
 /**
- *
+ * Inserts an element into the tile, where it is when the element after the tile is free, or
+ * otherwise by moving the tile to the end of the store with some room to grow behind it.
  *  rct2: 0x0068B1F6
  */
 rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
 {
     rct_tile_element *originalTileElement, *newTileElement, *insertedElement;
 
-    if (!map_check_free_elements_and_reorganise(1)) {
+    map_derived_data_invalidate_tile(x, y);
+
+    rct_tile_element ** tilePointer = &gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    rct_tile_element * lastTileElement = *tilePointer;
+    while (!lastTileElement->IsLastForTile()) {
+        lastTileElement++;
+    }
+
+    newTileElement = lastTileElement + 1;
+    rct_tile_element * storeEnd = tile_element_get_store_end(tile_element_get_store(lastTileElement));
+    bool isNextFree = newTileElement < storeEnd && (newTileElement == gNextFreeTileElement || newTileElement->base_height == 255);
+    if (isNextFree) {
+        // Find where the element goes, the same as when the tile is copied below
+        insertedElement = *tilePointer;
+        while (insertedElement <= lastTileElement && z >= insertedElement->base_height) {
+            insertedElement++;
+        }
+
+        if (insertedElement > lastTileElement) {
+            lastTileElement->flags &= ~TILE_ELEMENT_FLAG_LAST_TILE;
+            flags |= TILE_ELEMENT_FLAG_LAST_TILE;
+        }
+        for (; newTileElement > insertedElement; newTileElement--) {
+            *newTileElement = *(newTileElement - 1);
+        }
+
+        if (lastTileElement + 1 == gNextFreeTileElement) {
+            gNextFreeTileElement++;
+        }
+        insertedElement->base_height = z;
+        insertedElement->flags = flags;
+        insertedElement->clearance_height = z;
+        memset(&insertedElement->properties, 0, sizeof(insertedElement->properties));
+        _tileElementInPlaceInserts++;
+        return insertedElement;
+    }
+
+    size_t numElements = (size_t)(lastTileElement - *tilePointer) + 1;
+    if (!tile_element_make_room(numElements + 1)) {
         log_error("Cannot insert new element");
         return nullptr;
     }
 
     newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    originalTileElement = *tilePointer;
 
     // Set tile index pointer to point to new element block
-    gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
+    *tilePointer = newTileElement;
+    tile_element_note_moved((uint32)(tilePointer - gTileElementTilePointers));
 
     // Copy all elements that are below the insert height
     while (z >= originalTileElement->base_height) {
@@ -3260,7 +3655,16 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
         } while (!((newTileElement - 1)->flags & TILE_ELEMENT_FLAG_LAST_TILE));
     }
 
+    // Leave room behind the tile for it to grow into
+    storeEnd = tile_element_get_store_end(tile_element_get_free_store());
+    size_t numSlack = std::min(numElements / 2 + 1, TILE_ELEMENT_SLACK);
+    for (; numSlack > 0 && newTileElement < storeEnd; numSlack--) {
+        newTileElement->base_height = 255;
+        newTileElement++;
+    }
+
     gNextFreeTileElement = newTileElement;
+    _tileElementRelocations++;
     return insertedElement;
 }
 
@@ -3604,6 +4008,7 @@ static void map_set_grass_length(sint32 x, sint32 y, rct_tile_element *tileEleme
     {
         return;
     }
+    staff_jobs_invalidate_tile(x / 32, y / 32);
 
     // If the new grass length won't result in an actual visual change
     // then skip invalidating the tile, no point
@@ -3747,6 +4152,9 @@ void map_extend_boundary_surface()
 
         update_park_fences({x << 5, y << 5});
     }
+
+    // The new edge tiles are unowned
+    park_size_invalidate();
 }
 
 /**
@@ -3764,6 +4172,7 @@ static void clear_element_at(sint32 x, sint32 y, rct_tile_element **elementPtr)
         element->properties.surface.terrain = 0;
         element->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
         element->properties.surface.ownership = 0;
+        park_size_invalidate();
         // Because this element is not completely removed, the pointer must be updated manually
         // The rest of the elements are removed from the array, so the pointer doesn't need to be updated.
         (*elementPtr)++;
@@ -4746,6 +5155,7 @@ void FixLandOwnershipTilesWithOwnership(std::initializer_list<TileCoordsXY> tile
         currentElement->properties.surface.ownership |= ownership;
         update_park_fences_around_tile({(*tile).x * 32, (*tile).y * 32});
     }
+    park_size_invalidate();
 }
 
 uint8 entrance_element_get_type(const rct_tile_element * tileElement)
@@ -11,6 +11,8 @@
 #define _MAP_H_
 
 #include <initializer_list>
+#include <memory>
+#include <vector>
 #include "../common.h"
 #include "Location.hpp"
 #include "TileElement.h"
@@ -108,6 +110,20 @@ extern PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 extern rct_tile_element *gNextFreeTileElement;
 extern uint32 gNextFreeTileElementPointerIndex;
 
+using TileElementBlocks = std::vector<std::unique_ptr<rct_tile_element[]>>;
+
+struct tile_element_store_statistics
+{
+    uint32 Live;
+    uint32 Dead;
+    uint32 Free;
+    uint32 Capacity;
+    uint32 Blocks;
+    uint32 InPlaceInserts;
+    uint32 Relocations;
+    uint32 CompactedTiles;
+};
+
 // Used in the land tool window to enable mountain tool / land smoothing
 extern bool gLandMountainMode;
 // Used in the land tool window to allow dragging and changing land styles
@@ -125,9 +141,15 @@ extern LocationXYZ16 gCommandPosition;
 extern bool gMapLandRightsUpdateSuccess;
 
 void map_init(sint32 size);
+void map_derived_data_invalidate_all();
+void map_derived_data_invalidate_in_place();
+void map_derived_data_invalidate_tile(sint32 x, sint32 y);
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
 void map_update_tile_pointers();
+TileElementBlocks map_take_tile_element_blocks();
+void map_restore_tile_element_blocks(TileElementBlocks blocks);
+tile_element_store_statistics map_get_tile_element_statistics();
 rct_tile_element *map_get_first_element_at(sint32 x, sint32 y);
 rct_tile_element *map_get_nth_element_at(sint32 x, sint32 y, sint32 n);
 void map_set_tile_elements(sint32 x, sint32 y, rct_tile_element *elements);
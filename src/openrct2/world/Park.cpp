@@ -26,6 +26,7 @@
 #include "../management/Research.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../peep/GuestStore.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -34,6 +35,7 @@
 #include "../scenario/Scenario.h"
 #include "../windows/Intent.h"
 #include "Entrance.h"
+#include "LitterIndex.h"
 #include "Map.h"
 #include "Park.h"
 #include "Sprite.h"
@@ -76,6 +78,13 @@ sint32 _suggestedGuestMaximum;
  */
 sint32 _guestGenerationProbability;
 
+/**
+ * The number of tiles with land or construction rights owned, counted from the map when first needed
+ * after it has been loaded or replaced, and kept up to date as rights are bought or sold after that.
+ */
+static sint32 _ownedTileCount;
+static bool _ownedTileCountValid;
+
 /**
  *
  *  rct2: 0x00667104
@@ -391,7 +400,13 @@ sint32 map_buy_land_rights(sint32 x0, sint32 y0, sint32 x1, sint32 y1, sint32 se
     if ((gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) != 0 || game_is_not_paused() || gCheatsBuildInPauseMode) {
         for (y = y0; y <= y1; y += 32) {
             for (x = x0; x <= x1; x += 32) {
+                rct_tile_element * surfaceElement = map_get_surface_element_at({ x, y });
+                uint8 oldOwnership = surfaceElement != nullptr ? surfaceElement->properties.surface.ownership : 0;
                 cost = map_buy_land_rights_for_tile(x, y, setting, flags);
+                if (surfaceElement != nullptr)
+                {
+                    park_size_update_ownership(oldOwnership, surfaceElement->properties.surface.ownership);
+                }
                 if (cost != MONEY32_UNDEFINED)
                 {
                     totalCost += cost;
@@ -570,6 +585,11 @@ void Park::Update(const Date &date)
     // Every ~13 seconds
     if (gCurrentTicks % 512 == 0)
     {
+        if (gConfigGeneral.verify_park_counts)
+        {
+            VerifyRunningCounts();
+        }
+
         gParkRating = CalculateParkRating();
         gParkValue = CalculateParkValue();
         gCompanyValue = CalculateCompanyValue();
@@ -595,7 +615,7 @@ void Park::Update(const Date &date)
     GenerateGuests();
 }
 
-sint32 Park::CalculateParkSize() const
+static sint32 park_count_owned_tiles()
 {
     sint32 tiles;
     tile_element_iterator it;
@@ -611,7 +631,18 @@ sint32 Park::CalculateParkSize() const
             }
         }
     } while (tile_element_iterator_next(&it));
+    return tiles;
+}
+
+sint32 Park::CalculateParkSize() const
+{
+    if (!_ownedTileCountValid)
+    {
+        _ownedTileCount = park_count_owned_tiles();
+        _ownedTileCountValid = true;
+    }
 
+    sint32 tiles = _ownedTileCount;
     if (tiles != gParkSize) {
         gParkSize = tiles;
         window_invalidate_by_class(WC_PARK_INFORMATION);
@@ -620,6 +651,69 @@ sint32 Park::CalculateParkSize() const
     return tiles;
 }
 
+/**
+ * Counts the happy and lost guests, the litter and the owned tiles again by going over all of them,
+ * and logs where the running counts used for the park rating and size differ.
+ * @returns whether all counts were the same.
+ */
+bool Park::VerifyRunningCounts() const
+{
+    sint32 happyGuestCount = 0;
+    sint32 lostGuestCount = 0;
+    uint16 spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        if (peep->outside_of_park == 0)
+        {
+            if (peep->happiness > 128)
+            {
+                happyGuestCount++;
+            }
+            if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
+            {
+                lostGuestCount++;
+            }
+        }
+    }
+
+    rct_litter * litter;
+    sint32 litterCount = 0;
+    for (spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
+    {
+        litter = &(get_sprite(spriteIndex)->litter);
+        if (litter->creationTick - gScenarioTicks >= 7680)
+        {
+            litterCount++;
+        }
+    }
+
+    bool result = true;
+    auto guestCounts = guest_store_get_park_counts();
+    if (guestCounts.Happy != happyGuestCount || guestCounts.Lost != lostGuestCount)
+    {
+        log_warning("Running guest counts differ: %d happy, %d lost, counted %d happy, %d lost", guestCounts.Happy,
+                    guestCounts.Lost, happyGuestCount, lostGuestCount);
+        result = false;
+    }
+    sint32 runningLitterCount = (sint32)litter_index_count_excluding_created_within(gScenarioTicks, 7680);
+    if (runningLitterCount != litterCount)
+    {
+        log_warning("Running litter count differs: %d, counted %d", runningLitterCount, litterCount);
+        result = false;
+    }
+    if (_ownedTileCountValid)
+    {
+        sint32 ownedTileCount = park_count_owned_tiles();
+        if (_ownedTileCount != ownedTileCount)
+        {
+            log_warning("Running owned tile count differs: %d, counted %d", _ownedTileCount, ownedTileCount);
+            result = false;
+        }
+    }
+    return result;
+}
+
 sint32 Park::CalculateParkRating() const
 {
     if (_forcedParkRating >= 0)
@@ -639,25 +733,9 @@ sint32 Park::CalculateParkRating() const
         result -= 150 - (std::min<sint16>(2000, gNumGuestsInPark) / 13);
 
         // Find the number of happy peeps and the number of peeps who can't find the park exit
-        sint32 happyGuestCount = 0;
-        sint32 lostGuestCount = 0;
-        uint16 spriteIndex;
-        rct_peep * peep;
-        FOR_ALL_GUESTS(spriteIndex, peep)
-        {
-            if (peep->outside_of_park == 0)
-            {
-                if (peep->happiness > 128)
-                {
-                    happyGuestCount++;
-                }
-                if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) &&
-                    (peep->peep_is_lost_countdown < 90))
-                {
-                    lostGuestCount++;
-                }
-            }
-        }
+        auto guestCounts = guest_store_get_park_counts();
+        sint32 happyGuestCount = guestCounts.Happy;
+        sint32 lostGuestCount = guestCounts.Lost;
 
         // Peep happiness -500 to +0
         result -= 500;
@@ -729,18 +807,8 @@ sint32 Park::CalculateParkRating() const
 
     // Litter
     {
-        rct_litter * litter;
-        sint32 litterCount = 0;
-        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = litter->next)
-        {
-            litter = &(get_sprite(spriteIndex)->litter);
-
-            // Ignore recently dropped litter
-            if (litter->creationTick - gScenarioTicks >= 7680)
-            {
-                litterCount++;
-            }
-        }
+        // Ignore recently dropped litter
+        sint32 litterCount = (sint32)litter_index_count_excluding_created_within(gScenarioTicks, 7680);
         result -= 600 - (4 * (150 - std::min<sint32>(150, litterCount)));
     }
 
@@ -978,6 +1046,7 @@ rct_peep * Park::GenerateGuest()
             peep->direction = spawn.direction;
             peep->var_37 = 0;
             peep->state = PEEP_STATE_ENTERING_PARK;
+            guest_store_update(peep);
         }
     }
     return peep;
@@ -1047,6 +1116,24 @@ sint32 park_is_open()
     return GetContext()->GetGameState()->GetPark().IsOpen();
 }
 
+/**
+ * Counts the owned tiles again when next needed, for when the map has been replaced or ownership
+ * has been changed other than by buying or selling rights.
+ */
+void park_size_invalidate()
+{
+    _ownedTileCountValid = false;
+}
+
+void park_size_update_ownership(uint8 oldOwnership, uint8 newOwnership)
+{
+    const uint8 ownedMask = OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED | OWNERSHIP_OWNED;
+    if (_ownedTileCountValid)
+    {
+        _ownedTileCount += ((newOwnership & ownedMask) != 0) - ((oldOwnership & ownedMask) != 0);
+    }
+}
+
 sint32 park_calculate_size()
 {
     auto tiles = GetContext()->GetGameState()->GetPark().CalculateParkSize();
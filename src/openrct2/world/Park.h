@@ -66,6 +66,7 @@ namespace OpenRCT2
         void Update(const Date &date);
 
         sint32          CalculateParkSize() const;
+        bool            VerifyRunningCounts() const;
         sint32          CalculateParkRating() const;
         money32         CalculateParkValue() const;
         money32         CalculateCompanyValue() const;
@@ -125,6 +126,8 @@ sint32 get_forced_park_rating();
 
 sint32 park_is_open();
 sint32 park_calculate_size();
+void park_size_invalidate();
+void park_size_update_ownership(uint8 oldOwnership, uint8 newOwnership);
 
 void reset_park_entry();
 
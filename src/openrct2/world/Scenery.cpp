@@ -15,6 +15,7 @@
 #include "../network/network.h"
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
+#include "../peep/StaffJobs.h"
 #include "../scenario/Scenario.h"
 #include "../actions/WallRemoveAction.hpp"
 #include "Climate.h"
@@ -165,6 +166,7 @@ void scenery_update_age(sint32 x, sint32 y, rct_tile_element *tileElement)
 
     // Reset age / water plant
     tileElement->properties.scenery.age = 0;
+    staff_jobs_invalidate_tile(x / 32, y / 32);
     map_invalidate_tile_zoom1(x, y, tileElement->base_height * 8, tileElement->clearance_height * 8);
 }
 
@@ -176,6 +178,12 @@ void scenery_increase_age(sint32 x, sint32 y, rct_tile_element *tileElement)
     if (tileElement->properties.scenery.age < 255) {
         uint8 newAge = tileElement->properties.scenery.age++;
 
+        // Old enough for handymen to water
+        if (newAge + 1 == SCENERY_WITHER_AGE_THRESHOLD_1)
+        {
+            staff_jobs_invalidate_tile(x / 32, y / 32);
+        }
+
         // Only invalidate tiles when scenery crosses the withering threshholds, and can be withered.
         if (newAge == SCENERY_WITHER_AGE_THRESHOLD_1 || newAge == SCENERY_WITHER_AGE_THRESHOLD_2)
         {
@@ -9,8 +9,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 #include "../audio/audio.h"
 #include "../Cheats.h"
+#include "../config/Config.h"
 #include "../core/Crypt.h"
 #include "../core/Guard.hpp"
 #include "../core/Math.hpp"
@@ -19,21 +22,38 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../peep/GuestStore.h"
+#include "../peep/StaffJobs.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "LitterIndex.h"
 #include "Sprite.h"
 
 uint16 gSpriteListHead[6];
 uint16 gSpriteListCount[6];
-static rct_sprite _spriteList[MAX_SPRITES];
 
-static bool _spriteFlashingList[MAX_SPRITES];
+// The sprites are kept in chunks that are never moved, so that pointers to sprites stay valid when
+// the store grows past MAX_SPRITES
+constexpr size_t SPRITE_CHUNK_SHIFT = 10;
+constexpr size_t SPRITE_CHUNK_SIZE = 1 << SPRITE_CHUNK_SHIFT;
+static std::vector<std::unique_ptr<rct_sprite[]>> _spriteChunks;
+static size_t _spriteCapacity;
+
+static bool _spriteFlashingList[MAX_SPRITES_TECHNICAL];
 
 #define SPATIAL_INDEX_LOCATION_NULL 0x10000
 
 uint16 gSpriteSpatialIndex[0x10001];
 
+// The sprite before each sprite in the chain of its spatial index bucket, so that a sprite can be
+// taken out of its bucket without walking the chain from the head. The links are not saved, so a
+// link that no longer matches the chain (after a load or a fix) is found by walking it once.
+static uint16 _spritePreviousInQuadrant[MAX_SPRITES_TECHNICAL];
+static uint32 _spatialIndexUnlinks;
+static uint32 _spatialIndexWalks;
+
 const rct_string_id litterNames[12] = {
     STR_LITTER_VOMIT,
     STR_LITTER_VOMIT,
@@ -49,25 +69,160 @@ const rct_string_id litterNames[12] = {
     STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE
 };
 
-static LocationXYZ16 _spritelocations1[MAX_SPRITES];
-static LocationXYZ16 _spritelocations2[MAX_SPRITES];
+// The sprites that moved since the position of each sprite was last stored for frame smoothing,
+// with where they were then
+static std::vector<uint16> _tweenMovedSprites;
+static bool _tweenMoved[MAX_SPRITES_TECHNICAL];
+static LocationXYZ16 _tweenMovedFrom[MAX_SPRITES_TECHNICAL];
+
+// The sprites to smooth the movement of between the last two ticks, one array per field so that
+// the positions in between can be worked out for all of them at once
+static struct
+{
+    std::vector<uint16> SpriteIndex;
+    std::vector<float> FromX;
+    std::vector<float> FromY;
+    std::vector<float> FromZ;
+    std::vector<float> ToX;
+    std::vector<float> ToY;
+    std::vector<float> ToZ;
+    std::vector<float> X;
+    std::vector<float> Y;
+    std::vector<float> Z;
+} _tweens;
+// The tweens that were put in between positions for the frame being drawn
+static std::vector<uint32> _tweensApplied;
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y);
+static void sprite_spatial_link(rct_sprite * sprite, size_t quadrantIndex);
+static void sprite_tween_mark_moved(const rct_sprite * sprite);
+static void sprite_update_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite * sprite);
+static void sprite_spatial_unlink(rct_sprite * sprite, size_t quadrantIndex);
 
 rct_sprite *try_get_sprite(size_t spriteIndex)
 {
     rct_sprite * sprite = nullptr;
-    if (spriteIndex < MAX_SPRITES)
+    if (spriteIndex < _spriteCapacity)
     {
-        sprite = &_spriteList[spriteIndex];
+        sprite = &_spriteChunks[spriteIndex >> SPRITE_CHUNK_SHIFT][spriteIndex & (SPRITE_CHUNK_SIZE - 1)];
     }
     return sprite;
 }
 
 rct_sprite *get_sprite(size_t sprite_idx)
 {
-    openrct2_assert(sprite_idx < MAX_SPRITES, "Tried getting sprite %u", sprite_idx);
-    return &_spriteList[sprite_idx];
+    openrct2_assert(sprite_idx < _spriteCapacity, "Tried getting sprite %u", sprite_idx);
+    return &_spriteChunks[sprite_idx >> SPRITE_CHUNK_SHIFT][sprite_idx & (SPRITE_CHUNK_SIZE - 1)];
+}
+
+/**
+ * Gets the number of sprites the store has room for, used or not.
+ */
+size_t sprite_get_capacity()
+{
+    return _spriteCapacity;
+}
+
+/**
+ * Gets the number of sprites the store may grow to. Games played over the network always stay
+ * within MAX_SPRITES, as saved games are how they are sent.
+ */
+static size_t sprite_get_limit()
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+        return MAX_SPRITES;
+
+    return (size_t)Math::Clamp(MAX_SPRITES, gConfigGeneral.max_sprites, MAX_SPRITES_TECHNICAL);
+}
+
+/**
+ * Gets the number of sprites that can still be created, including those the store can grow by.
+ */
+size_t sprite_get_num_free()
+{
+    size_t limit = sprite_get_limit();
+    size_t growth = limit > _spriteCapacity ? limit - _spriteCapacity : 0;
+    return gSpriteListCount[SPRITE_LIST_NULL] + growth;
+}
+
+/**
+ * Makes room for the given number of sprites, leaving what is in the sprites there to the caller.
+ */
+static void sprite_set_capacity(size_t capacity)
+{
+    size_t numChunks = (capacity + SPRITE_CHUNK_SIZE - 1) >> SPRITE_CHUNK_SHIFT;
+    while (_spriteChunks.size() > numChunks)
+    {
+        _spriteChunks.pop_back();
+    }
+    while (_spriteChunks.size() < numChunks)
+    {
+        _spriteChunks.push_back(std::make_unique<rct_sprite[]>(SPRITE_CHUNK_SIZE));
+    }
+    _spriteCapacity = capacity;
+}
+
+/**
+ * Shrinks the store back to MAX_SPRITES, for when a saved game is about to be loaded into it.
+ */
+void sprite_reset_capacity()
+{
+    sprite_set_capacity(MAX_SPRITES);
+}
+
+/**
+ * Grows the store by a chunk of null sprites, which go to the front of the null sprite list in
+ * order. Returns false when the store may not grow any more.
+ */
+static bool sprite_grow()
+{
+    size_t oldCapacity = _spriteCapacity;
+    size_t newCapacity = std::min(sprite_get_limit(), oldCapacity + SPRITE_CHUNK_SIZE);
+    if (newCapacity <= oldCapacity)
+        return false;
+
+    sprite_set_capacity(newCapacity);
+    for (size_t i = newCapacity; i-- > oldCapacity;)
+    {
+        rct_unk_sprite * sprite = &get_sprite(i)->unknown;
+        memset(sprite, 0, sizeof(rct_sprite));
+        sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        sprite->sprite_index = (uint16)i;
+        sprite->linked_list_type_offset = SPRITE_LIST_NULL * 2;
+        sprite->next_in_quadrant = SPRITE_INDEX_NULL;
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = gSpriteListHead[SPRITE_LIST_NULL];
+        if (sprite->next != SPRITE_INDEX_NULL)
+        {
+            get_sprite(sprite->next)->unknown.previous = (uint16)i;
+        }
+        gSpriteListHead[SPRITE_LIST_NULL] = (uint16)i;
+        gSpriteListCount[SPRITE_LIST_NULL]++;
+        _spriteFlashingList[i] = false;
+    }
+    if (oldCapacity <= MAX_SPRITES)
+    {
+        log_warning("Sprite store grown past %d sprites, the park can not be saved while more are in use", MAX_SPRITES);
+    }
+    log_verbose("Sprite store grown to %u sprites", (uint32)newCapacity);
+    return true;
+}
+
+/**
+ * Gets the number and the size of the sprites of each list, and the memory the store takes.
+ */
+sprite_memory_usage sprite_get_memory_usage()
+{
+    sprite_memory_usage usage = {};
+    for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
+    {
+        usage.Count[i] = gSpriteListCount[i];
+        usage.Bytes[i] = gSpriteListCount[i] * sizeof(rct_sprite);
+    }
+    usage.Capacity = _spriteCapacity;
+    usage.Limit = sprite_get_limit();
+    usage.BytesAllocated = _spriteChunks.size() * SPRITE_CHUNK_SIZE * sizeof(rct_sprite);
+    return usage;
 }
 
 uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y)
@@ -130,7 +285,13 @@ void invalidate_sprite_2(rct_sprite *sprite)
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    memset(_spriteList, 0, sizeof(rct_sprite) * MAX_SPRITES);
+    sprite_reset_capacity();
+    for (auto& chunk : _spriteChunks)
+    {
+        memset(chunk.get(), 0, sizeof(rct_sprite) * SPRITE_CHUNK_SIZE);
+    }
+    guest_store_invalidate();
+    staff_jobs_invalidate_mechanics();
 
     for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++) {
         gSpriteListHead[i] = SPRITE_INDEX_NULL;
@@ -172,14 +333,12 @@ void reset_sprite_list()
  */
 void reset_sprite_spatial_index()
 {
+    litter_index_invalidate();
     std::fill_n(gSpriteSpatialIndex, Util::CountOf(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-    for (size_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < _spriteCapacity; i++) {
         rct_sprite *spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL) {
-            size_t index = GetSpatialIndexOffset(spr->unknown.x, spr->unknown.y);
-            uint16 nextSpriteId = gSpriteSpatialIndex[index];
-            gSpriteSpatialIndex[index] = spr->unknown.sprite_index;
-            spr->unknown.next_in_quadrant = nextSpriteId;
+            sprite_spatial_link(spr, GetSpatialIndexOffset(spr->unknown.x, spr->unknown.y));
         }
     }
 }
@@ -200,6 +359,115 @@ static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
     return index;
 }
 
+/**
+ * Puts the sprite at the head of the chain of the given spatial index bucket.
+ */
+static void sprite_spatial_link(rct_sprite * sprite, size_t quadrantIndex)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    uint16 nextSpriteIndex = gSpriteSpatialIndex[quadrantIndex];
+    gSpriteSpatialIndex[quadrantIndex] = spriteIndex;
+    sprite->unknown.next_in_quadrant = nextSpriteIndex;
+
+    _spritePreviousInQuadrant[spriteIndex] = SPRITE_INDEX_NULL;
+    if (nextSpriteIndex < MAX_SPRITES_TECHNICAL)
+    {
+        _spritePreviousInQuadrant[nextSpriteIndex] = spriteIndex;
+    }
+}
+
+/**
+ * Takes the sprite out of the chain of the given spatial index bucket.
+ */
+static void sprite_spatial_unlink(rct_sprite * sprite, size_t quadrantIndex)
+{
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    uint16 previousSpriteIndex = _spritePreviousInQuadrant[spriteIndex];
+    uint16 * link = nullptr;
+    if (previousSpriteIndex == SPRITE_INDEX_NULL)
+    {
+        link = &gSpriteSpatialIndex[quadrantIndex];
+    }
+    else if (previousSpriteIndex < _spriteCapacity)
+    {
+        link = &get_sprite(previousSpriteIndex)->unknown.next_in_quadrant;
+    }
+
+    _spatialIndexUnlinks++;
+    if (link == nullptr || *link != spriteIndex)
+    {
+        _spatialIndexWalks++;
+        previousSpriteIndex = SPRITE_INDEX_NULL;
+        link = &gSpriteSpatialIndex[quadrantIndex];
+        while (*link != SPRITE_INDEX_NULL && *link != spriteIndex)
+        {
+            previousSpriteIndex = *link;
+            link = &get_sprite(*link)->unknown.next_in_quadrant;
+        }
+    }
+
+    uint16 nextSpriteIndex = sprite->unknown.next_in_quadrant;
+    *link = nextSpriteIndex;
+    if (nextSpriteIndex < MAX_SPRITES_TECHNICAL)
+    {
+        _spritePreviousInQuadrant[nextSpriteIndex] = previousSpriteIndex;
+    }
+}
+
+/**
+ * Gets the sprites within the given rectangle of map coordinates, edges included, from the
+ * spatial index buckets of the tiles it covers. The sprites are given by tile, in the order of the
+ * chain of each bucket.
+ */
+std::vector<rct_sprite *> sprite_get_in_rect(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    std::vector<rct_sprite *> sprites;
+    sint32 leftTile = Math::Max(left, 0) >> 5;
+    sint32 topTile = Math::Max(top, 0) >> 5;
+    sint32 rightTile = Math::Min(right, 0x1FFF) >> 5;
+    sint32 bottomTile = Math::Min(bottom, 0x1FFF) >> 5;
+    for (sint32 tileX = leftTile; tileX <= rightTile; tileX++)
+    {
+        for (sint32 tileY = topTile; tileY <= bottomTile; tileY++)
+        {
+            uint16 spriteIndex = gSpriteSpatialIndex[(tileX << 8) | tileY];
+            while (spriteIndex != SPRITE_INDEX_NULL)
+            {
+                rct_sprite * sprite = get_sprite(spriteIndex);
+                if (sprite->unknown.x >= left && sprite->unknown.x <= right && sprite->unknown.y >= top &&
+                    sprite->unknown.y <= bottom)
+                {
+                    sprites.push_back(sprite);
+                }
+                spriteIndex = sprite->unknown.next_in_quadrant;
+            }
+        }
+    }
+    return sprites;
+}
+
+sprite_spatial_index_statistics sprite_spatial_index_get_statistics()
+{
+    sprite_spatial_index_statistics statistics = {};
+    statistics.Unlinks = _spatialIndexUnlinks;
+    statistics.Walks = _spatialIndexWalks;
+    for (sint32 i = 0; i < SPATIAL_INDEX_LOCATION_NULL; i++)
+    {
+        uint32 length = 0;
+        for (uint16 spriteIndex = gSpriteSpatialIndex[i]; spriteIndex != SPRITE_INDEX_NULL && length <= _spriteCapacity;
+             spriteIndex = get_sprite(spriteIndex)->unknown.next_in_quadrant)
+        {
+            length++;
+        }
+        if (length > 0)
+        {
+            statistics.Buckets++;
+        }
+        statistics.LongestChain = Math::Max(statistics.LongestChain, length);
+    }
+    return statistics;
+}
+
 #ifndef DISABLE_NETWORK
 
 const char * sprite_checksum()
@@ -219,7 +487,7 @@ const char * sprite_checksum()
         }
 
         _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < _spriteCapacity; i++)
         {
             auto sprite = get_sprite(i);
             if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
@@ -320,6 +588,12 @@ void sprite_clear_all_unused()
 */
 rct_sprite *create_sprite(uint8 bl)
 {
+    // Grow before the sprites kept back for other than misc sprites run out
+    if (gSpriteListCount[SPRITE_LIST_NULL] <= 0x12C)
+    {
+        sprite_grow();
+    }
+
     size_t linkedListTypeOffset = SPRITE_LIST_UNKNOWN * 2;
     if ((bl & 2) != 0) {
         // 69EC96;
@@ -340,6 +614,10 @@ rct_sprite *create_sprite(uint8 bl)
     // may contain garbage and cause a desync later on.
     sprite_reset(sprite);
 
+    // Not moved in between from where the sprite before it in this slot was
+    sprite_tween_mark_moved((rct_sprite *)sprite);
+    _tweenMovedFrom[sprite->sprite_index].x = LOCATION_NULL;
+
     sprite->x = LOCATION_NULL;
     sprite->y = LOCATION_NULL;
     sprite->z = 0;
@@ -350,8 +628,7 @@ rct_sprite *create_sprite(uint8 bl)
     sprite->flags = 0;
     sprite->sprite_left = LOCATION_NULL;
 
-    sprite->next_in_quadrant = gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL];
-    gSpriteSpatialIndex[SPATIAL_INDEX_LOCATION_NULL] = sprite->sprite_index;
+    sprite_spatial_link((rct_sprite *)sprite, SPATIAL_INDEX_LOCATION_NULL);
 
     return (rct_sprite*)sprite;
 }
@@ -560,6 +837,8 @@ void sprite_misc_update_all()
  */
 void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
 {
+    sprite_tween_mark_moved(sprite);
+
     if (x < 0 || y < 0 || x > 0x1FFF || y > 0x1FFF) {
         x = LOCATION_NULL;
     }
@@ -567,22 +846,8 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
     size_t newIndex = GetSpatialIndexOffset(x, y);
     size_t currentIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
     if (newIndex != currentIndex) {
-        uint16 *spriteIndex = &gSpriteSpatialIndex[currentIndex];
-        if (*spriteIndex != SPRITE_INDEX_NULL) {
-            rct_sprite *sprite2 = get_sprite(*spriteIndex);
-            while (sprite != sprite2) {
-                spriteIndex = &sprite2->unknown.next_in_quadrant;
-                if (*spriteIndex == SPRITE_INDEX_NULL) {
-                    break;
-                }
-                sprite2 = get_sprite(*spriteIndex);
-            }
-        }
-        *spriteIndex = sprite->unknown.next_in_quadrant;
-
-        sint32 tempSpriteIndex = gSpriteSpatialIndex[newIndex];
-        gSpriteSpatialIndex[newIndex] = sprite->unknown.sprite_index;
-        sprite->unknown.next_in_quadrant = tempSpriteIndex;
+        sprite_spatial_unlink(sprite, currentIndex);
+        sprite_spatial_link(sprite, newIndex);
     }
 
     if (x == LOCATION_NULL) {
@@ -591,11 +856,21 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
         sprite->unknown.y = y;
         sprite->unknown.z = z;
     } else {
-        sprite_set_coordinates(x, y, z, sprite);
+        sprite_update_coordinates(x, y, z, sprite);
+    }
+
+    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        guest_store_update(&sprite->peep);
     }
 }
 
-void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
+void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
+{
+    sprite_tween_mark_moved(sprite);
+    sprite_update_coordinates(x, y, z, sprite);
+}
+
+static void sprite_update_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
     sint16 new_x = x, new_y = y, start_x = x;
     switch (get_current_rotation()){
     case 0:
@@ -631,19 +906,21 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+    if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+    {
+        litter_index_remove(&sprite->litter);
+    }
+    else if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_PEEP * 2)
+    {
+        guest_store_remove(&sprite->peep);
+    }
+
     move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
     user_string_free(sprite->unknown.name_string_idx);
     sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->unknown.sprite_index] = false;
 
-    size_t quadrantIndex = GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y);
-    uint16 *spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
-    rct_sprite *quadrantSprite;
-    while (*spriteIndex != SPRITE_INDEX_NULL && (quadrantSprite = get_sprite(*spriteIndex)) != sprite)
-    {
-        spriteIndex = &quadrantSprite->unknown.next_in_quadrant;
-    }
-    *spriteIndex = sprite->unknown.next_in_quadrant;
+    sprite_spatial_unlink(sprite, GetSpatialIndexOffset(sprite->unknown.x, sprite->unknown.y));
 }
 
 static bool litter_can_be_at(sint32 x, sint32 y, sint32 z)
@@ -717,6 +994,7 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
     sprite_move(x, y, z, (rct_sprite*)litter);
     invalidate_sprite_0((rct_sprite*)litter);
     litter->creationTick = gScenarioTicks;
+    litter_index_add(litter);
 }
 
 /**
@@ -725,28 +1003,20 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
  */
 void litter_remove_at(sint32 x, sint32 y, sint32 z)
 {
-    uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
-    while (spriteIndex != SPRITE_INDEX_NULL) {
-        rct_sprite *sprite = get_sprite(spriteIndex);
-        uint16 nextSpriteIndex = sprite->unknown.next_in_quadrant;
-        if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2) {
-            rct_litter *litter = &sprite->litter;
-
-            if (abs(litter->z - z) <= 16) {
-                if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8) {
-                    invalidate_sprite_0(sprite);
-                    sprite_remove(sprite);
-                }
+    for (rct_litter *litter : litter_index_get_on_tile(x, y)) {
+        if (abs(litter->z - z) <= 16) {
+            if (abs(litter->x - x) <= 8 && abs(litter->y - y) <= 8) {
+                invalidate_sprite_0((rct_sprite*)litter);
+                sprite_remove((rct_sprite*)litter);
             }
         }
-        spriteIndex = nextSpriteIndex;
     }
 }
 
 /**
  * Determines whether it's worth tweening a sprite or not when frame smoothing is on.
  */
-static bool sprite_should_tween(rct_sprite *sprite)
+static bool sprite_should_tween(const rct_sprite *sprite)
 {
     switch (sprite->unknown.linked_list_type_offset >> 1) {
     case SPRITE_LIST_TRAIN:
@@ -757,48 +1027,144 @@ static bool sprite_should_tween(rct_sprite *sprite)
     return false;
 }
 
-static void store_sprite_locations(LocationXYZ16 * sprite_locations)
+/**
+ * Notes where the sprite was before it first moves after the positions were last stored.
+ */
+static void sprite_tween_mark_moved(const rct_sprite * sprite)
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        // skip going through `get_sprite` to not get stalled on assert,
-        // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite *sprite = &_spriteList[i];
-        sprite_locations[i].x = sprite->unknown.x;
-        sprite_locations[i].y = sprite->unknown.y;
-        sprite_locations[i].z = sprite->unknown.z;
+    uint16 spriteIndex = sprite->unknown.sprite_index;
+    if (spriteIndex >= MAX_SPRITES_TECHNICAL || _tweenMoved[spriteIndex])
+        return;
+
+    _tweenMoved[spriteIndex] = true;
+    _tweenMovedFrom[spriteIndex] = { sprite->unknown.x, sprite->unknown.y, sprite->unknown.z };
+    _tweenMovedSprites.push_back(spriteIndex);
+}
+
+static void sprite_tween_clear_moved()
+{
+    for (uint16 spriteIndex : _tweenMovedSprites)
+    {
+        _tweenMoved[spriteIndex] = false;
     }
+    _tweenMovedSprites.clear();
+}
+
+static void sprite_tween_clear()
+{
+    _tweens.SpriteIndex.clear();
+    _tweens.FromX.clear();
+    _tweens.FromY.clear();
+    _tweens.FromZ.clear();
+    _tweens.ToX.clear();
+    _tweens.ToY.clear();
+    _tweens.ToZ.clear();
+    _tweensApplied.clear();
 }
 
+/**
+ * Whether the sprite can be seen in a viewport that draws sprites, anywhere between its position
+ * and the given distance from it.
+ */
+static bool sprite_tween_is_visible(const rct_sprite * sprite, sint32 distance)
+{
+    if (sprite->unknown.sprite_left == LOCATION_NULL)
+        return false;
+
+    for (sint32 i = 0; i < MAX_VIEWPORT_COUNT; i++)
+    {
+        const rct_viewport * viewport = &g_viewport_list[i];
+        if (viewport->width == 0 || viewport->zoom > 2)
+            continue;
+
+        if (sprite->unknown.sprite_right + distance > viewport->view_x &&
+            sprite->unknown.sprite_left - distance < viewport->view_x + viewport->view_width &&
+            sprite->unknown.sprite_bottom + distance > viewport->view_y &&
+            sprite->unknown.sprite_top - distance < viewport->view_y + viewport->view_height)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Stores the position of each sprite before a tick, by forgetting which sprites have moved.
+ */
 void sprite_position_tween_store_a()
 {
-    store_sprite_locations(_spritelocations1);
+    sprite_tween_clear_moved();
 }
 
+/**
+ * Stores the position of each sprite after a tick, keeping the sprites that have moved during it.
+ */
 void sprite_position_tween_store_b()
 {
-    store_sprite_locations(_spritelocations2);
+    sprite_tween_clear();
+    for (uint16 spriteIndex : _tweenMovedSprites)
+    {
+        const rct_sprite * sprite = get_sprite(spriteIndex);
+        if (!sprite_should_tween(sprite))
+            continue;
+
+        LocationXYZ16 from = _tweenMovedFrom[spriteIndex];
+        if (from.x == sprite->unknown.x && from.y == sprite->unknown.y && from.z == sprite->unknown.z)
+            continue;
+
+        // Sprites that appear or disappear are not moved in between
+        if (from.x == LOCATION_NULL || sprite->unknown.x == LOCATION_NULL)
+            continue;
+
+        _tweens.SpriteIndex.push_back(spriteIndex);
+        _tweens.FromX.push_back(from.x);
+        _tweens.FromY.push_back(from.y);
+        _tweens.FromZ.push_back(from.z);
+        _tweens.ToX.push_back(sprite->unknown.x);
+        _tweens.ToY.push_back(sprite->unknown.y);
+        _tweens.ToZ.push_back(sprite->unknown.z);
+    }
+    sprite_tween_clear_moved();
 }
 
+/**
+ * Puts the sprites that moved during the last tick in between where they were before and after
+ * it, for the frame about to be drawn. Sprites that cannot be seen are left where they are.
+ */
 void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
-        if (sprite_should_tween(sprite)) {
-            LocationXYZ16 posA = _spritelocations1[i];
-            LocationXYZ16 posB = _spritelocations2[i];
-            if (posA.x == posB.x && posA.y == posB.y && posA.z == posB.z) {
-                continue;
-            }
-            sprite_set_coordinates(
-                std::round(posB.x * alpha + posA.x * inv),
-                std::round(posB.y * alpha + posA.y * inv),
-                std::round(posB.z * alpha + posA.z * inv),
-                sprite
-            );
-            invalidate_sprite_2(sprite);
-        }
+    size_t count = _tweens.SpriteIndex.size();
+    _tweens.X.resize(count);
+    _tweens.Y.resize(count);
+    _tweens.Z.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        _tweens.X[i] = _tweens.ToX[i] * alpha + _tweens.FromX[i] * inv;
+        _tweens.Y[i] = _tweens.ToY[i] * alpha + _tweens.FromY[i] * inv;
+        _tweens.Z[i] = _tweens.ToZ[i] * alpha + _tweens.FromZ[i] * inv;
+    }
+
+    _tweensApplied.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        rct_sprite * sprite = get_sprite(_tweens.SpriteIndex[i]);
+        if (!sprite_should_tween(sprite))
+            continue;
+
+        // Left alone if moved again since, by a game command run between ticks
+        if (sprite->unknown.x != _tweens.ToX[i] || sprite->unknown.y != _tweens.ToY[i] || sprite->unknown.z != _tweens.ToZ[i])
+            continue;
+
+        sint32 distance = (sint32)(std::abs(_tweens.ToX[i] - _tweens.FromX[i]) + std::abs(_tweens.ToY[i] - _tweens.FromY[i]) +
+                                   std::abs(_tweens.ToZ[i] - _tweens.FromZ[i])) + 1;
+        if (!sprite_tween_is_visible(sprite, distance))
+            continue;
+
+        sprite_update_coordinates(std::round(_tweens.X[i]), std::round(_tweens.Y[i]), std::round(_tweens.Z[i]), sprite);
+        invalidate_sprite_2(sprite);
+        _tweensApplied.push_back((uint32)i);
     }
 }
 
@@ -807,39 +1173,30 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
-        if (sprite_should_tween(sprite)) {
-            invalidate_sprite_2(sprite);
-
-            LocationXYZ16 pos = _spritelocations2[i];
-            sprite_set_coordinates(pos.x, pos.y, pos.z, sprite);
-        }
+    for (uint32 i : _tweensApplied)
+    {
+        rct_sprite * sprite = get_sprite(_tweens.SpriteIndex[i]);
+        invalidate_sprite_2(sprite);
+        sprite_update_coordinates((sint16)_tweens.ToX[i], (sint16)_tweens.ToY[i], (sint16)_tweens.ToZ[i], sprite);
     }
+    _tweensApplied.clear();
 }
 
 void sprite_position_tween_reset()
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
-        _spritelocations1[i].x =
-        _spritelocations2[i].x = sprite->unknown.x;
-        _spritelocations1[i].y =
-        _spritelocations2[i].y = sprite->unknown.y;
-        _spritelocations1[i].z =
-        _spritelocations2[i].z = sprite->unknown.z;
-    }
+    sprite_tween_clear_moved();
+    sprite_tween_clear();
 }
 
 void sprite_set_flashing(rct_sprite *sprite, bool flashing)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < _spriteCapacity);
     _spriteFlashingList[sprite->unknown.sprite_index] = flashing;
 }
 
 bool sprite_get_flashing(rct_sprite *sprite)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < _spriteCapacity);
     return _spriteFlashingList[sprite->unknown.sprite_index];
 }
 
@@ -973,7 +1330,7 @@ sint32 check_for_sprite_list_cycles(bool fix)
 sint32 fix_disjoint_sprites()
 {
     // Find reachable sprites
-    bool reachable[MAX_SPRITES] = { false };
+    std::vector<bool> reachable(_spriteCapacity, false);
     uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_NULL];
     rct_sprite * null_list_tail = nullptr;
     while (sprite_idx != SPRITE_INDEX_NULL)
@@ -987,7 +1344,7 @@ sint32 fix_disjoint_sprites()
     sint32 count = 0;
 
     // Find all null sprites
-    for (sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (sprite_idx = 0; sprite_idx < _spriteCapacity; sprite_idx++)
     {
         rct_sprite * spr = get_sprite(sprite_idx);
         if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -10,12 +10,16 @@
 #ifndef _SPRITE_H_
 #define _SPRITE_H_
 
+#include <vector>
 #include "../common.h"
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
 
 #define SPRITE_INDEX_NULL       0xFFFF
+// The number of sprites the store starts with, and all that saved games can hold
 #define MAX_SPRITES             10000
+// The most the store can grow to, as sprite indices need to fit in 16 bits
+#define MAX_SPRITES_TECHNICAL   65000
 #define NUM_SPRITE_LISTS        6
 
 enum SPRITE_IDENTIFIER {
@@ -372,8 +376,29 @@ enum {
     LITTER_TYPE_EMPTY_BOWL_BLUE,
 };
 
+struct sprite_memory_usage
+{
+    uint32 Count[NUM_SPRITE_LISTS];
+    size_t Bytes[NUM_SPRITE_LISTS];
+    size_t Capacity;
+    size_t Limit;
+    size_t BytesAllocated;
+};
+
+struct sprite_spatial_index_statistics
+{
+    uint32 Unlinks;
+    uint32 Walks;
+    uint32 Buckets;
+    uint32 LongestChain;
+};
+
 rct_sprite *try_get_sprite(size_t spriteIndex);
 rct_sprite *get_sprite(size_t sprite_idx);
+size_t sprite_get_capacity();
+size_t sprite_get_num_free();
+void sprite_reset_capacity();
+sprite_memory_usage sprite_get_memory_usage();
 
 extern uint16 gSpriteListHead[6];
 extern uint16 gSpriteListCount[6];
@@ -399,6 +424,8 @@ void litter_remove_at(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_cloud_create(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_flare_create(sint32 x, sint32 y, sint32 z);
 uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y);
+std::vector<rct_sprite *> sprite_get_in_rect(sint32 left, sint32 top, sint32 right, sint32 bottom);
+sprite_spatial_index_statistics sprite_spatial_index_get_statistics();
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
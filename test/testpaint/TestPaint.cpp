@@ -43,6 +43,7 @@ namespace TestPaint
         dpi.zoom_level = 1;
         RCT2_Unk140E9A8 = &dpi;
         gPaintSession.DPI = &dpi;
+        gPaintSession.PaintEntries.Clear();
 
         {
             Ride ride = {};
@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/world/Ambience.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Scenery.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class Ambience : public ParkTest
+{
+protected:
+    /**
+     * Counts the given area element by element, the way guests used to.
+     */
+    static ambience_counts CountTiles(sint32 left, sint32 top, sint32 right, sint32 bottom)
+    {
+        ambience_counts result = {};
+        for (sint32 y = std::max(top, 0); y <= std::min(bottom, MAXIMUM_MAP_SIZE_TECHNICAL - 1); y++)
+        {
+            for (sint32 x = std::max(left, 0); x <= std::min(right, MAXIMUM_MAP_SIZE_TECHNICAL - 1); x++)
+            {
+                rct_tile_element * tileElement = map_get_first_element_at(x, y);
+                do
+                {
+                    switch (tileElement->GetType())
+                    {
+                    case TILE_ELEMENT_TYPE_PATH:
+                    {
+                        if (!footpath_element_has_path_scenery(tileElement))
+                            break;
+
+                        rct_scenery_entry * scenery = get_footpath_item_entry(footpath_element_get_path_scenery_index(tileElement));
+                        if (scenery == nullptr)
+                            result.MissingItems++;
+                        else if (footpath_element_path_scenery_is_ghost(tileElement))
+                            break;
+                        else if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
+                            result.Fountains++;
+                        else if (tileElement->flags & TILE_ELEMENT_FLAG_BROKEN)
+                            result.BrokenItems++;
+                        break;
+                    }
+                    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+                        result.Scenery++;
+                        break;
+                    }
+                } while (!(tileElement++)->IsLastForTile());
+            }
+        }
+        return result;
+    }
+
+    static void ExpectCountsMatch()
+    {
+        for (sint32 y = -5; y < MAXIMUM_MAP_SIZE_TECHNICAL; y += 3)
+        {
+            for (sint32 x = -5; x < MAXIMUM_MAP_SIZE_TECHNICAL; x += 3)
+            {
+                ambience_counts expected = CountTiles(x - 5, y - 5, x + 4, y + 4);
+                ambience_counts counts = ambience_get_counts(x - 5, y - 5, x + 4, y + 4);
+                ASSERT_EQ(expected.Scenery, counts.Scenery);
+                ASSERT_EQ(expected.Fountains, counts.Fountains);
+                ASSERT_EQ(expected.BrokenItems, counts.BrokenItems);
+                ASSERT_EQ(expected.MissingItems, counts.MissingItems);
+            }
+        }
+    }
+};
+
+TEST_F(Ambience, CountsMatchTileScan)
+{
+    ExpectCountsMatch();
+}
+
+TEST_F(Ambience, VandalisedItemsAreCounted)
+{
+    ExpectCountsMatch();
+
+    // Break every other path item, as vandals do
+    sint32 numBroken = 0;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (it.element->GetType() == TILE_ELEMENT_TYPE_PATH && footpath_element_has_path_scenery(it.element) &&
+            (numBroken++ % 2) == 0)
+        {
+            it.element->flags |= TILE_ELEMENT_FLAG_BROKEN;
+            ambience_invalidate_tile(it.x, it.y);
+        }
+    } while (tile_element_iterator_next(&it));
+
+    ExpectCountsMatch();
+}
+
+TEST_F(Ambience, RemovedSceneryIsNotCounted)
+{
+    ExpectCountsMatch();
+
+    // The counts follow the tiles that elements are removed from, without being told
+    sint32 numScenery = 0;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        uint8 type = it.element->GetType();
+        if ((type == TILE_ELEMENT_TYPE_SMALL_SCENERY || type == TILE_ELEMENT_TYPE_LARGE_SCENERY) && (numScenery++ % 2) == 0)
+        {
+            tile_element_remove(it.element);
+            tile_element_iterator_restart_for_tile(&it);
+        }
+    } while (tile_element_iterator_next(&it));
+
+    ExpectCountsMatch();
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathConnectivity.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class FootpathConnectivity : public ParkTest
+{
+};
+
+TEST_F(FootpathConnectivity, SameAsSearch)
+{
+    sint32 compared = 0;
+    for (sint32 y = 1; y < gMapSize - 1; y++)
+    {
+        for (sint32 x = 1; x < gMapSize - 1; x++)
+        {
+            rct_tile_element * tileElement = map_get_first_element_at(x, y);
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+                    continue;
+
+                for (sint32 direction = 0; direction < 4; direction++)
+                {
+                    // Walk onto the path from the tile behind it
+                    sint32 fromX = x * 32 - CoordsDirectionDelta[direction].x;
+                    sint32 fromY = y * 32 - CoordsDirectionDelta[direction].y;
+                    for (sint32 flags : { 0, 1 << 7 })
+                    {
+                        // Outside of the editor the unown flag does not change the map, only makes
+                        // the search walk the path itself
+                        sint32 expected = footpath_is_connected_to_map_edge(
+                            fromX, fromY, tileElement->base_height, direction, flags | (1 << 5));
+                        if (expected == FOOTPATH_SEARCH_TOO_COMPLEX)
+                            continue;
+
+                        sint32 result = footpath_is_connected_to_map_edge(
+                            fromX, fromY, tileElement->base_height, direction, flags);
+                        EXPECT_EQ(result, expected) << "at " << x << ", " << y << ", " << (sint32)tileElement->base_height
+                                                    << " direction " << direction << " flags " << flags;
+                        compared++;
+                    }
+                }
+            }
+            while (!(tileElement++)->IsLastForTile());
+        }
+    }
+    EXPECT_GT(compared, 0);
+
+    // Built once for the whole map with and once without no entry signs rather than for each query
+    auto statistics = footpath_connectivity_get_statistics();
+    EXPECT_EQ(statistics.Builds, 2u);
+    EXPECT_GT(statistics.Elements, 0u);
+}
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/Context.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/world/Entrance.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathGraph.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class FootpathGraph : public ParkTest, public testing::WithParamInterface<const char *>
+{
+protected:
+    void SetUp() override
+    {
+        LoadPark(GetParam());
+    }
+
+    void TearDown() override
+    {
+        footpath_graph_set_enabled(true);
+        gConfigGeneral.pathfinding_graph_search = false;
+        ParkTest::TearDown();
+    }
+
+    /**
+     * Chooses the direction of every peep towards every park entrance, restoring the peeps after
+     * each choice. Returns the directions followed by the junctions the peeps remember.
+     */
+    static std::vector<sint32> ChooseDirections()
+    {
+        std::vector<sint32> result;
+        uint16 spriteIndex;
+        rct_peep * peep;
+        FOR_ALL_PEEPS(spriteIndex, peep)
+        {
+            for (const auto& entrance : gParkEntrances)
+            {
+                if (entrance.x == LOCATION_NULL)
+                    continue;
+
+                rct_peep savedPeep = *peep;
+                gPeepPathFindGoalPosition = { entrance.x / 32, entrance.y / 32, entrance.z / 8 };
+                gPeepPathFindIgnoreForeignQueues = true;
+                gPeepPathFindQueueRideIndex = 255;
+                TileCoordsXYZ loc = { peep->next_x / 32, peep->next_y / 32, peep->next_z };
+                result.push_back(peep_pathfind_choose_direction(loc, peep));
+                for (const auto& history : peep->pathfind_history)
+                {
+                    result.push_back(history.x | (history.y << 8) | (history.z << 16) | (history.direction << 24));
+                }
+                *peep = savedPeep;
+            }
+        }
+        return result;
+    }
+};
+
+TEST_P(FootpathGraph, SegmentsMatchTileByTileSearch)
+{
+    footpath_graph_set_enabled(false);
+    auto expected = ChooseDirections();
+
+    footpath_graph_set_enabled(true);
+    auto built = ChooseDirections();
+    uint32 hitsBefore = footpath_graph_get_statistics().Hits;
+    auto cached = ChooseDirections();
+    uint32 hits = footpath_graph_get_statistics().Hits - hitsBefore;
+
+    EXPECT_EQ(expected, built);
+    EXPECT_EQ(expected, cached);
+    EXPECT_GT(hits, 0u);
+}
+
+TEST_P(FootpathGraph, WidePathUpdatesKeepSegmentsCurrent)
+{
+    ChooseDirections();
+
+    // Clear all the wide flags and let the game set them again, one batch of tiles at a time
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (it.element->GetType() == TILE_ELEMENT_TYPE_PATH)
+            footpath_element_set_wide(it.element, false);
+    } while (tile_element_iterator_next(&it));
+    footpath_graph_invalidate_all();
+    ChooseDirections();
+    for (sint32 i = 0; i < (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) / 128; i++)
+    {
+        map_update_path_wide_flags();
+    }
+    auto updated = ChooseDirections();
+
+    footpath_graph_invalidate_all();
+    auto expected = ChooseDirections();
+    EXPECT_EQ(expected, updated);
+}
+
+INSTANTIATE_TEST_CASE_P(SampleParks, FootpathGraph, testing::Values("bpb.sv6", "tile-element-tests.sv6"));
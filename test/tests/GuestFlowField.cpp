@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/peep/GuestFlowField.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/world/Entrance.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathGraph.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class GuestFlowField : public ParkTest
+{
+protected:
+    void TearDown() override
+    {
+        guest_flow_field_clear();
+        ParkTest::TearDown();
+    }
+
+    /**
+     * Walks from the path at the given location in the given direction onto the next path.
+     */
+    static bool WalkOneTile(TileCoordsXYZ& loc, sint32 direction)
+    {
+        rct_tile_element * tileElement = map_get_first_element_at(loc.x, loc.y);
+        sint32 height = loc.z;
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->base_height == loc.z &&
+                footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == direction)
+            {
+                height += 2;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+
+        loc += TileDirectionDelta[direction];
+        tileElement = map_get_first_element_at(loc.x, loc.y);
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && is_valid_path_z_and_direction(tileElement, height, direction))
+            {
+                loc.z = tileElement->base_height;
+                return true;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+        loc.z = height;
+        return false;
+    }
+};
+
+TEST_F(GuestFlowField, DirectionsLeadToGoal)
+{
+    sint32 numWalks = 0;
+    for (const auto& entrance : gParkEntrances)
+    {
+        if (entrance.x == LOCATION_NULL)
+            continue;
+
+        TileCoordsXYZ goal = { entrance.x / 32, entrance.y / 32, entrance.z / 8 };
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        do
+        {
+            if (it.element->GetType() != TILE_ELEMENT_TYPE_PATH)
+                continue;
+
+            TileCoordsXYZ loc = { it.x, it.y, it.element->base_height };
+            sint32 direction = guest_flow_field_get_direction(goal, loc);
+            if (direction == -1)
+                continue;
+
+            // Every tile along the way has to know the way on
+            sint32 steps = 0;
+            while (true)
+            {
+                ASSERT_LT(++steps, 256 * 256);
+                bool onPath = WalkOneTile(loc, direction);
+                if (loc.x == goal.x && loc.y == goal.y && loc.z == goal.z)
+                    break;
+                ASSERT_TRUE(onPath);
+                direction = guest_flow_field_get_direction(goal, loc);
+                ASSERT_NE(direction, -1);
+            }
+            numWalks++;
+        } while (tile_element_iterator_next(&it));
+    }
+    EXPECT_GT(numWalks, 0);
+}
+
+TEST_F(GuestFlowField, RebuiltAfterFootpathChange)
+{
+    TileCoordsXYZ goal = { gParkEntrances[0].x / 32, gParkEntrances[0].y / 32, gParkEntrances[0].z / 8 };
+    guest_flow_field_get_direction(goal, goal);
+    guest_flow_field_get_direction(goal, goal);
+    auto statistics = guest_flow_field_get_statistics();
+    EXPECT_EQ(statistics.Fields, 1u);
+    EXPECT_GT(statistics.Hits, 0u);
+
+    footpath_graph_invalidate_tile(goal.x, goal.y);
+    guest_flow_field_get_direction(goal, goal);
+    EXPECT_EQ(guest_flow_field_get_statistics().Misses, statistics.Misses + 1);
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/GameState.h>
+#include <openrct2/peep/GuestStore.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+constexpr sint32 updatesToTest = 600;
+
+class GuestStore : public ParkTest
+{
+protected:
+    /**
+     * Checks the counts of the store against counts made by going over all guests.
+     */
+    static void ExpectSameAsGuests()
+    {
+        guest_store_park_counts expected = {};
+        sint32 expectedTracked = 0;
+        sint32 expectedCrowd = 0;
+        uint16 spriteIndex;
+        rct_peep * peep;
+        FOR_ALL_GUESTS(spriteIndex, peep)
+        {
+            if (peep->sprite_left != LOCATION_NULL && peep->sprite_right >= 0 && peep->sprite_left <= 4096 &&
+                peep->sprite_bottom >= 0 && peep->sprite_top <= 4096)
+            {
+                expectedCrowd += peep->state == PEEP_STATE_QUEUING ? 1 : 2;
+            }
+            if (peep->outside_of_park != 0)
+                continue;
+
+            expected.InPark++;
+            if (peep->happiness > 128)
+                expected.Happy++;
+            if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && peep->peep_is_lost_countdown < 90)
+                expected.Lost++;
+            if (peep->peep_flags & PEEP_FLAGS_TRACKING)
+                expectedTracked++;
+        }
+
+        auto counts = guest_store_get_park_counts();
+        EXPECT_EQ(counts.InPark, expected.InPark);
+        EXPECT_EQ(counts.Happy, expected.Happy);
+        EXPECT_EQ(counts.Lost, expected.Lost);
+        EXPECT_EQ(guest_store_count_in_park(0), expected.InPark);
+        EXPECT_EQ(guest_store_count_in_park(PEEP_FLAGS_TRACKING), expectedTracked);
+        EXPECT_EQ(guest_store_get_crowd_size(0, 0, 4096, 4096), expectedCrowd);
+    }
+};
+
+TEST_F(GuestStore, CountsMatchGuestsWhilePlaying)
+{
+    ExpectSameAsGuests();
+    auto statistics = guest_store_get_statistics();
+    EXPECT_GT(statistics.Guests, 0u);
+
+    auto gs = _context->GetGameState();
+    for (sint32 i = 0; i < updatesToTest; i++)
+    {
+        gs->UpdateLogic();
+        if (i % 50 == 0)
+        {
+            ExpectSameAsGuests();
+        }
+    }
+    ExpectSameAsGuests();
+
+    // Kept up to date while playing rather than built again
+    EXPECT_EQ(guest_store_get_statistics().Rebuilds, statistics.Rebuilds);
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/Context.h>
+#include <openrct2/GameState.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/scenario/Scenario.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+constexpr sint32 updatesToTest = 200;
+
+class GuestThink : public ParkTest
+{
+protected:
+    void SetUp() override
+    {
+        // The park is loaded by Play, once for each number of think threads
+    }
+
+    void TearDown() override
+    {
+        gConfigGeneral.guest_think_threads = 0;
+        ParkTest::TearDown();
+    }
+
+    /**
+     * Plays the park for a while with the given number of think threads. Returns where every peep
+     * ended up, followed by the state of the random number generator.
+     */
+    std::vector<sint32> Play(sint32 numThreads)
+    {
+        gConfigGeneral.guest_think_threads = numThreads;
+        LoadPark("bpb.sv6");
+
+        auto gs = _context->GetGameState();
+        for (sint32 i = 0; i < updatesToTest; i++)
+        {
+            gs->UpdateLogic();
+        }
+
+        std::vector<sint32> result;
+        uint16 spriteIndex;
+        rct_peep * peep;
+        FOR_ALL_PEEPS(spriteIndex, peep)
+        {
+            result.push_back(peep->sprite_index);
+            result.push_back(peep->x | (peep->y << 16));
+            result.push_back(peep->z | (peep->sprite_direction << 16));
+            result.push_back(peep->state | (peep->action << 8) | (peep->pathfind_goal.direction << 16));
+            for (const auto& history : peep->pathfind_history)
+            {
+                result.push_back(history.x | (history.y << 8) | (history.z << 16) | (history.direction << 24));
+            }
+        }
+        result.push_back((sint32)gScenarioSrand0);
+        result.push_back((sint32)gScenarioSrand1);
+        return result;
+    }
+};
+
+TEST_F(GuestThink, ThreadsPlayTheSameAsSerial)
+{
+    auto expected = Play(0);
+
+    auto statisticsBefore = guest_path_finding_get_think_statistics();
+    auto threaded = Play(4);
+    auto statistics = guest_path_finding_get_think_statistics();
+
+    EXPECT_EQ(expected, threaded);
+    EXPECT_GT(statistics.Used, statisticsBefore.Used);
+}
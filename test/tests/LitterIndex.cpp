@@ -0,0 +1,115 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/world/LitterIndex.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class LitterIndex : public ParkTest
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_NO_FATAL_FAILURE(ParkTest::SetUp());
+
+        // Drop litter on the paths of the park
+        sint32 i = 0;
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        do
+        {
+            if (it.element->GetType() == TILE_ELEMENT_TYPE_PATH && (i++ % 3) == 0)
+            {
+                litter_create(it.x * 32 + 16, it.y * 32 + 16, it.element->base_height * 8, i & 3, LITTER_TYPE_RUBBISH);
+            }
+        } while (tile_element_iterator_next(&it));
+    }
+
+    static std::vector<rct_litter *> GetAllLitter()
+    {
+        std::vector<rct_litter *> result;
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+             spriteIndex = get_sprite(spriteIndex)->unknown.next)
+        {
+            result.push_back(&get_sprite(spriteIndex)->litter);
+        }
+        return result;
+    }
+};
+
+TEST_F(LitterIndex, QueriesMatchFullScan)
+{
+    auto allLitter = GetAllLitter();
+    ASSERT_FALSE(allLitter.empty());
+
+    for (size_t i = 0; i < allLitter.size(); i += 7)
+    {
+        sint32 x = allLitter[i]->x + 40;
+        sint32 y = allLitter[i]->y - 24;
+        sint32 z = allLitter[i]->z;
+
+        // Nearest litter
+        std::vector<rct_litter *> expected;
+        for (auto litter : allLitter)
+        {
+            if (abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4 <= 0x60)
+                expected.push_back(litter);
+        }
+        // Ties are broken by the order of the litter list
+        std::stable_sort(expected.begin(), expected.end(), [x, y, z](const rct_litter * a, const rct_litter * b) {
+            sint32 distanceA = abs(a->x - x) + abs(a->y - y) + abs(a->z - z) * 4;
+            sint32 distanceB = abs(b->x - x) + abs(b->y - y) + abs(b->z - z) * 4;
+            return distanceA < distanceB;
+        });
+        expected.resize(std::min<size_t>(expected.size(), 4));
+
+        rct_litter * nearest[4];
+        size_t count = litter_index_find_nearest(x, y, z, 0x60, nearest, 4);
+        EXPECT_EQ(expected, std::vector<rct_litter *>(nearest, nearest + count));
+
+        // Litter nearby
+        uint32 expectedCount = 0;
+        for (auto litter : allLitter)
+        {
+            if (abs(litter->x - x) <= 160 && abs(litter->y - y) <= 160)
+                expectedCount++;
+        }
+        EXPECT_EQ(expectedCount, litter_index_count_within(x, y, 160));
+    }
+}
+
+TEST_F(LitterIndex, RemovedLitterLeavesIndex)
+{
+    auto allLitter = GetAllLitter();
+    ASSERT_FALSE(allLitter.empty());
+
+    rct_litter * litter = allLitter.front();
+    sint32 x = litter->x;
+    sint32 y = litter->y;
+    sint32 z = litter->z;
+    EXPECT_FALSE(litter_index_get_on_tile(x, y).empty());
+
+    litter_remove_at(x, y, z);
+    for (auto remaining : litter_index_get_on_tile(x, y))
+    {
+        EXPECT_GT(abs(remaining->z - z), 16);
+    }
+    EXPECT_LT(GetAllLitter().size(), allLitter.size());
+
+    // The index follows the sprites when it is built again
+    uint32 count = litter_index_count_within(x, y, 256);
+    litter_index_invalidate();
+    EXPECT_EQ(count, litter_index_count_within(x, y, 256));
+}
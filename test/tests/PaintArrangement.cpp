@@ -0,0 +1,118 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/Game.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+class PaintArrangement : public ParkTest, public testing::WithParamInterface<const char *>
+{
+protected:
+    void SetUp() override
+    {
+        LoadPark(GetParam(), true);
+    }
+
+    static std::vector<paint_struct *> GetDrawOrder(const paint_struct& psHead)
+    {
+        std::vector<paint_struct *> result;
+        for (paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            result.push_back(ps);
+        }
+        return result;
+    }
+
+    static std::vector<paint_struct *> ArrangeColumn(rct_drawpixelinfo * dpi, bool legacy)
+    {
+        paint_session * session = paint_session_alloc(dpi);
+        paint_session_generate(session);
+        paint_struct psHead = legacy ? paint_session_arrange_legacy(session) : paint_session_arrange(session);
+        auto result = GetDrawOrder(psHead);
+        paint_session_free(session);
+        return result;
+    }
+
+    /**
+     * Arranges every column covering the whole map with both algorithms and returns the number of
+     * columns whose draw order differs.
+     */
+    static sint32 CompareMap(uint8 rotation, uint8 zoom)
+    {
+        gCurrentRotation = rotation;
+        reset_all_sprite_quadrant_placements();
+
+        sint32 centreX = (gMapSize / 2) * 32 + 16;
+        sint32 centreY = (gMapSize / 2) * 32 + 16;
+        sint32 z = tile_element_height(centreX, centreY) & 0xFFFF;
+        sint32 viewX = 0, viewY = 0;
+        switch (rotation)
+        {
+        case 0:
+            viewX = centreY - centreX;
+            viewY = ((centreX + centreY) / 2) - z;
+            break;
+        case 1:
+            viewX = -centreY - centreX;
+            viewY = ((-centreX + centreY) / 2) - z;
+            break;
+        case 2:
+            viewX = -centreY + centreX;
+            viewY = ((-centreX - centreY) / 2) - z;
+            break;
+        case 3:
+            viewX = centreY + centreX;
+            viewY = ((centreX - centreY) / 2) - z;
+            break;
+        }
+
+        sint32 viewWidth = (gMapSize * 32 * 2) + 8;
+        sint32 viewHeight = (gMapSize * 32 * 1) + 128;
+        sint32 mask = 0xFFFF << zoom;
+        viewX = (viewX - viewWidth / 2) & mask;
+        viewY = (viewY - viewHeight / 2) & mask;
+
+        sint32 numDifferent = 0;
+        for (sint32 x = floor2(viewX, 32); x < viewX + viewWidth; x += 32)
+        {
+            rct_drawpixelinfo dpi = {};
+            dpi.x = x;
+            dpi.y = viewY;
+            dpi.width = 32;
+            dpi.height = viewHeight;
+            dpi.zoom_level = zoom;
+
+            auto expected = ArrangeColumn(&dpi, true);
+            auto actual = ArrangeColumn(&dpi, false);
+            if (expected != actual)
+            {
+                numDifferent++;
+            }
+        }
+        return numDifferent;
+    }
+};
+
+TEST_P(PaintArrangement, MatchesLegacyOrder)
+{
+    for (uint8 rotation = 0; rotation < 4; rotation++)
+    {
+        for (uint8 zoom = 0; zoom < 4; zoom++)
+        {
+            EXPECT_EQ(CompareMap(rotation, zoom), 0) << "rotation " << (int)rotation << ", zoom " << (int)zoom;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(SampleParks, PaintArrangement, testing::Values("bpb.sv6", "tile-element-tests.sv6"));
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/Game.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+class PaintThreads : public ParkTest
+{
+protected:
+    void SetUp() override
+    {
+        LoadPark("bpb.sv6", true);
+    }
+
+    void TearDown() override
+    {
+        gConfigGeneral.paint_threads = 0;
+        ParkTest::TearDown();
+    }
+
+    /**
+     * Renders the whole map like a giant screenshot and returns its pixels.
+     */
+    static std::vector<uint8> RenderMap(uint8 rotation, uint8 zoom)
+    {
+        gCurrentRotation = rotation;
+        reset_all_sprite_quadrant_placements();
+
+        sint32 centreX = (gMapSize / 2) * 32 + 16;
+        sint32 centreY = (gMapSize / 2) * 32 + 16;
+        sint32 z = tile_element_height(centreX, centreY) & 0xFFFF;
+        sint32 viewX = 0, viewY = 0;
+        switch (rotation)
+        {
+        case 0:
+            viewX = centreY - centreX;
+            viewY = ((centreX + centreY) / 2) - z;
+            break;
+        case 1:
+            viewX = -centreY - centreX;
+            viewY = ((-centreX + centreY) / 2) - z;
+            break;
+        case 2:
+            viewX = -centreY + centreX;
+            viewY = ((-centreX - centreY) / 2) - z;
+            break;
+        case 3:
+            viewX = centreY + centreX;
+            viewY = ((centreX - centreY) / 2) - z;
+            break;
+        }
+
+        rct_viewport viewport = {};
+        viewport.width = ((gMapSize * 32 * 2) >> zoom) + 8;
+        viewport.height = ((gMapSize * 32 * 1) >> zoom) + 128;
+        viewport.view_width = viewport.width;
+        viewport.view_height = viewport.height;
+        viewport.view_x = viewX - ((viewport.view_width << zoom) / 2);
+        viewport.view_y = viewY - ((viewport.view_height << zoom) / 2);
+        viewport.zoom = zoom;
+
+        std::vector<uint8> pixels(viewport.width * viewport.height);
+        rct_drawpixelinfo dpi = {};
+        dpi.width = viewport.width;
+        dpi.height = viewport.height;
+        dpi.bits = pixels.data();
+        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+        return pixels;
+    }
+};
+
+TEST_F(PaintThreads, MatchesSerialPaint)
+{
+    for (uint8 rotation = 0; rotation < 4; rotation++)
+    {
+        for (uint8 zoom = 0; zoom < 4; zoom++)
+        {
+            gConfigGeneral.paint_threads = 0;
+            auto expected = RenderMap(rotation, zoom);
+
+            gConfigGeneral.paint_threads = 4;
+            auto threaded = RenderMap(rotation, zoom);
+
+            EXPECT_TRUE(threaded == expected) << "rotation " << (int)rotation << ", zoom " << (int)zoom;
+        }
+    }
+}
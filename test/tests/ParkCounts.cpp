@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/world/Entrance.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+#include <openrct2/world/Surface.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+constexpr sint32 updatesToTest = 1024;
+
+class ParkCounts : public ParkTest
+{
+};
+
+TEST_F(ParkCounts, RunningCountsMatchWhilePlaying)
+{
+    auto gs = _context->GetGameState();
+    auto& park = gs->GetPark();
+    park.CalculateParkSize();
+    for (sint32 i = 0; i < updatesToTest; i++)
+    {
+        gs->UpdateLogic();
+    }
+    EXPECT_TRUE(park.VerifyRunningCounts());
+}
+
+TEST_F(ParkCounts, SellingLandChangesParkSize)
+{
+    auto& park = _context->GetGameState()->GetPark();
+    sint32 parkSize = park.CalculateParkSize();
+
+    for (sint32 y = 1; y < gMapSize - 1; y++)
+    {
+        for (sint32 x = 1; x < gMapSize - 1; x++)
+        {
+            rct_tile_element * surfaceElement = map_get_surface_element_at(x, y);
+            if (surfaceElement->properties.surface.ownership & OWNERSHIP_OWNED)
+            {
+                map_buy_land_rights(x * 32, y * 32, x * 32, y * 32, BUY_LAND_RIGHTS_FLAG_UNOWN_TILE, GAME_COMMAND_FLAG_APPLY);
+                EXPECT_EQ(park.CalculateParkSize(), parkSize - 1);
+                EXPECT_TRUE(park.VerifyRunningCounts());
+                return;
+            }
+        }
+    }
+    FAIL() << "No owned land";
+}
+
+TEST_F(ParkCounts, PlacingEntranceChangesParkSize)
+{
+    auto& park = _context->GetGameState()->GetPark();
+    sint32 parkSize = park.CalculateParkSize();
+
+    // The entrance facing direction 0 covers the tile and the ones either side of it along y
+    auto isOwned = [](sint32 x, sint32 y) {
+        return (map_get_surface_element_at(x, y)->properties.surface.ownership & OWNERSHIP_OWNED) != 0;
+    };
+    for (sint32 y = 3; y < gMapSize - 3; y++)
+    {
+        for (sint32 x = 3; x < gMapSize - 3; x++)
+        {
+            if (isOwned(x, y - 1) && isOwned(x, y) && isOwned(x, y + 1))
+            {
+                gParkEntrances[MAX_PARK_ENTRANCES - 1].x = LOCATION_NULL;
+                gCheatsSandboxMode = true;
+                gCheatsDisableClearanceChecks = true;
+                sint16 z = map_get_surface_element_at(x, y)->base_height / 2;
+                money32 cost = place_park_entrance(x * 32, y * 32, z, 0);
+                gCheatsSandboxMode = false;
+                gCheatsDisableClearanceChecks = false;
+
+                ASSERT_NE(cost, MONEY32_UNDEFINED);
+                EXPECT_EQ(park.CalculateParkSize(), parkSize - 3);
+                EXPECT_TRUE(park.VerifyRunningCounts());
+                return;
+            }
+        }
+    }
+    FAIL() << "No owned land";
+}
@@ -0,0 +1,201 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+
+using RLESpriteFunc = void (FASTCALL *)(const uint8 *, uint8 *, const uint8 *, const rct_drawpixelinfo *, sint32, sint32,
+                                        sint32, sint32, sint32);
+
+struct RLESpriteClip
+{
+    sint32 SourceX;
+    sint32 SourceY;
+    sint32 Width;
+    sint32 Height;
+};
+
+class RLESpriteTest : public testing::Test
+{
+protected:
+    static constexpr sint32 SpriteWidth = 384;
+    static constexpr sint32 SpriteHeight = 64;
+
+    std::mt19937 _random { 42 };
+    std::vector<uint8> _sprite;
+    std::vector<uint8> _remapPalette;
+    std::vector<uint8> _peepPalette;
+    std::vector<uint8> _glassPalette;
+    std::vector<uint8> _translucentPalette;
+
+    void SetUp() override
+    {
+        _sprite = CreateSprite();
+
+        // Every entry mapped elsewhere, more than the shuffle lookups handle
+        _remapPalette.resize(256);
+        for (auto& entry : _remapPalette)
+        {
+            entry = (uint8)_random();
+        }
+
+        // Identity apart from the three recolourable ranges, like gPeepPalette
+        _peepPalette.resize(256);
+        for (sint32 i = 0; i < 256; i++)
+        {
+            _peepPalette[i] = (uint8)i;
+        }
+        for (sint32 start : { 0x2E, 0xCA, 0xF3 })
+        {
+            for (sint32 i = start; i < start + 12; i++)
+            {
+                _peepPalette[i] = (uint8)_random();
+            }
+        }
+
+        _glassPalette = _peepPalette;
+        for (sint32 i = 0x10; i < 0x20; i++)
+        {
+            _glassPalette[i] = (uint8)_random();
+        }
+
+        // Indexed by (source << 8 | destination) - 0x100
+        _translucentPalette.resize(0x10000);
+        for (auto& entry : _translucentPalette)
+        {
+            entry = (uint8)_random();
+        }
+    }
+
+    /**
+     * Creates an RLE sprite with runs of random lengths up to the longest possible, several runs
+     * per line and some empty lines.
+     */
+    std::vector<uint8> CreateSprite()
+    {
+        std::vector<uint8> lines;
+        std::vector<uint16> offsets;
+        for (sint32 y = 0; y < SpriteHeight; y++)
+        {
+            offsets.push_back((uint16)(SpriteHeight * 2 + lines.size()));
+            if (y % 16 == 5)
+            {
+                lines.push_back(0x80);
+                lines.push_back(0);
+                continue;
+            }
+
+            sint32 x = _random() % 16;
+            while (true)
+            {
+                sint32 length = (y % 3 == 0) ? 127 : 1 + (_random() % 127);
+                length = std::min(length, SpriteWidth - x);
+                sint32 nextX = x + length + 1 + (_random() % 8);
+                bool isLast = nextX > 255 || nextX >= SpriteWidth;
+                lines.push_back((uint8)(length | (isLast ? 0x80 : 0)));
+                lines.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    lines.push_back((uint8)_random());
+                }
+                if (isLast)
+                {
+                    break;
+                }
+                x = nextX;
+            }
+        }
+
+        std::vector<uint8> sprite(offsets.size() * 2);
+        memcpy(sprite.data(), offsets.data(), sprite.size());
+        sprite.insert(sprite.end(), lines.begin(), lines.end());
+        return sprite;
+    }
+
+    std::vector<uint8> Draw(RLESpriteFunc func, const uint8 * palette, sint32 imageType, sint32 zoom,
+                            const RLESpriteClip& clip)
+    {
+        // The destination starts out with the same noise for every blitter, for the glass lookups
+        sint32 pitch = 3;
+        sint32 lineWidth = (SpriteWidth >> zoom) + pitch;
+        std::vector<uint8> bits(lineWidth * ((SpriteHeight >> zoom) + 1));
+        std::mt19937 noise(7);
+        for (auto& pixel : bits)
+        {
+            pixel = (uint8)noise();
+        }
+
+        rct_drawpixelinfo dpi = {};
+        dpi.bits = bits.data();
+        dpi.width = SpriteWidth;
+        dpi.height = SpriteHeight;
+        dpi.pitch = pitch;
+        dpi.zoom_level = zoom;
+        func(_sprite.data(), bits.data(), palette, &dpi, imageType, clip.SourceY, clip.Height, clip.SourceX, clip.Width);
+        return bits;
+    }
+
+    void TestMatchesScalar(RLESpriteFunc func)
+    {
+        const std::vector<std::pair<sint32, const uint8 *>> imageTypes = {
+            { IMAGE_TYPE_DEFAULT, nullptr },
+            { IMAGE_TYPE_DEFAULT, _remapPalette.data() },
+            { IMAGE_TYPE_REMAP, _peepPalette.data() },
+            { IMAGE_TYPE_REMAP, _remapPalette.data() },
+            { IMAGE_TYPE_TRANSPARENT, _glassPalette.data() },
+            { IMAGE_TYPE_TRANSPARENT, _remapPalette.data() },
+            { IMAGE_TYPE_REMAP | IMAGE_TYPE_TRANSPARENT, _translucentPalette.data() },
+        };
+        for (sint32 zoom = 0; zoom < 4; zoom++)
+        {
+            // The blitters only skip a single line of a negative source y
+            const RLESpriteClip clips[] = {
+                { 0, 0, SpriteWidth, SpriteHeight },
+                { 0, -(1 << zoom), SpriteWidth, SpriteHeight },
+                { 37, 3, 200, 40 },
+                { 101, 16, 7, 8 },
+                { 250, 0, 134, SpriteHeight },
+            };
+            for (const auto& imageType : imageTypes)
+            {
+                for (const auto& clip : clips)
+                {
+                    auto expected = Draw(gfx_rle_sprite_to_buffer_scalar, imageType.second, imageType.first, zoom, clip);
+                    auto actual = Draw(func, imageType.second, imageType.first, zoom, clip);
+                    ASSERT_EQ(expected, actual) << "zoom " << zoom << ", image type " << std::hex << imageType.first
+                                                << std::dec << ", clip " << clip.SourceX << "," << clip.SourceY << " "
+                                                << clip.Width << "x" << clip.Height;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(RLESpriteTest, sse4_1_matches_scalar)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+    TestMatchesScalar(gfx_rle_sprite_to_buffer_sse4_1);
+}
+
+TEST_F(RLESpriteTest, avx2_matches_scalar)
+{
+    if (!avx2_available())
+    {
+        return;
+    }
+    TestMatchesScalar(gfx_rle_sprite_to_buffer_avx2);
+}
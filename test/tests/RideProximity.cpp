@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <random>
+#include <gtest/gtest.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideProximity.h>
+#include <openrct2/ride/Track.h>
+#include <openrct2/world/Map.h>
+
+class RideProximityTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A flat map without any rides, which unlike map_init needs no context
+        for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+        {
+            rct_tile_element * tileElement = &gTileElements[i];
+            tileElement->type = (TILE_ELEMENT_TYPE_SURFACE << 2);
+            tileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement->base_height = 14;
+            tileElement->clearance_height = 14;
+        }
+        gNextFreeTileElementPointerIndex = 0;
+        gMapSize = MAXIMUM_MAP_SIZE_TECHNICAL;
+        map_update_tile_pointers();
+        ride_proximity_invalidate_all();
+    }
+
+    void PlaceTrack(sint32 count)
+    {
+        std::uniform_int_distribution<sint32> tile(0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        std::uniform_int_distribution<sint32> ride(0, MAX_RIDES - 1);
+        for (sint32 i = 0; i < count; i++)
+        {
+            rct_tile_element * tileElement = tile_element_insert(tile(_random), tile(_random), 14, 0);
+            ASSERT_NE(tileElement, nullptr);
+            tileElement->type = TILE_ELEMENT_TYPE_TRACK;
+            tileElement->base_height = 14;
+            tileElement->clearance_height = 16;
+            tileElement->properties.track.ride_index = ride(_random);
+        }
+    }
+
+    void RemoveTrack(sint32 count)
+    {
+        std::uniform_int_distribution<sint32> tile(0, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        for (sint32 i = 0; i < count; i++)
+        {
+            rct_tile_element * tileElement = map_get_first_element_at(tile(_random), tile(_random));
+            do
+            {
+                if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+                {
+                    tile_element_remove(tileElement);
+                    break;
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    /**
+     * Checks the index against looking at every tile near each of a spread of tiles, on and off
+     * the map.
+     */
+    static void ExpectMatchesTileScan()
+    {
+        for (sint32 x = -12; x < MAXIMUM_MAP_SIZE_TECHNICAL + 12; x += 3)
+        {
+            for (sint32 y = -12; y < MAXIMUM_MAP_SIZE_TECHNICAL + 12; y += 5)
+            {
+                uint32 expected[8]{};
+                for (sint32 tileX = x - 10; tileX <= x + 10; tileX++)
+                {
+                    for (sint32 tileY = y - 10; tileY <= y + 10; tileY++)
+                    {
+                        if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                            continue;
+
+                        rct_tile_element * tileElement = map_get_first_element_at(tileX, tileY);
+                        do
+                        {
+                            if (tileElement->GetType() != TILE_ELEMENT_TYPE_TRACK)
+                                continue;
+
+                            sint32 rideIndex = track_element_get_ride_index(tileElement);
+                            expected[rideIndex >> 5] |= (1u << (rideIndex & 0x1F));
+                        } while (!(tileElement++)->IsLastForTile());
+                    }
+                }
+
+                uint32 rides[8]{};
+                ride_proximity_get_rides_near(x, y, 10, rides);
+                for (sint32 i = 0; i < 8; i++)
+                {
+                    ASSERT_EQ(expected[i], rides[i]) << "near " << x << ", " << y;
+                }
+            }
+        }
+    }
+
+    std::mt19937 _random;
+};
+
+TEST_F(RideProximityTest, MatchesTileScan)
+{
+    PlaceTrack(3000);
+    ExpectMatchesTileScan();
+}
+
+TEST_F(RideProximityTest, FollowsPlacedAndRemovedTrack)
+{
+    PlaceTrack(3000);
+    ExpectMatchesTileScan();
+    RemoveTrack(1000);
+    ExpectMatchesTileScan();
+    PlaceTrack(500);
+    ExpectMatchesTileScan();
+
+    auto statistics = ride_proximity_get_statistics();
+    EXPECT_GT(statistics.CellsMerged, 0u);
+    EXPECT_GT(statistics.CellsScanned, 0u);
+}
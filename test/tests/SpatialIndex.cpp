@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/GameState.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+constexpr sint32 updatesToTest = 600;
+
+class SpatialIndex : public ParkTest
+{
+protected:
+    /**
+     * Checks that every sprite is in the bucket of the tile it is on, once.
+     */
+    static void ExpectSpritesInTheirBuckets()
+    {
+        EXPECT_EQ(check_for_spatial_index_cycles(false), -1);
+
+        std::vector<sint32> seen(sprite_get_capacity());
+        for (sint32 i = 0; i <= 0x10000; i++)
+        {
+            for (uint16 spriteIndex = gSpriteSpatialIndex[i]; spriteIndex != SPRITE_INDEX_NULL;
+                 spriteIndex = get_sprite(spriteIndex)->unknown.next_in_quadrant)
+            {
+                rct_sprite * sprite = get_sprite(spriteIndex);
+                if (sprite->unknown.x == LOCATION_NULL)
+                {
+                    EXPECT_EQ(i, 0x10000);
+                }
+                else
+                {
+                    EXPECT_EQ(sprite_get_first_in_quadrant(sprite->unknown.x, sprite->unknown.y), gSpriteSpatialIndex[i]);
+                }
+                seen[spriteIndex]++;
+            }
+        }
+        for (size_t i = 0; i < seen.size(); i++)
+        {
+            bool isUsed = get_sprite(i)->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL;
+            EXPECT_EQ(seen[i], isUsed ? 1 : 0);
+        }
+    }
+};
+
+TEST_F(SpatialIndex, BucketsMatchSpritesWhilePlaying)
+{
+    ExpectSpritesInTheirBuckets();
+
+    auto gs = _context->GetGameState();
+    for (sint32 i = 0; i < updatesToTest; i++)
+    {
+        gs->UpdateLogic();
+    }
+    ExpectSpritesInTheirBuckets();
+
+    // Once a sprite has moved its link back is known, so the buckets are hardly ever walked
+    auto statistics = sprite_spatial_index_get_statistics();
+    EXPECT_GT(statistics.Unlinks, 0u);
+    EXPECT_LT(statistics.Walks, statistics.Unlinks / 2);
+}
+
+TEST_F(SpatialIndex, RectGivesSpritesWithin)
+{
+    for (sint32 x = 0; x < 0x2000; x += 0x300)
+    {
+        sint32 left = x;
+        sint32 top = x / 2;
+        sint32 right = x + 200;
+        sint32 bottom = x / 2 + 500;
+
+        std::vector<rct_sprite *> expected;
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
+        {
+            rct_sprite * sprite = get_sprite(i);
+            if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.x != LOCATION_NULL &&
+                sprite->unknown.x >= left && sprite->unknown.x <= right && sprite->unknown.y >= top &&
+                sprite->unknown.y <= bottom)
+            {
+                expected.push_back(sprite);
+            }
+        }
+
+        auto sprites = sprite_get_in_rect(left, top, right, bottom);
+        std::sort(sprites.begin(), sprites.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(sprites, expected);
+    }
+}
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/Context.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/world/Sprite.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+class SpriteStore : public ParkTest
+{
+protected:
+    void SetUp() override
+    {
+        gConfigGeneral.max_sprites = MAX_SPRITES * 2;
+        ASSERT_NO_FATAL_FAILURE(ParkTest::SetUp());
+    }
+
+    void TearDown() override
+    {
+        gConfigGeneral.max_sprites = MAX_SPRITES;
+        ParkTest::TearDown();
+    }
+
+    static size_t GetNumUsed()
+    {
+        return sprite_get_capacity() - gSpriteListCount[SPRITE_LIST_NULL];
+    }
+
+    /**
+     * Creates sprites that are not updated, marked with the order they were created in.
+     */
+    static std::vector<rct_sprite *> CreateSprites(size_t count)
+    {
+        std::vector<rct_sprite *> sprites;
+        for (size_t i = 0; i < count; i++)
+        {
+            rct_sprite * sprite = create_sprite(1);
+            if (sprite == nullptr)
+                break;
+
+            sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+            sprite->unknown.sprite_width = (uint8)i;
+            sprites.push_back(sprite);
+        }
+        return sprites;
+    }
+};
+
+TEST_F(SpriteStore, GrowsPastSavedSprites)
+{
+    ASSERT_EQ(sprite_get_capacity(), (size_t)MAX_SPRITES);
+    size_t numUsed = GetNumUsed();
+
+    auto sprites = CreateSprites(MAX_SPRITES);
+    ASSERT_EQ(sprites.size(), (size_t)MAX_SPRITES);
+    EXPECT_GT(sprite_get_capacity(), (size_t)MAX_SPRITES);
+    EXPECT_EQ(GetNumUsed(), numUsed + MAX_SPRITES);
+    EXPECT_EQ(sprite_get_num_free(), (size_t)(MAX_SPRITES * 2) - GetNumUsed());
+    EXPECT_EQ(check_for_sprite_list_cycles(false), -1);
+
+    // Sprites stay where they were created as the store grows
+    for (size_t i = 0; i < sprites.size(); i++)
+    {
+        EXPECT_EQ(get_sprite(sprites[i]->unknown.sprite_index), sprites[i]);
+        EXPECT_EQ(sprites[i]->unknown.sprite_width, (uint8)i);
+    }
+}
+
+TEST_F(SpriteStore, SavesGrownSpritesIntoSavedSlots)
+{
+    auto sprites = CreateSprites(MAX_SPRITES);
+
+    // More sprites than a saved game can hold
+    S6Exporter tooManyExporter;
+    EXPECT_THROW(tooManyExporter.Export(), std::runtime_error);
+
+    // Remove the oldest sprites, which are in the slots of the saved game
+    size_t numRemoved = 0;
+    while (GetNumUsed() > MAX_SPRITES - 100)
+    {
+        sprite_remove(sprites[numRemoved++]);
+    }
+    sprites.erase(sprites.begin(), sprites.begin() + numRemoved);
+    ASSERT_GE(sprites.back()->unknown.sprite_index, MAX_SPRITES);
+
+    size_t numUsed = GetNumUsed();
+    std::vector<sint32> expectedMarks(256);
+    for (const auto sprite : sprites)
+    {
+        expectedMarks[sprite->unknown.sprite_width]++;
+    }
+
+    MemoryStream stream;
+    S6Exporter exporter;
+    exporter.Export();
+    exporter.SaveGame(&stream);
+
+    stream.SetPosition(0);
+    auto importer = ParkImporter::CreateS6(_context->GetObjectRepository(), _context->GetObjectManager());
+    importer->LoadFromStream(&stream, false);
+    importer->Import();
+
+    EXPECT_EQ(sprite_get_capacity(), (size_t)MAX_SPRITES);
+    EXPECT_EQ(GetNumUsed(), numUsed);
+    EXPECT_EQ(check_for_sprite_list_cycles(false), -1);
+    EXPECT_EQ(check_for_spatial_index_cycles(false), -1);
+
+    std::vector<sint32> marks(256);
+    for (uint16 i = gSpriteListHead[SPRITE_LIST_UNKNOWN]; i != SPRITE_INDEX_NULL; i = get_sprite(i)->unknown.next)
+    {
+        rct_sprite * sprite = get_sprite(i);
+        EXPECT_EQ(sprite->unknown.sprite_index, i);
+        if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER)
+        {
+            marks[sprite->unknown.sprite_width]++;
+        }
+    }
+    EXPECT_EQ(marks, expectedMarks);
+}
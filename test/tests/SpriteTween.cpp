@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/interface/Window.h>
+#include <openrct2/world/Sprite.h>
+
+class SpriteTweenTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Sprites and a viewport, which need no context
+        reset_sprite_list();
+        sprite_position_tween_reset();
+        SetViewport(-0x4000, -0x4000, 0);
+    }
+
+    void TearDown() override
+    {
+        g_viewport_list[0] = {};
+    }
+
+    static void SetViewport(sint32 viewX, sint32 viewY, uint8 zoom)
+    {
+        rct_viewport * viewport = &g_viewport_list[0];
+        *viewport = {};
+        viewport->width = 0x100;
+        viewport->height = 0x100;
+        viewport->view_x = viewX;
+        viewport->view_y = viewY;
+        viewport->view_width = 0x7FFF;
+        viewport->view_height = 0x7FFF;
+        viewport->zoom = zoom;
+        viewport->visibility = VC_VISIBLE;
+    }
+
+    static rct_sprite * CreateSpriteAt(sint16 x, sint16 y, sint16 z)
+    {
+        rct_sprite * sprite = create_sprite(1);
+        sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+        sprite_move(x, y, z, sprite);
+        return sprite;
+    }
+
+    static void ExpectAt(const rct_sprite * sprite, sint16 x, sint16 y, sint16 z)
+    {
+        EXPECT_EQ(sprite->unknown.x, x);
+        EXPECT_EQ(sprite->unknown.y, y);
+        EXPECT_EQ(sprite->unknown.z, z);
+    }
+};
+
+TEST_F(SpriteTweenTest, MovedSpritesAreDrawnInBetween)
+{
+    rct_sprite * moving = CreateSpriteAt(100, 100, 0);
+    rct_sprite * still = CreateSpriteAt(200, 200, 0);
+
+    sprite_position_tween_store_a();
+    sprite_move(132, 164, 16, moving);
+    sprite_position_tween_store_b();
+
+    sprite_position_tween_all(0.5f);
+    ExpectAt(moving, 116, 132, 8);
+    ExpectAt(still, 200, 200, 0);
+
+    sprite_position_tween_restore();
+    ExpectAt(moving, 132, 164, 16);
+    ExpectAt(still, 200, 200, 0);
+}
+
+TEST_F(SpriteTweenTest, OnlyTheLastTickIsDrawnInBetween)
+{
+    rct_sprite * sprite = CreateSpriteAt(100, 100, 0);
+
+    sprite_position_tween_store_a();
+    sprite_move(120, 100, 0, sprite);
+    sprite_position_tween_store_b();
+    sprite_position_tween_store_a();
+    sprite_position_tween_store_b();
+
+    sprite_position_tween_all(0.5f);
+    ExpectAt(sprite, 120, 100, 0);
+    sprite_position_tween_restore();
+}
+
+TEST_F(SpriteTweenTest, SpritesThatCannotBeSeenAreLeft)
+{
+    rct_sprite * sprite = CreateSpriteAt(100, 100, 0);
+
+    sprite_position_tween_store_a();
+    sprite_move(132, 164, 16, sprite);
+    rct_sprite * created = CreateSpriteAt(50, 50, 0);
+    sprite_position_tween_store_b();
+
+    // Sprites that have just been created are not moved from anywhere
+    sprite_position_tween_all(0.5f);
+    ExpectAt(created, 50, 50, 0);
+    sprite_position_tween_restore();
+
+    // Viewports that are too far out to draw sprites
+    SetViewport(-0x4000, -0x4000, 3);
+    sprite_position_tween_all(0.5f);
+    ExpectAt(sprite, 132, 164, 16);
+    sprite_position_tween_restore();
+
+    // Viewports that look elsewhere
+    SetViewport(0x4000, 0x4000, 0);
+    sprite_position_tween_all(0.5f);
+    ExpectAt(sprite, 132, 164, 16);
+    sprite_position_tween_restore();
+}
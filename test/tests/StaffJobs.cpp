@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/GameState.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/peep/Staff.h>
+#include <openrct2/peep/StaffJobs.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Scenery.h>
+#include <openrct2/world/SmallScenery.h>
+#include <openrct2/world/Sprite.h>
+#include <openrct2/world/Surface.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+constexpr sint32 updatesToTest = 2000;
+
+class StaffJobs : public ParkTest
+{
+protected:
+    /**
+     * Checks the jobs of every tile against the plants, grass, bins and litter found by looking through the map,
+     * and the mechanics against the peep list.
+     */
+    static void ExpectSameAsMap()
+    {
+        static uint8 expected[MAXIMUM_MAP_SIZE_TECHNICAL][MAXIMUM_MAP_SIZE_TECHNICAL];
+        memset(expected, 0, sizeof(expected));
+
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        do
+        {
+            const rct_tile_element * tileElement = it.element;
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_SURFACE)
+            {
+                if (surface_get_terrain(tileElement) == TERRAIN_GRASS &&
+                    (tileElement->properties.surface.grass_length & 0x7) >= GRASS_LENGTH_CLEAR_1)
+                {
+                    expected[it.y][it.x] |= STAFF_JOB_MOWING;
+                }
+            }
+            else if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+            {
+                if (!footpath_element_has_path_scenery(tileElement) || footpath_element_path_scenery_is_ghost(tileElement) ||
+                    (tileElement->flags & TILE_ELEMENT_FLAG_BROKEN))
+                    continue;
+
+                rct_scenery_entry * sceneryEntry = get_footpath_item_entry(footpath_element_get_path_scenery_index(tileElement));
+                if (sceneryEntry == nullptr || !(sceneryEntry->path_bit.flags & PATH_BIT_FLAG_IS_BIN))
+                    continue;
+
+                for (sint32 side = 0; side < 4; side++)
+                {
+                    bool connected = tileElement->properties.path.edges & (1 << side);
+                    bool full = ((tileElement->properties.path.addition_status >> (side * 2)) & 3) == 0;
+                    if (!connected && full)
+                    {
+                        expected[it.y][it.x] |= STAFF_JOB_EMPTYING;
+                    }
+                }
+            }
+            else if (tileElement->GetType() == TILE_ELEMENT_TYPE_SMALL_SCENERY)
+            {
+                if (tileElement->properties.scenery.age < SCENERY_WITHER_AGE_THRESHOLD_1)
+                    continue;
+
+                rct_scenery_entry * sceneryEntry = get_small_scenery_entry(tileElement->properties.scenery.type);
+                if (sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_CAN_BE_WATERED))
+                {
+                    expected[it.y][it.x] |= STAFF_JOB_WATERING;
+                }
+            }
+        } while (tile_element_iterator_next(&it));
+
+        for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+             spriteIndex = get_sprite(spriteIndex)->unknown.next)
+        {
+            const rct_litter * litter = &get_sprite(spriteIndex)->litter;
+            expected[litter->y >> 5][litter->x >> 5] |= STAFF_JOB_SWEEPING;
+        }
+
+        for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                EXPECT_EQ(staff_jobs_get_tile(x, y), expected[y][x]) << "at " << x << ", " << y;
+            }
+        }
+
+        std::vector<uint16> mechanics;
+        uint16 spriteIndex;
+        rct_peep * peep;
+        FOR_ALL_STAFF(spriteIndex, peep)
+        {
+            if (peep->staff_type == STAFF_TYPE_MECHANIC)
+            {
+                mechanics.push_back(spriteIndex);
+            }
+        }
+        EXPECT_EQ(staff_jobs_get_mechanics(), mechanics);
+    }
+};
+
+TEST_F(StaffJobs, JobsMatchMapWhilePlaying)
+{
+    ExpectSameAsMap();
+
+    auto gs = _context->GetGameState();
+    for (sint32 i = 0; i < updatesToTest; i++)
+    {
+        gs->UpdateLogic();
+        if (i % 500 == 0)
+        {
+            ExpectSameAsMap();
+        }
+    }
+    ExpectSameAsMap();
+}
@@ -8,8 +8,13 @@
  *****************************************************************************/
 
 #include <openrct2/core/Path.hpp>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/platform/platform.h>
 #include "TestData.h"
 
+using namespace OpenRCT2;
+
 namespace TestData
 {
     std::string GetBasePath()
@@ -23,3 +28,29 @@ namespace TestData
         return path;
     }
 } // namespace TestData
+
+void ParkTest::SetUp()
+{
+    LoadPark("bpb.sv6");
+}
+
+void ParkTest::TearDown()
+{
+    _context = nullptr;
+}
+
+void ParkTest::LoadPark(const std::string& name, bool loadGraphics)
+{
+    std::string parkPath = TestData::GetParkPath(name);
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = !loadGraphics;
+
+    core_init();
+    _context = nullptr;
+    _context = CreateContext();
+    bool initialised = _context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(parkPath.c_str());
+    game_load_init();
+}
@@ -7,7 +7,10 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <memory>
 #include <string>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
 
 #pragma once
 
@@ -16,3 +19,18 @@ namespace TestData
     std::string GetBasePath();
     std::string GetParkPath(std::string name);
 };
+
+/**
+ * Starts a headless game with a park from the test data loaded for each test, the sample park
+ * unless the test loads another one. Tests that draw the park load it with the graphics.
+ */
+class ParkTest : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    void LoadPark(const std::string& name, bool loadGraphics = false);
+
+    std::unique_ptr<OpenRCT2::IContext> _context;
+};
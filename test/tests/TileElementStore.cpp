@@ -0,0 +1,288 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/Game.h>
+#include <openrct2/localisation/StringIds.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/rct2/S6Exporter.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+using TileContents = std::vector<std::pair<uint8, uint8>>;
+
+class TileElementStoreTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A flat map, which unlike map_init needs no context
+        for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+        {
+            rct_tile_element * tileElement = &gTileElements[i];
+            tileElement->type = (TILE_ELEMENT_TYPE_SURFACE << 2);
+            tileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
+            tileElement->base_height = 14;
+            tileElement->clearance_height = 0;
+        }
+        gNextFreeTileElementPointerIndex = 0;
+        gMapSize = MAXIMUM_MAP_SIZE_TECHNICAL;
+        map_update_tile_pointers();
+        _tiles.assign(MAX_TILE_TILE_ELEMENT_POINTERS, TileContents{ { 14, 0 } });
+    }
+
+    /**
+     * Inserts an element marked by its clearance height, and where the model expects it to go.
+     */
+    void Insert(sint32 x, sint32 y, uint8 z, uint8 mark)
+    {
+        rct_tile_element * tileElement = tile_element_insert(x, y, z, 0);
+        ASSERT_NE(tileElement, nullptr);
+        tileElement->type = TILE_ELEMENT_TYPE_PATH;
+        tileElement->clearance_height = mark;
+
+        auto& tile = _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+        auto it = tile.begin();
+        while (it != tile.end() && z >= it->first)
+        {
+            it++;
+        }
+        tile.insert(it, { z, mark });
+    }
+
+    void Remove(sint32 x, sint32 y, size_t index)
+    {
+        tile_element_remove(map_get_first_element_at(x, y) + index);
+
+        auto& tile = _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+        tile.erase(tile.begin() + index);
+    }
+
+    size_t GetNumElements(sint32 x, sint32 y) const
+    {
+        return _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x].size();
+    }
+
+    void ExpectMatchesModel() const
+    {
+        size_t numElements = 0;
+        for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                TileContents tile;
+                const rct_tile_element * tileElement = map_get_first_element_at(x, y);
+                do
+                {
+                    tile.emplace_back(tileElement->base_height, tileElement->clearance_height);
+                }
+                while (!(tileElement++)->IsLastForTile());
+
+                const auto& expected = _tiles[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+                ASSERT_EQ(tile, expected) << "at " << x << ", " << y;
+                numElements += tile.size();
+            }
+        }
+
+        auto statistics = map_get_tile_element_statistics();
+        EXPECT_EQ(statistics.Live, numElements);
+        EXPECT_EQ(statistics.Live + statistics.Dead + statistics.Free, statistics.Capacity);
+    }
+
+    std::vector<TileContents> _tiles;
+    std::mt19937 _random;
+};
+
+TEST_F(TileElementStoreTest, TilesGrowWhereTheyAre)
+{
+    // The last tile is next to the free elements
+    Insert(255, 255, 20, 1);
+    Insert(255, 255, 10, 2);
+    auto statistics = map_get_tile_element_statistics();
+    EXPECT_EQ(statistics.InPlaceInserts, 2u);
+    EXPECT_EQ(statistics.Relocations, 0u);
+
+    // Other tiles are moved once, and then have room behind them
+    Insert(10, 10, 20, 3);
+    Insert(10, 10, 30, 4);
+    Insert(10, 10, 0, 5);
+    statistics = map_get_tile_element_statistics();
+    EXPECT_EQ(statistics.InPlaceInserts, 4u);
+    EXPECT_EQ(statistics.Relocations, 1u);
+
+    // Removing an element leaves room for another
+    Insert(20, 20, 20, 6);
+    Insert(21, 20, 20, 7);
+    Remove(20, 20, 0);
+    Insert(20, 20, 40, 8);
+    statistics = map_get_tile_element_statistics();
+    EXPECT_EQ(statistics.InPlaceInserts, 5u);
+    EXPECT_EQ(statistics.Relocations, 3u);
+
+    ExpectMatchesModel();
+}
+
+TEST_F(TileElementStoreTest, KeepsTilesWhileCompacting)
+{
+    std::uniform_int_distribution<sint32> tile(0, 31);
+    std::uniform_int_distribution<sint32> height(0, 60);
+    for (sint32 i = 0; i < 20000; i++)
+    {
+        sint32 x = tile(_random);
+        sint32 y = tile(_random);
+        size_t numElements = GetNumElements(x, y);
+        if (numElements > 1 && _random() % 3 == 0)
+        {
+            Remove(x, y, 1 + _random() % (numElements - 1));
+        }
+        else if (numElements < 12)
+        {
+            Insert(x, y, (uint8)height(_random), (uint8)i);
+        }
+        if (i % 10 == 0)
+        {
+            sub_68B089();
+        }
+    }
+    ExpectMatchesModel();
+
+    // A pass over the tiles in the order they are stored moves the dead elements to the end
+    auto fragmented = map_get_tile_element_statistics();
+    for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS * 2; i++)
+    {
+        sub_68B089();
+    }
+    auto compacted = map_get_tile_element_statistics();
+    EXPECT_GT(compacted.CompactedTiles, fragmented.CompactedTiles);
+    EXPECT_LT(compacted.Dead, fragmented.Dead / 2);
+    EXPECT_GT(compacted.Free, fragmented.Free);
+    ExpectMatchesModel();
+
+    map_reorganise_elements();
+    EXPECT_EQ(map_get_tile_element_statistics().Dead, 0u);
+    ExpectMatchesModel();
+}
+
+TEST_F(TileElementStoreTest, GrowsPastSavedGames)
+{
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            Insert(x, y, 20, 1);
+            Insert(x, y, 30, 2);
+        }
+    }
+    auto statistics = map_get_tile_element_statistics();
+    EXPECT_GT(statistics.Live, (uint32)MAX_TILE_ELEMENTS);
+    EXPECT_GT(statistics.Blocks, 0u);
+    ExpectMatchesModel();
+
+    // Commands are refused what a saved game could not hold
+    gGameCommandErrorText = STR_NONE;
+    EXPECT_FALSE(map_check_free_elements_and_reorganise(1));
+    EXPECT_EQ(gGameCommandErrorText, STR_ERR_LANDSCAPE_DATA_AREA_FULL);
+
+    map_reorganise_elements();
+    EXPECT_GT(map_get_tile_element_statistics().Blocks, 0u);
+    ExpectMatchesModel();
+
+    // Once the tiles fit again, they all go back in the saved elements
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            Remove(x, y, 2);
+        }
+    }
+    map_reorganise_elements();
+    statistics = map_get_tile_element_statistics();
+    EXPECT_EQ(statistics.Blocks, 0u);
+    EXPECT_EQ(statistics.Dead, 0u);
+    ExpectMatchesModel();
+}
+
+TEST_F(TileElementStoreTest, LetsCommandsUseBlocksWhileTheTilesFit)
+{
+    // Moving every tile once fills gTileElements with dead elements and slack, so a block is added
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL && map_get_tile_element_statistics().Blocks == 0; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            Insert(x, y, 20, 1);
+            Remove(x, y, 1);
+        }
+    }
+    ASSERT_GT(map_get_tile_element_statistics().Blocks, 0u);
+    EXPECT_TRUE(map_check_free_elements_and_reorganise(100));
+    ExpectMatchesModel();
+}
+
+class TileElementSaving : public ParkTest
+{
+protected:
+    static std::vector<rct_tile_element> GetTiles()
+    {
+        std::vector<rct_tile_element> elements;
+        for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+        {
+            for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+            {
+                const rct_tile_element * tileElement = map_get_first_element_at(x, y);
+                do
+                {
+                    elements.push_back(*tileElement);
+                }
+                while (!(tileElement++)->IsLastForTile());
+            }
+        }
+        return elements;
+    }
+};
+
+TEST_F(TileElementSaving, KeepsTilesInBlocks)
+{
+    auto expected = GetTiles();
+
+    // Move the tiles without changing them until some of them are in a block
+    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL && map_get_tile_element_statistics().Blocks == 0; y++)
+    {
+        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            rct_tile_element * tileElement = tile_element_insert(x, y, 0, 0);
+            ASSERT_NE(tileElement, nullptr);
+            tile_element_remove(tileElement);
+        }
+    }
+    ASSERT_GT(map_get_tile_element_statistics().Blocks, 0u);
+    ASSERT_TRUE(map_check_free_elements_and_reorganise(1));
+    ASSERT_EQ(GetTiles().size(), expected.size());
+
+    MemoryStream stream;
+    S6Exporter exporter;
+    exporter.Export();
+    exporter.SaveGame(&stream);
+
+    stream.SetPosition(0);
+    auto importer = ParkImporter::CreateS6(_context->GetObjectRepository(), _context->GetObjectManager());
+    importer->LoadFromStream(&stream, false);
+    importer->Import();
+
+    EXPECT_EQ(map_get_tile_element_statistics().Blocks, 0u);
+    auto loaded = GetTiles();
+    ASSERT_EQ(loaded.size(), expected.size());
+    EXPECT_EQ(std::memcmp(loaded.data(), expected.data(), loaded.size() * sizeof(rct_tile_element)), 0);
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/Game.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/paint/TilePaintCache.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using PaintStructKey = std::tuple<uint32, uint16, uint16, uint16, uint16, uint16, uint16, uint16, uint16, uint8, uint32, uint8, uint16, uint16, const void *>;
+using AttachedStructKey = std::tuple<uint32, uint16, uint16, uint8, uint32>;
+
+struct ColumnPaint
+{
+    std::vector<PaintStructKey> Structs;
+    std::vector<AttachedStructKey> Attached;
+
+    bool operator==(const ColumnPaint& other) const
+    {
+        return Structs == other.Structs && Attached == other.Attached;
+    }
+};
+
+class TilePaintCache : public ParkTest, public testing::WithParamInterface<const char *>
+{
+protected:
+    void SetUp() override
+    {
+        LoadPark(GetParam(), true);
+    }
+
+    static ColumnPaint PaintColumn(rct_drawpixelinfo * dpi)
+    {
+        ColumnPaint result;
+        paint_session * session = paint_session_alloc(dpi);
+        paint_session_generate(session);
+        paint_struct psHead = paint_session_arrange(session);
+        for (paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            // The colour is only set by the painters that use it
+            bool masked = (ps->flags & PAINT_STRUCT_FLAG_IS_MASKED) != 0;
+            result.Structs.emplace_back(
+                ps->image_id, ps->x, ps->y, ps->bounds.x, ps->bounds.y, ps->bounds.z, ps->bounds.x_end, ps->bounds.y_end,
+                ps->bounds.z_end, ps->flags, masked ? ps->colour_image_id : 0, ps->sprite_type, ps->map_x, ps->map_y,
+                ps->tileElement);
+            for (attached_paint_struct * attached = ps->attached_ps; attached != nullptr; attached = attached->next)
+            {
+                bool attachedMasked = (attached->flags & PAINT_STRUCT_FLAG_IS_MASKED) != 0;
+                result.Attached.emplace_back(
+                    attached->image_id, attached->x, attached->y, attached->flags,
+                    attachedMasked ? attached->colour_image_id : 0);
+            }
+        }
+        paint_session_free(session);
+        return result;
+    }
+
+    /**
+     * Paints every column covering the whole map and returns the paint structs of each column.
+     */
+    static std::vector<ColumnPaint> PaintMap(uint8 rotation, uint8 zoom)
+    {
+        gCurrentRotation = rotation;
+        reset_all_sprite_quadrant_placements();
+
+        sint32 centreX = (gMapSize / 2) * 32 + 16;
+        sint32 centreY = (gMapSize / 2) * 32 + 16;
+        sint32 z = tile_element_height(centreX, centreY) & 0xFFFF;
+        sint32 viewX = 0, viewY = 0;
+        switch (rotation)
+        {
+        case 0:
+            viewX = centreY - centreX;
+            viewY = ((centreX + centreY) / 2) - z;
+            break;
+        case 1:
+            viewX = -centreY - centreX;
+            viewY = ((-centreX + centreY) / 2) - z;
+            break;
+        case 2:
+            viewX = -centreY + centreX;
+            viewY = ((-centreX - centreY) / 2) - z;
+            break;
+        case 3:
+            viewX = centreY + centreX;
+            viewY = ((centreX - centreY) / 2) - z;
+            break;
+        }
+
+        sint32 viewWidth = (gMapSize * 32 * 2) + 8;
+        sint32 viewHeight = (gMapSize * 32 * 1) + 128;
+        sint32 mask = 0xFFFF << zoom;
+        viewX = (viewX - viewWidth / 2) & mask;
+        viewY = (viewY - viewHeight / 2) & mask;
+
+        std::vector<ColumnPaint> result;
+        for (sint32 x = floor2(viewX, 32); x < viewX + viewWidth; x += 32)
+        {
+            rct_drawpixelinfo dpi = {};
+            dpi.x = x;
+            dpi.y = viewY;
+            dpi.width = 32;
+            dpi.height = viewHeight;
+            dpi.zoom_level = zoom;
+            result.push_back(PaintColumn(&dpi));
+        }
+        return result;
+    }
+};
+
+TEST_P(TilePaintCache, MatchesUncachedPaint)
+{
+    for (uint8 rotation = 0; rotation < 4; rotation++)
+    {
+        for (uint8 zoom = 0; zoom < 4; zoom++)
+        {
+            tile_paint_cache_set_enabled(false);
+            auto expected = PaintMap(rotation, zoom);
+
+            tile_paint_cache_set_enabled(true);
+            auto recorded = PaintMap(rotation, zoom);
+            uint32 hitsBefore = tile_paint_cache_get_statistics().Hits;
+            auto replayed = PaintMap(rotation, zoom);
+            uint32 hits = tile_paint_cache_get_statistics().Hits - hitsBefore;
+
+            EXPECT_TRUE(recorded == expected) << "rotation " << (int)rotation << ", zoom " << (int)zoom;
+            EXPECT_TRUE(replayed == expected) << "rotation " << (int)rotation << ", zoom " << (int)zoom;
+            EXPECT_GT(hits, 0u) << "rotation " << (int)rotation << ", zoom " << (int)zoom;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(SampleParks, TilePaintCache, testing::Values("bpb.sv6", "tile-element-tests.sv6"));
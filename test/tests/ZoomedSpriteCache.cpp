@@ -0,0 +1,243 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2018 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/drawing/ZoomedSpriteCache.h>
+
+class ZoomedSpriteCacheTest : public testing::Test
+{
+protected:
+    static constexpr sint32 ImageId = 1;
+    static constexpr sint32 SpriteWidth = 300;
+    static constexpr sint32 SpriteHeight = 70;
+    static constexpr sint32 DpiWidth = 512;
+    static constexpr sint32 DpiHeight = 128;
+
+    std::mt19937 _random { 1 };
+
+    void SetUp() override
+    {
+        gConfigGeneral.zoomed_sprite_cache_size = 1;
+        zoomed_sprite_cache_clear();
+    }
+
+    void TearDown() override
+    {
+        zoomed_sprite_cache_clear();
+        gConfigGeneral.zoomed_sprite_cache_size = 0;
+    }
+
+    std::vector<uint8> CreateSprite()
+    {
+        std::vector<uint8> lines;
+        std::vector<uint16> offsets;
+        for (sint32 y = 0; y < SpriteHeight; y++)
+        {
+            offsets.push_back((uint16)(SpriteHeight * 2 + lines.size()));
+            if (y % 9 == 4)
+            {
+                lines.push_back(0x80);
+                lines.push_back(0);
+                continue;
+            }
+
+            sint32 x = _random() % 4;
+            while (true)
+            {
+                sint32 length = std::min<sint32>(1 + (_random() % 127), SpriteWidth - x);
+                sint32 nextX = x + length + (_random() % 3);
+                bool isLast = nextX > 255 || nextX >= SpriteWidth;
+                lines.push_back((uint8)(length | (isLast ? 0x80 : 0)));
+                lines.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    lines.push_back((uint8)_random());
+                }
+                if (isLast)
+                {
+                    break;
+                }
+                x = nextX;
+            }
+        }
+
+        std::vector<uint8> sprite(offsets.size() * 2);
+        memcpy(sprite.data(), offsets.data(), sprite.size());
+        sprite.insert(sprite.end(), lines.begin(), lines.end());
+        return sprite;
+    }
+
+    /**
+     * Clips the sprite drawn at the given position the same way gfx_draw_sprite_palette_set_software
+     * does and draws it either directly or through the cache.
+     */
+    std::vector<uint8> Draw(const rct_g1_element& g1, sint32 zoom, sint32 x, sint32 y, bool cached, bool * drawnFromCache = nullptr,
+                            sint32 imageId = ImageId)
+    {
+        sint32 zoomMask = 0xFFFFFFFF << zoom;
+        x -= ~zoomMask;
+        y -= ~zoomMask;
+
+        sint32 lineWidth = (DpiWidth >> zoom) + 1;
+        std::vector<uint8> bits(lineWidth * ((DpiHeight >> zoom) + 1), 0xAB);
+        rct_drawpixelinfo dpi = {};
+        dpi.bits = bits.data();
+        dpi.width = DpiWidth;
+        dpi.height = DpiHeight;
+        dpi.pitch = 1;
+        dpi.zoom_level = zoom;
+
+        sint32 height = g1.height;
+        sint32 destStartY = y;
+        sint32 sourceStartY = 0;
+        if (destStartY < 0)
+        {
+            height += destStartY;
+            sourceStartY -= destStartY;
+            destStartY = 0;
+        }
+        else
+        {
+            sourceStartY -= destStartY & ~zoomMask;
+            height += destStartY & ~zoomMask;
+        }
+        if (destStartY + height > DpiHeight)
+        {
+            height -= destStartY + height - DpiHeight;
+        }
+
+        sint32 width = g1.width;
+        sint32 sourceStartX = 0;
+        sint32 destStartX = (x + ~zoomMask) & zoomMask;
+        if (destStartX < 0)
+        {
+            width += destStartX;
+            sourceStartX -= destStartX;
+            destStartX = 0;
+        }
+        else
+        {
+            sourceStartX -= destStartX & ~zoomMask;
+        }
+        if (destStartX + width > DpiWidth)
+        {
+            width -= destStartX + width - DpiWidth;
+        }
+        if (height <= 0 || width <= 0)
+        {
+            return bits;
+        }
+
+        uint8 * dest = bits.data() + lineWidth * (destStartY >> zoom) + (destStartX >> zoom);
+        bool fromCache = cached
+            && zoomed_sprite_cache_draw(imageId, &g1, dest, nullptr, &dpi, IMAGE_TYPE_DEFAULT, sourceStartY, height,
+                                        sourceStartX, width);
+        if (!fromCache)
+        {
+            gfx_rle_sprite_to_buffer_scalar(g1.offset, dest, nullptr, &dpi, IMAGE_TYPE_DEFAULT, sourceStartY, height,
+                                            sourceStartX, width);
+        }
+        if (drawnFromCache != nullptr)
+        {
+            *drawnFromCache = fromCache;
+        }
+        return bits;
+    }
+
+    static rct_g1_element CreateElement(std::vector<uint8>& sprite)
+    {
+        rct_g1_element g1 = {};
+        g1.offset = sprite.data();
+        g1.width = SpriteWidth;
+        g1.height = SpriteHeight;
+        g1.flags = G1_FLAG_RLE_COMPRESSION;
+        return g1;
+    }
+};
+
+TEST_F(ZoomedSpriteCacheTest, matches_zoomed_blitter)
+{
+    auto sprite = CreateSprite();
+    auto g1 = CreateElement(sprite);
+    for (sint32 zoom = 1; zoom < 4; zoom++)
+    {
+        // Every sampling phase, partly off each edge of the view
+        for (sint32 y : { -40, -3, 0, 1, 2, 3, 5, 6, 7, 60, 100 })
+        {
+            for (sint32 x : { -200, -13, -1, 0, 1, 2, 3, 4, 5, 6, 7, 250, 400 })
+            {
+                auto expected = Draw(g1, zoom, x, y, false);
+                bool fromCache = false;
+                auto actual = Draw(g1, zoom, x, y, true, &fromCache);
+                ASSERT_TRUE(fromCache);
+                ASSERT_EQ(expected, actual) << "zoom " << zoom << " at " << x << "," << y;
+            }
+        }
+    }
+
+    auto statistics = zoomed_sprite_cache_get_statistics();
+    EXPECT_GT(statistics.Hits, 0u);
+    EXPECT_GT(statistics.Misses, 0u);
+    EXPECT_LE(statistics.Bytes, statistics.Budget);
+}
+
+TEST_F(ZoomedSpriteCacheTest, replaced_image_is_sampled_again)
+{
+    auto sprite = CreateSprite();
+    auto g1 = CreateElement(sprite);
+    Draw(g1, 2, 0, 0, true);
+
+    auto otherSprite = CreateSprite();
+    auto otherG1 = CreateElement(otherSprite);
+    auto expected = Draw(otherG1, 2, 0, 0, false);
+    auto actual = Draw(otherG1, 2, 0, 0, true);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(ZoomedSpriteCacheTest, evicts_least_recently_used)
+{
+    auto sprite = CreateSprite();
+    auto g1 = CreateElement(sprite);
+    uint32 evictions = zoomed_sprite_cache_get_statistics().Evictions;
+
+    // Sample the same image under more and more ids until the budget is used up, drawing the
+    // first one again after each so that it is never the least recently used
+    for (sint32 imageId = ImageId + 1; imageId < 100000; imageId++)
+    {
+        Draw(g1, 1, 0, 0, true, nullptr, imageId);
+        Draw(g1, 1, 0, 0, true);
+        if (zoomed_sprite_cache_get_statistics().Evictions != evictions)
+        {
+            break;
+        }
+    }
+
+    auto statistics = zoomed_sprite_cache_get_statistics();
+    EXPECT_GT(statistics.Evictions, evictions);
+    EXPECT_LE(statistics.Bytes, statistics.Budget);
+
+    Draw(g1, 1, 0, 0, true);
+    EXPECT_EQ(zoomed_sprite_cache_get_statistics().Misses, statistics.Misses);
+}
+
+TEST_F(ZoomedSpriteCacheTest, disabled_without_budget)
+{
+    gConfigGeneral.zoomed_sprite_cache_size = 0;
+    auto sprite = CreateSprite();
+    auto g1 = CreateElement(sprite);
+    bool fromCache = true;
+    Draw(g1, 2, 0, 0, true, &fromCache);
+    EXPECT_FALSE(fromCache);
+}